@@ -23,6 +23,45 @@ fi
 ]
 )
 
+dnl Handle the --enable-simd option.
+dnl
+dnl Select the vector instruction set used by the vectorized
+dnl alignment algorithms. By default, the compiler default is used
+dnl (SSE2 on x86-64).
+AC_DEFUN([adl_ENABLE_SIMD],
+[
+AC_PROVIDE([$0])
+
+ac_cv_enable_simd=no
+
+AC_ARG_ENABLE( simd,
+[  --enable-simd=ISA	use vector instruction set ISA (sse41 or avx2) \[default=no\] ],
+ac_cv_enable_simd=$enableval,
+ac_cv_enable_simd=no
+)
+
+case x"$ac_cv_enable_simd" in
+	xsse41)
+		CXXFLAGS="$CXXFLAGS -msse4.1"
+		;;
+	xavx2|xyes)
+		CXXFLAGS="$CXXFLAGS -mavx2"
+		;;
+	xno)
+		;;
+	*)
+		AC_MSG_ERROR([unknown instruction set $ac_cv_enable_simd for --enable-simd])
+		;;
+esac
+
+if test x"$ac_cv_enable_simd" != xno; then
+	AC_SUBST(CXXFLAGS)
+	AC_MSG_CHECKING("Vector instruction set")
+	AC_MSG_RESULT($ac_cv_enable_simd)
+fi
+]
+)
+
 dnl Handle the --enable-html-doc option.
 dnl
 dnl The following snippet goes into doc/Makefile.am
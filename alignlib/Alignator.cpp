@@ -30,6 +30,10 @@ using namespace std;
 namespace alignlib
 {
 
+//--------------------------------------------------------------------------------------
+AlignatorCallback::~AlignatorCallback () {
+}
+
 //--------------------------------------------------------------------------------------
 Alignator::Alignator() {
 }
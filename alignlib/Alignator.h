@@ -35,6 +35,37 @@
 namespace alignlib
 {
 
+  /**
+       @short Protocol class for receiving results from @ref Alignator::alignMany.
+
+       Subclass and overload operator() to process, filter or store
+       the alignments of a query against many targets.
+
+       @author Andreas Heger
+       @version $Id: Alignator.h,v 1.3 2004/03/19 18:23:39 aheger Exp $
+       @see Alignator
+  */
+  class AlignatorCallback
+    {
+    public:
+      /** destructor */
+      virtual ~AlignatorCallback ();
+
+      /** receive the alignment of the query with a target.
+       *
+       * @param index	index of the target in the list of targets.
+       * @param target	@ref Alignandum object that has been aligned.
+       * @param result	@ref Alignment of query (row) and target (col). The score
+       * 				and coordinates are available through the @ref Alignment
+       * 				interface. The object is re-used for the next target, so
+       * 				clone it if you want to keep it.
+       * @return false, if no further targets should be aligned.
+       */
+      virtual bool operator()( size_t index,
+    		  const HAlignandum & target,
+    		  const HAlignment & result ) = 0;
+    };
+
   /**
        @short Protocol class for objects that align.
 
@@ -104,6 +135,32 @@ namespace alignlib
     		  const HAlignandum & row,
     		  const HAlignandum & col) = 0;
 
+      /** align a query against many targets.
+       *
+       * The query is prepared once and buffers are shared between
+       * the alignments, which makes this faster than calling
+       * @ref align repeatedly. The query is the row and each target
+       * the column of the alignment. Each result is passed to callback.
+       *
+       * @param dest	@ref Alignment object used to store each result.
+       * @param query	@ref Alignandum object to align.
+       * @param targets	@ref Alignandum objects to align against.
+       * @param callback	@ref AlignatorCallback receiving the results.
+      */
+      virtual void alignMany( HAlignment & dest,
+    		  const HAlignandum & query,
+    		  const AlignandumVector & targets,
+    		  AlignatorCallback & callback ) = 0;
+
+      /** release memory kept between alignments.
+       *
+       * Alignators keep their work space between calls to @ref align,
+       * so that repeated alignments of objects of similar size do not
+       * allocate memory. The work space only grows. Call this function
+       * to free it, for example after aligning a pair of large objects.
+       */
+      virtual void trimWorkspace() = 0;
+
       /* accessors */
 
     };
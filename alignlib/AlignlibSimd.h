@@ -0,0 +1,346 @@
+/*
+  alignlib - a library for aligning protein sequences
+
+  $Id$
+
+  Copyright (C) 2026 Andreas Heger
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+*/
+
+#ifndef ALIGNLIB_SIMD_H
+#define ALIGNLIB_SIMD_H 1
+
+#if HAVE_CONFIG_H
+#include <config.h>
+#endif
+
+/** Thin wrappers around x86 vector intrinsics.
+
+	The wrappers are used by the vectorized dynamic programming
+	kernels. Each wrapper describes a vector of signed integers
+	of a fixed width (or of doubles, see @ref SimdDouble) and
+	provides the handful of operations that
+	the kernels need. The widest instruction set the compiler has
+	been told about is used: AVX2 if __AVX2__ is defined,
+	otherwise SSE2 (with SSE4.1 instructions where available).
+
+	Use configure --enable-simd=avx2 or --enable-simd=sse41
+	to set the appropriate compiler flags.
+
+	If the target does not support SSE2, ALIGNLIB_HAVE_SIMD
+	is not defined and the vectorized code paths are disabled.
+*/
+
+#if defined(__SSE2__)
+#define ALIGNLIB_HAVE_SIMD 1
+
+#include <emmintrin.h>
+#include <mm_malloc.h>
+#if defined(__SSE4_1__)
+#include <smmintrin.h>
+#endif
+#if defined(__AVX2__)
+#include <immintrin.h>
+#endif
+
+#include <cstddef>
+
+namespace alignlib
+{
+
+/** alignment of vectors in bytes */
+#define ALIGNLIB_SIMD_ALIGNMENT 32
+
+/** allocate n vectors of type T aligned for vector loads and stores */
+template< class T >
+inline T * allocateVectors( size_t n )
+{
+	return (T*)_mm_malloc( sizeof(T) * (n > 0 ? n : 1), ALIGNLIB_SIMD_ALIGNMENT );
+}
+
+/** release memory allocated with allocateVectors */
+template< class T >
+inline void releaseVectors( T * p )
+{
+	if (p != NULL) _mm_free( p );
+}
+
+/** vector of signed 16-bit integers with saturating arithmetic */
+struct SimdInt16
+{
+	typedef short Value;
+#if defined(__AVX2__)
+	typedef __m256i Vector;
+	enum { LANES = 16 };
+#else
+	typedef __m128i Vector;
+	enum { LANES = 8 };
+#endif
+	/** smallest value, used as minus infinity */
+	static Value minValue() { return -32768; }
+	/** largest value */
+	static Value maxValue() { return 32767; }
+
+#if defined(__AVX2__)
+	static inline Vector set1( Value v ) { return _mm256_set1_epi16( v ); }
+	static inline Vector zero() { return _mm256_setzero_si256(); }
+	static inline Vector load( const Vector * p ) { return _mm256_load_si256( p ); }
+	static inline void store( Vector * p, const Vector & v ) { _mm256_store_si256( p, v ); }
+	static inline Vector add( const Vector & a, const Vector & b ) { return _mm256_adds_epi16( a, b ); }
+	static inline Vector sub( const Vector & a, const Vector & b ) { return _mm256_subs_epi16( a, b ); }
+	static inline Vector max( const Vector & a, const Vector & b ) { return _mm256_max_epi16( a, b ); }
+	static inline Vector min( const Vector & a, const Vector & b ) { return _mm256_min_epi16( a, b ); }
+	static inline Vector cmpgt( const Vector & a, const Vector & b ) { return _mm256_cmpgt_epi16( a, b ); }
+	static inline Vector cmpeq( const Vector & a, const Vector & b ) { return _mm256_cmpeq_epi16( a, b ); }
+	static inline bool any( const Vector & mask ) { return _mm256_movemask_epi8( mask ) != 0; }
+	/** shift all elements up by one lane, filling lane 0 with zero */
+	static inline Vector shift( const Vector & v )
+	{
+		return _mm256_alignr_epi8( v, _mm256_permute2x128_si256( v, v, 0x08 ), 14 );
+	}
+#else
+	static inline Vector set1( Value v ) { return _mm_set1_epi16( v ); }
+	static inline Vector zero() { return _mm_setzero_si128(); }
+	static inline Vector load( const Vector * p ) { return _mm_load_si128( p ); }
+	static inline void store( Vector * p, const Vector & v ) { _mm_store_si128( p, v ); }
+	static inline Vector add( const Vector & a, const Vector & b ) { return _mm_adds_epi16( a, b ); }
+	static inline Vector sub( const Vector & a, const Vector & b ) { return _mm_subs_epi16( a, b ); }
+	static inline Vector max( const Vector & a, const Vector & b ) { return _mm_max_epi16( a, b ); }
+	static inline Vector min( const Vector & a, const Vector & b ) { return _mm_min_epi16( a, b ); }
+	static inline Vector cmpgt( const Vector & a, const Vector & b ) { return _mm_cmpgt_epi16( a, b ); }
+	static inline Vector cmpeq( const Vector & a, const Vector & b ) { return _mm_cmpeq_epi16( a, b ); }
+	static inline bool any( const Vector & mask ) { return _mm_movemask_epi8( mask ) != 0; }
+	/** shift all elements up by one lane, filling lane 0 with zero */
+	static inline Vector shift( const Vector & v ) { return _mm_slli_si128( v, 2 ); }
+#endif
+	/** shift all elements up by one lane, filling lane 0 with
+	 * the value in lane 0 of fill (see @ref first)
+	 */
+	static inline Vector shift( const Vector & v, const Vector & fill )
+	{
+		return add( shift( v ), fill );
+	}
+	/** a vector with value in lane 0 and zero elsewhere */
+	static inline Vector first( Value value )
+	{
+		Value buffer[LANES] __attribute__((aligned(ALIGNLIB_SIMD_ALIGNMENT)));
+		for (int x = 1; x < LANES; ++x) buffer[x] = 0;
+		buffer[0] = value;
+		return load( (Vector*)buffer );
+	}
+	/** largest element in a vector */
+	static inline Value hmax( const Vector & v )
+	{
+		Value buffer[LANES] __attribute__((aligned(ALIGNLIB_SIMD_ALIGNMENT)));
+		store( (Vector*)buffer, v );
+		Value m = buffer[0];
+		for (int x = 1; x < LANES; ++x) if (buffer[x] > m) m = buffer[x];
+		return m;
+	}
+};
+
+/** vector of signed 32-bit integers.
+
+	Arithmetic is not saturating. The kernels keep values well
+	within range by using a minus infinity of -2^30.
+ */
+struct SimdInt32
+{
+	typedef int Value;
+#if defined(__AVX2__)
+	typedef __m256i Vector;
+	enum { LANES = 8 };
+#else
+	typedef __m128i Vector;
+	enum { LANES = 4 };
+#endif
+	/** smallest value, used as minus infinity */
+	static Value minValue() { return -(1 << 30); }
+	/** largest value */
+	static Value maxValue() { return (1 << 30); }
+
+#if defined(__AVX2__)
+	static inline Vector set1( Value v ) { return _mm256_set1_epi32( v ); }
+	static inline Vector zero() { return _mm256_setzero_si256(); }
+	static inline Vector load( const Vector * p ) { return _mm256_load_si256( p ); }
+	static inline void store( Vector * p, const Vector & v ) { _mm256_store_si256( p, v ); }
+	static inline Vector add( const Vector & a, const Vector & b ) { return _mm256_add_epi32( a, b ); }
+	static inline Vector sub( const Vector & a, const Vector & b ) { return _mm256_sub_epi32( a, b ); }
+	static inline Vector max( const Vector & a, const Vector & b ) { return _mm256_max_epi32( a, b ); }
+	static inline Vector min( const Vector & a, const Vector & b ) { return _mm256_min_epi32( a, b ); }
+	static inline Vector cmpgt( const Vector & a, const Vector & b ) { return _mm256_cmpgt_epi32( a, b ); }
+	static inline Vector cmpeq( const Vector & a, const Vector & b ) { return _mm256_cmpeq_epi32( a, b ); }
+	static inline bool any( const Vector & mask ) { return _mm256_movemask_epi8( mask ) != 0; }
+	static inline Vector shift( const Vector & v )
+	{
+		return _mm256_alignr_epi8( v, _mm256_permute2x128_si256( v, v, 0x08 ), 12 );
+	}
+#else
+	static inline Vector set1( Value v ) { return _mm_set1_epi32( v ); }
+	static inline Vector zero() { return _mm_setzero_si128(); }
+	static inline Vector load( const Vector * p ) { return _mm_load_si128( p ); }
+	static inline void store( Vector * p, const Vector & v ) { _mm_store_si128( p, v ); }
+	static inline Vector add( const Vector & a, const Vector & b ) { return _mm_add_epi32( a, b ); }
+	static inline Vector sub( const Vector & a, const Vector & b ) { return _mm_sub_epi32( a, b ); }
+	static inline Vector cmpgt( const Vector & a, const Vector & b ) { return _mm_cmpgt_epi32( a, b ); }
+	static inline Vector cmpeq( const Vector & a, const Vector & b ) { return _mm_cmpeq_epi32( a, b ); }
+#if defined(__SSE4_1__)
+	static inline Vector max( const Vector & a, const Vector & b ) { return _mm_max_epi32( a, b ); }
+	static inline Vector min( const Vector & a, const Vector & b ) { return _mm_min_epi32( a, b ); }
+#else
+	static inline Vector max( const Vector & a, const Vector & b )
+	{
+		Vector mask = _mm_cmpgt_epi32( a, b );
+		return _mm_or_si128( _mm_and_si128( mask, a ), _mm_andnot_si128( mask, b ) );
+	}
+	static inline Vector min( const Vector & a, const Vector & b )
+	{
+		Vector mask = _mm_cmpgt_epi32( a, b );
+		return _mm_or_si128( _mm_and_si128( mask, b ), _mm_andnot_si128( mask, a ) );
+	}
+#endif
+	static inline bool any( const Vector & mask ) { return _mm_movemask_epi8( mask ) != 0; }
+	static inline Vector shift( const Vector & v ) { return _mm_slli_si128( v, 4 ); }
+#endif
+	static inline Vector shift( const Vector & v, const Vector & fill )
+	{
+		return add( shift( v ), fill );
+	}
+	static inline Vector first( Value value )
+	{
+		Value buffer[LANES] __attribute__((aligned(ALIGNLIB_SIMD_ALIGNMENT)));
+		for (int x = 1; x < LANES; ++x) buffer[x] = 0;
+		buffer[0] = value;
+		return load( (Vector*)buffer );
+	}
+	static inline Value hmax( const Vector & v )
+	{
+		Value buffer[LANES] __attribute__((aligned(ALIGNLIB_SIMD_ALIGNMENT)));
+		store( (Vector*)buffer, v );
+		Value m = buffer[0];
+		for (int x = 1; x < LANES; ++x) if (buffer[x] > m) m = buffer[x];
+		return m;
+	}
+};
+
+/** vector of double precision floating point values.
+
+	Multiplication and addition are separate instructions, thus
+	results are identical to the scalar code.
+ */
+struct SimdDouble
+{
+	typedef double Value;
+#if defined(__AVX2__)
+	typedef __m256d Vector;
+	enum { LANES = 4 };
+#else
+	typedef __m128d Vector;
+	enum { LANES = 2 };
+#endif
+
+#if defined(__AVX2__)
+	static inline Vector set1( Value v ) { return _mm256_set1_pd( v ); }
+	static inline Vector zero() { return _mm256_setzero_pd(); }
+	/** load from unaligned memory */
+	static inline Vector loadu( const Value * p ) { return _mm256_loadu_pd( p ); }
+	/** store to unaligned memory */
+	static inline void storeu( Value * p, const Vector & v ) { _mm256_storeu_pd( p, v ); }
+	static inline Vector add( const Vector & a, const Vector & b ) { return _mm256_add_pd( a, b ); }
+	static inline Vector sub( const Vector & a, const Vector & b ) { return _mm256_sub_pd( a, b ); }
+	static inline Vector mul( const Vector & a, const Vector & b ) { return _mm256_mul_pd( a, b ); }
+	static inline Vector div( const Vector & a, const Vector & b ) { return _mm256_div_pd( a, b ); }
+	static inline Vector cmpgt( const Vector & a, const Vector & b ) { return _mm256_cmp_pd( a, b, _CMP_GT_OQ ); }
+	/** elements of a where mask is set, elements of b otherwise */
+	static inline Vector select( const Vector & mask, const Vector & a, const Vector & b )
+	{
+		return _mm256_blendv_pd( b, a, mask );
+	}
+	/** split positive, normal numbers into mantissa in [1,2) and exponent */
+	static inline Vector frexp( const Vector & v, Vector & exponent )
+	{
+		const __m256i bits = _mm256_castpd_si256( v );
+		const __m256i e = _mm256_or_si256( _mm256_srli_epi64( bits, 52 ),
+				_mm256_set1_epi64x( 0x4330000000000000LL ) );
+		exponent = _mm256_sub_pd( _mm256_castsi256_pd( e ), _mm256_set1_pd( 4503599627371519.0 ) );
+		return _mm256_castsi256_pd( _mm256_or_si256(
+				_mm256_and_si256( bits, _mm256_set1_epi64x( 0x000FFFFFFFFFFFFFLL ) ),
+				_mm256_set1_epi64x( 0x3FF0000000000000LL ) ) );
+	}
+#else
+	static inline Vector set1( Value v ) { return _mm_set1_pd( v ); }
+	static inline Vector zero() { return _mm_setzero_pd(); }
+	static inline Vector loadu( const Value * p ) { return _mm_loadu_pd( p ); }
+	static inline void storeu( Value * p, const Vector & v ) { _mm_storeu_pd( p, v ); }
+	static inline Vector add( const Vector & a, const Vector & b ) { return _mm_add_pd( a, b ); }
+	static inline Vector sub( const Vector & a, const Vector & b ) { return _mm_sub_pd( a, b ); }
+	static inline Vector mul( const Vector & a, const Vector & b ) { return _mm_mul_pd( a, b ); }
+	static inline Vector div( const Vector & a, const Vector & b ) { return _mm_div_pd( a, b ); }
+	static inline Vector cmpgt( const Vector & a, const Vector & b ) { return _mm_cmpgt_pd( a, b ); }
+	static inline Vector select( const Vector & mask, const Vector & a, const Vector & b )
+	{
+		return _mm_or_pd( _mm_and_pd( mask, a ), _mm_andnot_pd( mask, b ) );
+	}
+	static inline Vector frexp( const Vector & v, Vector & exponent )
+	{
+		const __m128i bits = _mm_castpd_si128( v );
+		const __m128i e = _mm_or_si128( _mm_srli_epi64( bits, 52 ),
+				_mm_set1_epi64x( 0x4330000000000000LL ) );
+		exponent = _mm_sub_pd( _mm_castsi128_pd( e ), _mm_set1_pd( 4503599627371519.0 ) );
+		return _mm_castsi128_pd( _mm_or_si128(
+				_mm_and_si128( bits, _mm_set1_epi64x( 0x000FFFFFFFFFFFFFLL ) ),
+				_mm_set1_epi64x( 0x3FF0000000000000LL ) ) );
+	}
+#endif
+};
+
+/** vector of bytes for comparing residues.
+ */
+struct SimdInt8
+{
+	typedef unsigned char Value;
+#if defined(__AVX2__)
+	typedef __m256i Vector;
+	enum { LANES = 32 };
+#else
+	typedef __m128i Vector;
+	enum { LANES = 16 };
+#endif
+
+#if defined(__AVX2__)
+	static inline Vector set1( Value v ) { return _mm256_set1_epi8( (char)v ); }
+	static inline Vector zero() { return _mm256_setzero_si256(); }
+	/** load from unaligned memory */
+	static inline Vector loadu( const Value * p ) { return _mm256_loadu_si256( (const Vector*)p ); }
+	static inline Vector cmpeq( const Vector & a, const Vector & b ) { return _mm256_cmpeq_epi8( a, b ); }
+	static inline Vector bitwiseOr( const Vector & a, const Vector & b ) { return _mm256_or_si256( a, b ); }
+	/** bit i is set, if the most significant bit of element i is set */
+	static inline unsigned int movemask( const Vector & mask ) { return (unsigned int)_mm256_movemask_epi8( mask ); }
+#else
+	static inline Vector set1( Value v ) { return _mm_set1_epi8( (char)v ); }
+	static inline Vector zero() { return _mm_setzero_si128(); }
+	static inline Vector loadu( const Value * p ) { return _mm_loadu_si128( (const Vector*)p ); }
+	static inline Vector cmpeq( const Vector & a, const Vector & b ) { return _mm_cmpeq_epi8( a, b ); }
+	static inline Vector bitwiseOr( const Vector & a, const Vector & b ) { return _mm_or_si128( a, b ); }
+	static inline unsigned int movemask( const Vector & mask ) { return (unsigned int)_mm_movemask_epi8( mask ); }
+#endif
+};
+
+}
+
+#endif /* __SSE2__ */
+
+#endif /* ALIGNLIB_SIMD_H */
@@ -0,0 +1,90 @@
+/*
+  alignlib - a library for aligning protein sequences
+
+  $Id$
+
+  Copyright (C) 2026 Andreas Heger
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+*/
+
+#ifndef ALIGNLIB_THREADS_H
+#define ALIGNLIB_THREADS_H 1
+
+#if HAVE_CONFIG_H
+#include <config.h>
+#endif
+
+#include <algorithm>
+#include "alignlib_fwd.h"
+
+#ifdef HAVE_BOOST_THREAD
+#include <boost/thread/thread.hpp>
+#include <boost/bind.hpp>
+#endif
+
+/** Helpers for splitting work between threads.
+
+	Without boost::thread, all work is done in the calling thread.
+*/
+
+namespace alignlib
+{
+
+/** return the number of threads to use. If num_threads is 0, use
+ * one thread per processor.
+ */
+inline unsigned int getNumThreads( unsigned int num_threads )
+{
+#ifdef HAVE_BOOST_THREAD
+	if (num_threads == 0)
+		num_threads = std::max( 1U, boost::thread::hardware_concurrency() );
+	return num_threads;
+#else
+	return 1;
+#endif
+}
+
+/** call f( from, to ) for contiguous blocks of [0,n), one block per thread.
+ *
+ * f must not throw.
+ */
+template<class F>
+inline void runBlocks( Position n, unsigned int num_threads, const F & f )
+{
+	if (n <= 0)
+		return;
+
+	num_threads = std::min( (Position)getNumThreads( num_threads ), n );
+
+#ifdef HAVE_BOOST_THREAD
+	if (num_threads > 1)
+	{
+		boost::thread_group threads;
+		for (unsigned int t = 0; t < num_threads; ++t)
+			threads.create_thread( boost::bind<void>( f,
+					(Position)((long)n * t / num_threads),
+					(Position)((long)n * (t + 1) / num_threads) ) );
+		threads.join_all();
+		return;
+	}
+#endif
+
+	f( 0, n );
+}
+
+}
+
+#endif /* ALIGNLIB_THREADS_H */
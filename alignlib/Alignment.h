@@ -246,6 +246,24 @@ public:
 	/** adds a pair of residues to the alignment */
 	virtual void addPair( Position row, Position col, Score score = 0) = 0;
 
+	/** reserve space for n residue pairs.
+	 *
+	 * This is a hint for containers that store pairs in a list.
+	 */
+	virtual void reserve( Position n ) = 0;
+
+	/** adds n residue pairs to the alignment.
+	 *
+	 * @param pairs	 		array of residue pairs.
+	 * @param n				number of pairs.
+	 * @param already_sorted	true, if pairs are sorted by row and then by column
+	 * 						and there are no duplicates.
+	 * */
+	virtual void addPairs(
+			const ResiduePair * pairs,
+			Position n,
+			bool already_sorted = false ) = 0;
+
 	/** adds a diagonal to the alignment.
 	 *
 	 * @param row_from	  	row start
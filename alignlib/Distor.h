@@ -61,6 +61,15 @@ public:
 			HDistanceMatrix & dest,
 			const HMultipleAlignment & mali ) const = 0;
 
+	/** fill @ref DistanceMatrix from an @ref EncodedMultipleAlignment.
+	 *
+	 * @param dest @ref DistanceMatrix to fill.
+	 * @param mali @ref EncodedMultipleAlignment object.
+	 */
+	virtual void calculateMatrix(
+			HDistanceMatrix & dest,
+			const HEncodedMultipleAlignment & mali ) const = 0;
+
 	/** return the maximum possible distance
 	 * @return a distance
 	 * */
@@ -0,0 +1,286 @@
+/*
+  alignlib - a library for aligning protein sequences
+
+  $Id$
+
+  Copyright (C) 2026 Andreas Heger
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+*/
+
+#include <iostream>
+#include <algorithm>
+#include <vector>
+#include "alignlib_fwd.h"
+#include "alignlib_interfaces.h"
+#include "AlignlibDebug.h"
+#include "AlignlibException.h"
+#include "AlignlibSimd.h"
+#include "AlignlibThreads.h"
+#include "EncodedMultipleAlignment.h"
+#include "HelpersMultipleAlignment.h"
+
+using namespace std;
+
+namespace alignlib
+{
+
+/** size of the tiles (alignment columns x sequences) used for transposing */
+#define TILE_COLUMNS 256
+#define TILE_SEQUENCES 64
+
+//------------------------------factory functions -----------------------------
+HEncodedMultipleAlignment makeEncodedMultipleAlignment(
+		const HMultipleAlignment & mali,
+		const HEncoder & encoder,
+		unsigned int num_threads )
+{
+	debug_func_cerr(5);
+
+	return HEncodedMultipleAlignment( new EncodedMultipleAlignment( mali, encoder, num_threads ) );
+}
+
+//-----------------------------------------------------------------------------
+/** number of bits set in word */
+static inline Position countBits( EncodedMultipleAlignment::GapWord word )
+{
+#ifdef __GNUC__
+	return __builtin_popcountl( word );
+#else
+	Position n = 0;
+	for (; word; word &= word - 1)
+		++n;
+	return n;
+#endif
+}
+
+/** number of positions with the same residue in a and b */
+static Position countEqual( const Residue * a, const Residue * b, Position n )
+{
+	Position count = 0;
+	Position x = 0;
+
+#ifdef ALIGNLIB_HAVE_SIMD
+	// identical bytes are counted in byte-sized counters. These are summed
+	// up before they can overflow.
+	const __m128i zero = _mm_setzero_si128();
+	while (n - x >= 16)
+	{
+		const Position nvectors = std::min( (n - x) / 16, (Position)255 );
+		__m128i counts = zero;
+		for (Position v = 0; v < nvectors; ++v, x += 16)
+		{
+			__m128i eq = _mm_cmpeq_epi8(
+					_mm_loadu_si128( (const __m128i*)(a + x) ),
+					_mm_loadu_si128( (const __m128i*)(b + x) ) );
+			counts = _mm_sub_epi8( counts, eq );
+		}
+		__m128i sums = _mm_sad_epu8( counts, zero );
+		count += _mm_cvtsi128_si32( sums ) + _mm_cvtsi128_si32( _mm_srli_si128( sums, 8 ) );
+	}
+#endif
+
+	for (; x < n; ++x)
+		count += (a[x] == b[x]);
+
+	return count;
+}
+
+//-----------------------------------------------------------------------------
+/** encode the sequences from to to */
+class EncodeRowsWorker
+{
+public:
+	EncodeRowsWorker(
+			const std::vector<const char *> & sequences,
+			const Residue * table,
+			Residue width,
+			ResidueMatrix & rows,
+			std::vector<EncodedMultipleAlignment::GapWord> & gaps,
+			Position words_per_row,
+			std::vector<Position> & row_from,
+			std::vector<Position> & row_to ) :
+		mSequences( &sequences ), mTable( table ), mWidth( width ), mRows( &rows ),
+		mGaps( &gaps ), mWordsPerRow( words_per_row ),
+		mFrom( &row_from ), mTo( &row_to )
+		{}
+
+	void operator()( Position from, Position to ) const
+	{
+		typedef EncodedMultipleAlignment::GapWord GapWord;
+		const Position bits = 8 * sizeof(GapWord);
+		const Position length = mRows->getNumCols();
+
+		for (Position s = from; s < to; ++s)
+		{
+			const unsigned char * sequence = (const unsigned char *)(*mSequences)[s];
+			Residue * codes = mRows->getRow( s );
+			GapWord * gaps = &(*mGaps)[s * mWordsPerRow];
+
+			Position first = NO_POS, last = NO_POS;
+			for (Position c = 0; c < length; ++c)
+			{
+				const Residue code = mTable[sequence[c]];
+				codes[c] = code;
+				if (code == mWidth)
+					gaps[c / bits] |= (GapWord)1 << (c % bits);
+				else
+				{
+					if (first == NO_POS) first = c;
+					last = c;
+				}
+			}
+
+			(*mFrom)[s] = (first == NO_POS) ? 0 : first;
+			(*mTo)[s] = (first == NO_POS) ? 0 : last + 1;
+		}
+	}
+
+private:
+	const std::vector<const char *> * mSequences;
+	const Residue * mTable;
+	Residue mWidth;
+	ResidueMatrix * mRows;
+	std::vector<EncodedMultipleAlignment::GapWord> * mGaps;
+	Position mWordsPerRow;
+	std::vector<Position> * mFrom;
+	std::vector<Position> * mTo;
+};
+
+/** copy the codes of the columns from to to from rows to columns.
+ *
+ * The matrix is transposed in tiles, so that rows and columns
+ * stay in the cache.
+ */
+class TransposeWorker
+{
+public:
+	TransposeWorker( const ResidueMatrix & rows, ResidueMatrix & columns ) :
+		mRows( &rows ), mColumns( &columns )
+		{}
+
+	void operator()( Position from, Position to ) const
+	{
+		const int nsequences = mRows->getNumRows();
+
+		for (int s_from = 0; s_from < nsequences; s_from += TILE_SEQUENCES)
+		{
+			const int s_to = std::min( s_from + TILE_SEQUENCES, nsequences );
+			for (Position c_from = from; c_from < to; c_from += TILE_COLUMNS)
+			{
+				const Position c_to = std::min( c_from + TILE_COLUMNS, to );
+				for (Position c = c_from; c < c_to; ++c)
+				{
+					Residue * dest = mColumns->getRow( c );
+					for (int s = s_from; s < s_to; ++s)
+						dest[s] = mRows->getRow( s )[c];
+				}
+			}
+		}
+	}
+
+private:
+	const ResidueMatrix * mRows;
+	ResidueMatrix * mColumns;
+};
+
+//------------------------------------< constructors and destructors >-----
+EncodedMultipleAlignment::EncodedMultipleAlignment(
+		const HMultipleAlignment & mali,
+		const HEncoder & encoder,
+		unsigned int num_threads ) :
+	mLength( mali->getLength() ),
+	mNumSequences( mali->getNumSequences() ),
+	mWidth( encoder->getAlphabetSize() ),
+	mRows( mNumSequences, mLength, mWidth ),
+	mColumns( mLength, mNumSequences, mWidth ),
+	mWordsPerRow( (mLength + BITS_PER_WORD - 1) / BITS_PER_WORD ),
+	mGaps( mNumSequences * mWordsPerRow, 0 ),
+	mFrom( mNumSequences, 0 ),
+	mTo( mNumSequences, 0 )
+{
+	debug_func_cerr(5);
+
+	// table for all characters, characters outside the alphabet (gaps) are set to width
+	Residue table[256];
+	for (int c = 0; c < 256; ++c)
+	{
+		table[c] = mWidth;
+		if (c < 128)
+			table[c] = std::min( encoder->encode( (char)c ), mWidth );
+	}
+
+	std::vector<const char *> sequences( mNumSequences );
+	for (int s = 0; s < mNumSequences; ++s)
+	{
+		const std::string & sequence = (*mali)[s];
+		if ((Position)sequence.size() < mLength)
+			THROW( "row " + toString( s ) + " is shorter than the multiple alignment: "
+					+ toString( sequence.size() ) + " < " + toString( mLength ) );
+		sequences[s] = sequence.c_str();
+	}
+
+	runBlocks( mNumSequences, num_threads,
+			EncodeRowsWorker( sequences, table, mWidth, mRows, mGaps, mWordsPerRow, mFrom, mTo ) );
+
+	runBlocks( mLength, num_threads, TransposeWorker( mRows, mColumns ) );
+}
+
+EncodedMultipleAlignment::~EncodedMultipleAlignment()
+{
+	debug_func_cerr(5);
+}
+
+//-----------------------------------------------------------------------------
+void EncodedMultipleAlignment::compareRows(
+		int row_1,
+		int row_2,
+		Position & identities,
+		Position & aligned ) const
+{
+	identities = 0;
+	aligned = 0;
+
+	// outside the common range there is a gap in at least one sequence
+	const Position from = std::max( mFrom[row_1], mFrom[row_2] );
+	const Position to = std::min( mTo[row_1], mTo[row_2] );
+	if (from >= to)
+		return;
+
+	// columns with a gap in both sequences compare as identical
+	const Position equal = countEqual( getRow( row_1 ) + from, getRow( row_2 ) + from, to - from );
+
+	const GapWord * gaps_1 = getGaps( row_1 );
+	const GapWord * gaps_2 = getGaps( row_2 );
+	const Position word_from = from / BITS_PER_WORD;
+	const Position word_to = (to - 1) / BITS_PER_WORD;
+	const GapWord mask_from = ~(GapWord)0 << (from % BITS_PER_WORD);
+	const GapWord mask_to = ~(GapWord)0 >> (BITS_PER_WORD - 1 - (to - 1) % BITS_PER_WORD);
+
+	Position any_gap = 0, both_gaps = 0;
+	for (Position w = word_from; w <= word_to; ++w)
+	{
+		GapWord mask = ~(GapWord)0;
+		if (w == word_from) mask &= mask_from;
+		if (w == word_to) mask &= mask_to;
+		any_gap += countBits( (gaps_1[w] | gaps_2[w]) & mask );
+		both_gaps += countBits( (gaps_1[w] & gaps_2[w]) & mask );
+	}
+
+	aligned = (to - from) - any_gap;
+	identities = equal - both_gaps;
+}
+
+} // namespace alignlib
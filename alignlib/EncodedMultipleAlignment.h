@@ -0,0 +1,161 @@
+/*
+  alignlib - a library for aligning protein sequences
+
+  $Id$
+
+  Copyright (C) 2026 Andreas Heger
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+*/
+
+
+#if HAVE_CONFIG_H
+#include <config.h>
+#endif
+
+#ifndef ENCODED_MULTIPLE_ALIGNMENT_H
+#define ENCODED_MULTIPLE_ALIGNMENT_H 1
+
+#include <vector>
+#include "alignlib_fwd.h"
+#include "Matrix.h"
+
+namespace alignlib
+{
+
+/**
+   @short A @ref MultipleAlignment encoded into residue codes.
+
+   The rows of a @ref MultipleAlignment are encoded once with an
+   @ref Encoder. Characters that are not part of the alphabet of
+   the encoder (gaps) are stored as the alphabet size. Masked and
+   unknown characters have the code of the mask character.
+
+   The codes are kept twice: by sequence for comparing sequences
+   (@ref Distor) and by column for counting residues (@ref Weightor).
+   In addition, there is a bitmap of gaps for each sequence and
+   the range of columns that contain residues.
+
+   The object is immutable and can be shared between threads.
+
+   @author Andreas Heger
+   @version $Id$
+*/
+class EncodedMultipleAlignment
+{
+ public:
+
+	/** a word in the gap bitmap */
+	typedef unsigned long GapWord;
+
+	/** encode a multiple alignment.
+	 *
+	 * @param mali	@ref MultipleAlignment to encode.
+	 * @param encoder @ref Encoder to use.
+	 * @param num_threads number of threads to use. If 0, use one thread per processor.
+	 */
+	EncodedMultipleAlignment(
+			const HMultipleAlignment & mali,
+			const HEncoder & encoder,
+			unsigned int num_threads = 1 );
+
+	/** destructor */
+	~EncodedMultipleAlignment();
+
+	/** return the number of columns */
+	Position getLength() const { return mLength; }
+
+	/** return the number of sequences */
+	int getNumSequences() const { return mNumSequences; }
+
+	/** return the size of the alphabet. Gaps have this code. */
+	Residue getWidth() const { return mWidth; }
+
+	/** return the codes of a sequence, one for each column */
+	const Residue * getRow( int row ) const { return mRows.getRow( row ); }
+
+	/** return the codes in a column, one for each sequence */
+	const Residue * getColumn( Position column ) const { return mColumns.getRow( column ); }
+
+	/** return the codes by column (columns x sequences) */
+	const ResidueMatrix & getColumns() const { return mColumns; }
+
+	/** return true, if there is a gap in row at column */
+	bool isGap( int row, Position column ) const
+	{
+		return (getGaps( row )[column / BITS_PER_WORD] >> (column % BITS_PER_WORD)) & 1;
+	}
+
+	/** return the first column in row that is not a gap */
+	Position getFrom( int row ) const { return mFrom[row]; }
+
+	/** return the column after the last column in row that is not a gap */
+	Position getTo( int row ) const { return mTo[row]; }
+
+	/** compare two sequences.
+	 *
+	 * @param row_1 first sequence.
+	 * @param row_2 second sequence.
+	 * @param identities number of columns with the same residue in both sequences.
+	 * @param aligned number of columns without a gap in both sequences.
+	 */
+	void compareRows(
+			int row_1,
+			int row_2,
+			Position & identities,
+			Position & aligned ) const;
+
+ private:
+	/** number of bits in a GapWord */
+	static const Position BITS_PER_WORD = 8 * sizeof(GapWord);
+
+	/** return the gap bitmap of a sequence */
+	const GapWord * getGaps( int row ) const { return &mGaps[row * mWordsPerRow]; }
+
+	/** number of columns */
+	Position mLength;
+
+	/** number of sequences */
+	int mNumSequences;
+
+	/** alphabet size */
+	Residue mWidth;
+
+	/** codes by sequence (sequences x columns) */
+	ResidueMatrix mRows;
+
+	/** codes by column (columns x sequences) */
+	ResidueMatrix mColumns;
+
+	/** number of words per sequence in the gap bitmap */
+	Position mWordsPerRow;
+
+	/** gap bitmap, a set bit is a gap */
+	std::vector<GapWord> mGaps;
+
+	/** first non-gap column of each sequence */
+	std::vector<Position> mFrom;
+
+	/** last non-gap column + 1 of each sequence */
+	std::vector<Position> mTo;
+
+	/** the object can not be copied */
+	EncodedMultipleAlignment( const EncodedMultipleAlignment & );
+	EncodedMultipleAlignment & operator=( const EncodedMultipleAlignment & );
+};
+
+}
+
+#endif /* ENCODED_MULTIPLE_ALIGNMENT_H */
@@ -127,6 +127,19 @@ HAlignandum makeProfile(
 HAlignandum makeProfile(
 		const HMultipleAlignment & mali );
 
+/** create a new profile from an @ref EncodedMultipleAlignment.
+ *
+ * The object is initialized with default objects. The encoder of
+ * the multiple alignment must have the same alphabet as the default
+ * encoder.
+ *
+ * @param mali encoded multiple alignment.
+ * @return a new @ref Alignandum object filled from a multiple alignment.
+ */
+
+HAlignandum makeProfile(
+		const HEncodedMultipleAlignment & mali );
+
 /** create a new profile from two @ref Alignandum objects.
  *
  * @param seqa first sequence/profile
@@ -153,6 +166,34 @@ HAlignandum makeProfile(
 		const HMultAlignment & mali,
 		const HAlignandumVector & sequences );
 
+/** prepare a profile for alignment using several threads.
+ *
+ * The columns of the profile are split into blocks that are
+ * prepared in parallel. Other @ref Alignandum objects are
+ * prepared as usual.
+ *
+ * @param profile @ref Alignandum object to prepare.
+ * @param num_threads number of threads to use. If 0, use one thread per processor.
+ */
+void prepareProfile(
+		const HAlignandum & profile,
+		unsigned int num_threads = 1 );
+
+/** prepare several profiles for alignment using several threads.
+ *
+ * Each thread prepares whole profiles, longest profiles first. If there
+ * are fewer profiles than threads, the columns within each profile are
+ * prepared in parallel (see @ref prepareProfile).
+ *
+ * The profiles need to be distinct objects. The result does not depend
+ * on the number of threads.
+ *
+ * @param profiles @ref Alignandum objects to prepare.
+ * @param num_threads number of threads to use. If 0, use one thread per processor.
+ */
+void prepareProfiles(
+		const AlignandumVector & profiles,
+		unsigned int num_threads = 1 );
 
 /**
  * @}
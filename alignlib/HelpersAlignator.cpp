@@ -30,6 +30,22 @@
 #include "AlignlibDebug.h"
 
 #include "HelpersAlignator.h"
+#include "HelpersAlignment.h"
+#include "Alignator.h"
+#include "ImplAlignator.h"
+#include "Alignment.h"
+#include "Alignandum.h"
+#include "AlignlibException.h"
+#include "AlignlibThreads.h"
+
+#include <algorithm>
+#include <new>
+
+#ifdef HAVE_BOOST_THREAD
+#include <boost/thread/thread.hpp>
+#include <boost/thread/mutex.hpp>
+#include <boost/ref.hpp>
+#endif
 
 using namespace std;
 
@@ -41,5 +57,261 @@ namespace alignlib
 //---------------------------------------------------------------------------
 // convenience functions:
 
+size_t getNumCells( const HAlignator & alignator )
+{
+	boost::shared_ptr<ImplAlignator> impl( boost::dynamic_pointer_cast<ImplAlignator, Alignator>( alignator ) );
+	if (!impl)
+		THROW( "alignator does not count cells" );
+	return impl->getNumCells();
+}
+
+//---------------------------------------------------------------------------
+// database search
+
+/** true, if hit a is better than hit b */
+static inline bool isBetterHit( const SearchHit & a, const SearchHit & b )
+{
+	Score score_a = a.mAlignment->getScore();
+	Score score_b = b.mAlignment->getScore();
+	if (score_a != score_b)
+		return score_a > score_b;
+	return a.mIndex < b.mIndex;
+}
+
+/** queue of targets shared between the threads of a search.
+ *
+ * Targets are handed out in chunks, longest targets first. The
+ * chunk size decreases as the queue empties, so that
+ * all threads finish at about the same time.
+ */
+class SearchQueue
+{
+public:
+	SearchQueue( const AlignandumVector & targets, unsigned int num_threads ) :
+		mTargets( targets ), mNumThreads( num_threads ), mNext( 0 )
+	{
+		std::vector< std::pair<Position, size_t> > lengths( targets.size() );
+		for (size_t x = 0; x < targets.size(); ++x)
+			lengths[x] = std::make_pair( -targets[x]->getLength(), x );
+		std::sort( lengths.begin(), lengths.end() );
+
+		mOrder.resize( targets.size() );
+		for (size_t x = 0; x < lengths.size(); ++x)
+			mOrder[x] = lengths[x].second;
+	}
+
+	/** get the next chunk of targets. Returns false if the queue is empty. */
+	bool next( std::vector<size_t> & indices, AlignandumVector & chunk )
+	{
+#ifdef HAVE_BOOST_THREAD
+		boost::mutex::scoped_lock lock( mMutex );
+#endif
+		indices.clear();
+		chunk.clear();
+
+		size_t remaining = mOrder.size() - mNext;
+		if (remaining == 0)
+			return false;
+
+		size_t size = std::max( (size_t)1, remaining / (4 * mNumThreads) );
+		for (size_t x = mNext; x < mNext + size; ++x)
+		{
+			indices.push_back( mOrder[x] );
+			chunk.push_back( mTargets[mOrder[x]] );
+		}
+		mNext += size;
+		return true;
+	}
+
+	/** hand out no more targets */
+	void cancel()
+	{
+#ifdef HAVE_BOOST_THREAD
+		boost::mutex::scoped_lock lock( mMutex );
+#endif
+		mNext = mOrder.size();
+	}
+
+private:
+	const AlignandumVector & mTargets;
+	unsigned int mNumThreads;
+	std::vector<size_t> mOrder;
+	size_t mNext;
+#ifdef HAVE_BOOST_THREAD
+	boost::mutex mMutex;
+#endif
+};
+
+/** keep the best hits of a thread in a heap with the worst hit at the front */
+class SearchCollector : public AlignatorCallback
+{
+public:
+	SearchCollector( size_t max_hits ) : mMaxHits( max_hits ), mIndices( NULL ) {}
+
+	virtual bool operator()( size_t index, const HAlignandum & target, const HAlignment & result )
+	{
+		if (result->isEmpty())
+			return true;
+
+		SearchHit hit( (*mIndices)[index], result );
+
+		if (mMaxHits > 0 && mHits.size() == mMaxHits)
+		{
+			if (!isBetterHit( hit, mHits.front() ))
+				return true;
+			std::pop_heap( mHits.begin(), mHits.end(), isBetterHit );
+			mHits.pop_back();
+		}
+
+		// result is re-used for the next target
+		hit.mAlignment = result->getClone();
+		mHits.push_back( hit );
+		std::push_heap( mHits.begin(), mHits.end(), isBetterHit );
+		return true;
+	}
+
+	size_t mMaxHits;
+	const std::vector<size_t> * mIndices;
+	SearchHits mHits;
+};
+
+/** a thread of a search */
+class SearchWorker
+{
+public:
+	SearchWorker( const HAlignator & alignator,
+			const HAlignandum & query,
+			SearchQueue & queue,
+			size_t max_hits ) :
+		mAlignator( alignator ), mQuery( query ), mQueue( &queue ),
+		mCollector( max_hits ), mFailed( false ), mOutOfMemory( false )
+		{}
+
+	void operator()()
+	{
+		std::vector<size_t> indices;
+		AlignandumVector chunk;
+		HAlignment result = makeAlignmentVector();
+		mCollector.mIndices = &indices;
+
+		// exceptions can not pass thread boundaries, they are re-thrown
+		// by the main thread. The other threads stop after their current chunk.
+		try
+		{
+			while (mQueue->next( indices, chunk ))
+				mAlignator->alignMany( result, mQuery, chunk, mCollector );
+		}
+		catch (std::bad_alloc & e)
+		{
+			mOutOfMemory = true;
+		}
+		catch (std::exception & e)
+		{
+			mMessage = e.what();
+		}
+		catch (...)
+		{
+			mMessage = "unknown exception in search thread";
+		}
+
+		if (mOutOfMemory || !mMessage.empty())
+		{
+			mFailed = true;
+			mQueue->cancel();
+		}
+	}
+
+	/** re-throw an exception caught in the thread */
+	void rethrow() const
+	{
+		if (mOutOfMemory)
+			throw std::bad_alloc();
+		throw AlignlibException( mMessage );
+	}
+
+	HAlignator mAlignator;
+	HAlignandum mQuery;
+	SearchQueue * mQueue;
+	SearchCollector mCollector;
+	bool mFailed;
+	bool mOutOfMemory;
+	std::string mMessage;
+};
+
+SearchHits searchDatabase(
+		const HAlignator & alignator,
+		const HAlignandum & query,
+		const AlignandumVector & targets,
+		size_t max_hits,
+		unsigned int num_threads )
+{
+	debug_func_cerr(5);
+
+	num_threads = getNumThreads( num_threads );
+
+	// preparing is not thread-safe
+	query->prepare();
+	for (size_t x = 0; x < targets.size(); ++x)
+		targets[x]->prepare();
+
+	// let the alignator cache data on the query before the
+	// query is shared between threads
+	boost::shared_ptr<ImplAlignator> primer(
+			boost::dynamic_pointer_cast<ImplAlignator, Alignator>( alignator->getClone() ) );
+	if (primer)
+	{
+		primer->startBatch( query, targets );
+		primer->finishBatch();
+	}
+
+	SearchQueue queue( targets, num_threads );
+
+	// the clones collect statistics from zero, they are added to
+	// the alignator after the search.
+	std::vector<SearchWorker> workers;
+	workers.reserve( num_threads );
+	for (unsigned int t = 0; t < num_threads; ++t)
+	{
+		HAlignator clone( alignator->getClone() );
+		boost::shared_ptr<ImplAlignator> impl( boost::dynamic_pointer_cast<ImplAlignator, Alignator>( clone ) );
+		if (impl)
+			impl->resetStatistics();
+		workers.push_back( SearchWorker( clone, query, queue, max_hits ) );
+	}
+
+	if (num_threads == 1)
+		workers[0]();
+#ifdef HAVE_BOOST_THREAD
+	else
+	{
+		boost::thread_group threads;
+		for (unsigned int t = 0; t < num_threads; ++t)
+			threads.create_thread( boost::ref( workers[t] ) );
+		threads.join_all();
+	}
+#endif
+
+	boost::shared_ptr<ImplAlignator> impl( boost::dynamic_pointer_cast<ImplAlignator, Alignator>( alignator ) );
+	if (impl)
+		for (unsigned int t = 0; t < num_threads; ++t)
+			impl->addStatistics(
+					*boost::dynamic_pointer_cast<ImplAlignator, Alignator>( workers[t].mAlignator ) );
+
+	SearchHits hits;
+	for (unsigned int t = 0; t < num_threads; ++t)
+	{
+		if (workers[t].mFailed)
+			workers[t].rethrow();
+		const SearchHits & h = workers[t].mCollector.mHits;
+		hits.insert( hits.end(), h.begin(), h.end() );
+	}
+
+	std::sort( hits.begin(), hits.end(), isBetterHit );
+	if (max_hits > 0 && hits.size() > max_hits)
+		hits.resize( max_hits );
+
+	return hits;
+}
+
 
 } // namespace alignlib
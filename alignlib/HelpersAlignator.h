@@ -68,6 +68,76 @@ HAlignator makeAlignatorDPFull(
 		bool penalize_col_left = false, 
 		bool penalize_col_right = false );
 
+/** make an @ref Alignator object performing full dynamic programming with
+ * reduced memory usage.
+ * 
+ * The alignments are identical to the ones obtained with an
+ * object created by @ref makeAlignatorDPFull. Instead of the full
+ * trace matrix, only a block of it is kept in memory and the
+ * trace back matrix is recomputed from checkpoints as required. 
+ * Memory usage is proportional to sqrt(rows) * cols instead of rows * cols
+ * at the expense of up to one additional pass through the
+ * dynamic programming matrix.
+ * 
+ * @param alignment_type 	The @ref AlignmentType (global, local, wrapping)
+ * @param gop				Gap openening penalty.
+ * @param gep				Gap extension penalty.
+ * @param penalize_row_left		Penalize gaps on left side of row sequence (global alignment)
+ * @param penalize_row_right	Penalize gaps on right side of row sequence (global alignment).
+ * @param penalize_col_left		Penalize gaps on left side of col sequence (global alignment)
+ * @param penalize_col_right	Penalize gaps on right side of col sequence (global alignment).
+ * 
+ * @return a new @ref Alignator object.
+ * */
+HAlignator makeAlignatorDPFullLowMemory( 
+		AlignmentType alignment_type,
+		Score gop, Score gep, 
+		bool penalize_row_left = false, 
+		bool penalize_row_right = false,
+		bool penalize_col_left = false, 
+		bool penalize_col_right = false );
+
+/** make an @ref Alignator object computing the score of a dynamic programming
+ * alignment only.
+ * 
+ * The same recurrences as in @ref makeAlignatorDPFull are used, but
+ * no trace matrix is kept. The resulting alignment contains
+ * only the cell in which the best alignment ends.
+ * 
+ * @param alignment_type 	The @ref AlignmentType (global, local, wrapping)
+ * @param gop				Gap openening penalty.
+ * @param gep				Gap extension penalty.
+ * @param penalize_row_left		Penalize gaps on left side of row sequence (global alignment)
+ * @param penalize_row_right	Penalize gaps on right side of row sequence (global alignment).
+ * @param penalize_col_left		Penalize gaps on left side of col sequence (global alignment)
+ * @param penalize_col_right	Penalize gaps on right side of col sequence (global alignment).
+ * 
+ * @return a new @ref Alignator object.
+ * */
+HAlignator makeAlignatorDPScoreOnly( 
+		AlignmentType alignment_type,
+		Score gop, Score gep, 
+		bool penalize_row_left = false, 
+		bool penalize_row_right = false,
+		bool penalize_col_left = false, 
+		bool penalize_col_right = false );
+
+/** make an @ref Alignator object performing local alignment with
+ * a striped, vectorized Smith-Waterman algorithm.
+ * 
+ * The result is the same as for an object created with
+ * @ref makeAlignatorDPFull performing local alignment. The vectorized
+ * algorithm is used for pairs of sequences with an integral substitution
+ * matrix and integral gap penalties. Other objects are aligned
+ * with full dynamic programming.
+ * 
+ * @param gop				Gap openening penalty.
+ * @param gep				Gap extension penalty.
+ * 
+ * @return a new @ref Alignator object.
+ * */
+HAlignator makeAlignatorSWStriped( Score gop, Score gep );
+
 /** make @ref Alignator object that return pairs of identical residues. 
  * 
  * This alignator object returns a non-linear alignment (dotplot).
@@ -142,6 +212,21 @@ HAlignator makeAlignatorDotsDiagonal(
 		Score diagnal_gop = 0,
 		Score diagonal_gep = 0 );
 
+/** make an @ref Alignator object, which does a dot-alignment using sparse dynamic programming.
+ *
+ * The resulting alignments are the same as for @ref makeAlignatorDots, but
+ * the best predecessor of each dot is found in logarithmic time. Use this
+ * for dense dotplots.
+ *
+ * @param alignator	@ref Alignator object to build the dot matrix.
+ * @param gop gap opening penalty.
+ * @param gep gap extension penalty.
+ */
+HAlignator makeAlignatorDotsSparse(
+		const HAlignator & alignator,
+		Score gop,
+		Score gep );
+
 /** make an @ref Alignator object, which aligns fragments. */
 HAlignator makeAlignatorFragments(
 		Score gop, 
@@ -192,10 +277,121 @@ HAlignator makeAlignatorGroupies(
  */
 HAlignator makeAlignatorGroupies();
 
+/** Alignator object for seed-and-extend alignment via high-scoring segment pairs.
+ *
+ * Seeds are filtered by a two-hit criterion and extended without gaps
+ * before HSPs above a score threshold are passed to the gapped
+ * alignator. See @ref ImplAlignatorHSP for an explanation of the algorithm.
+ *
+ * @param alignator_dots	@ref Alignator to build seeds, for example @ref makeAlignatorTuples.
+ * @param alignator_gapped	@ref Alignator for gapped extension. The alignator
+ * 							is restricted to a band around each HSP by setting
+ * 							the @ref Iterator2D of a copy of its toolkit.
+ * @param tuple_size		minimum distance between two seeds on a diagonal.
+ * @param window			maximum distance between two seeds on a diagonal.
+ * @param xdrop				stop ungapped extension if the score drops xdrop below the best score.
+ * @param min_score			minimum score of an ungapped segment to be extended with gaps.
+ * @param band				number of diagonals on either side of an HSP for gapped extension.
+ */
+HAlignator makeAlignatorHSP(
+		const HAlignator & alignator_dots,
+		const HAlignator & alignator_gapped,
+		const Position tuple_size = 3,
+		const Position window = 40,
+		const Score xdrop = 20,
+		const Score min_score = 30,
+		const Diagonal band = 16 );
+
 /**
  * @}
  */
 
+/** counts of the stages of an alignator created by @ref makeAlignatorHSP.
+ */
+struct HSPCounts
+{
+	HSPCounts() :
+		mNumSeeds( 0 ), mNumTwoHits( 0 ), mNumHSPs( 0 ), mNumExtensions( 0 ) {}
+
+	/** number of seeds */
+	size_t mNumSeeds;
+
+	/** number of seed pairs satisfying the two-hit criterion */
+	size_t mNumTwoHits;
+
+	/** number of ungapped segments scoring above the threshold */
+	size_t mNumHSPs;
+
+	/** number of gapped extensions */
+	size_t mNumExtensions;
+};
+
+/** return counts accumulated by an alignator created by @ref makeAlignatorHSP.
+ *
+ * Counts accumulate over all alignments, including those in the threads
+ * of @ref searchDatabase, until @ref resetHSPCounts is called.
+ * Throws an @ref AlignlibException if alignator has not been created
+ * by @ref makeAlignatorHSP.
+ */
+HSPCounts getHSPCounts( const HAlignator & alignator );
+
+/** reset counts of an alignator created by @ref makeAlignatorHSP.
+ */
+void resetHSPCounts( const HAlignator & alignator );
+
+/** return the number of cells computed by alignator in the last alignment.
+ *
+ * With an iterator created by @ref makeIterator2DXDrop, this is the
+ * number of cells within the x-drop region. Throws an @ref AlignlibException
+ * if alignator does not keep this count.
+ */
+size_t getNumCells( const HAlignator & alignator );
+
+/** a hit returned by @ref searchDatabase.
+ */
+struct SearchHit
+{
+	SearchHit( size_t index = 0, const HAlignment & alignment = HAlignment() ) :
+		mIndex( index ), mAlignment( alignment ) {}
+
+	/** index of the target in the database */
+	size_t mIndex;
+
+	/** alignment between query (row) and target (col) */
+	HAlignment mAlignment;
+};
+
+typedef std::vector<SearchHit> SearchHits;
+
+/** search a query against a database of targets.
+ *
+ * The targets are distributed dynamically between num_threads threads.
+ * Each thread works with its own clone of alignator and aligns its
+ * share of the targets with @ref Alignator::alignMany. Long targets
+ * are aligned first to balance the load between threads.
+ *
+ * The query and the targets are prepared before the search starts,
+ * they are not modified during the search. The toolkit of alignator
+ * is shared between the threads.
+ *
+ * The result does not depend on the number of threads.
+ *
+ * @param alignator		@ref Alignator object used for the alignments.
+ * @param query			@ref Alignandum object to search with.
+ * @param targets		@ref Alignandum objects to search.
+ * @param max_hits		number of hits to return. If 0, all hits are returned.
+ * @param num_threads	number of threads. If 0, use the number of processors.
+ *
+ * @return hits sorted by decreasing score. Hits with the same
+ * score are sorted by index.
+ */
+SearchHits searchDatabase(
+		const HAlignator & alignator,
+		const HAlignandum & query,
+		const AlignandumVector & targets,
+		size_t max_hits = 10,
+		unsigned int num_threads = 1 );
+
 
 
 }
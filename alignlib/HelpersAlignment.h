@@ -141,6 +141,19 @@ HAlignment makeAlignmentMatrixUnsorted();
  */
 HAlignment makeAlignmentMatrixDiagonal();
 
+/** make a @ref Alignment object.
+ *
+ *    - sort order: by row, then col.
+ * Degeneracy: n:n
+ *
+ * This object keeps rows, columns and scores of residue
+ * pairs in separate arrays. Suitable for dotplots with
+ * many dots.
+ *
+ * @return a new @ref Alignment object.
+ */
+HAlignment makeAlignmentMatrixArrays();
+
 /** make a @ref Alignment object.
  *
  *    - sort order: by row.
@@ -54,6 +54,22 @@ namespace alignlib
 		  const Diagonal lower_diagonal = 0,
 		  const Diagonal upper_diagonal = 0);
 
+  /** iterator that follows the alignment path.
+   *
+   * Dynamic programming does not extend cells that score more
+   * than xdrop below the best score seen so far.
+   *
+   * The iterator only adapts in local alignments with @ref ImplAlignatorDPFull,
+   * other alignators compute the full matrix.
+   */
+  HIterator2D makeIterator2DXDrop( 
+		  const HAlignandum & row,
+		  const HAlignandum & col,
+		  const Score xdrop );
+
+  HIterator2D makeIterator2DXDrop( 
+		  const Score xdrop );
+
   /** @addtogroup Defaults
    * @{
    */ 
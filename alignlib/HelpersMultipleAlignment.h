@@ -64,6 +64,22 @@ HMultipleAlignment makeMultipleAlignmentDots(
 		bool compress_unaligend_columns = true,
 		int max_insertion_length = -1);
 
+/** @return a new @ref EncodedMultipleAlignment object.
+ * 
+ * The multiple alignment is encoded once and can then be used
+ * by @ref Weightor, @ref Distor and @ref Profile objects
+ * without encoding it again.
+ * 
+ * @param mali @ref MultipleAlignment to encode.
+ * @param encoder @ref Encoder to use.
+ * @param num_threads number of threads to use. If 0, use one thread per processor.
+ * @return a new @ref EncodedMultipleAlignment object.
+ */ 
+HEncodedMultipleAlignment makeEncodedMultipleAlignment(
+		const HMultipleAlignment & mali,
+		const HEncoder & encoder,
+		unsigned int num_threads = 1 );
+
 /** @} */
 
 
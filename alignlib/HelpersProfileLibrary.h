@@ -0,0 +1,82 @@
+/*
+  alignlib - a library for aligning protein sequences
+
+  $Id$
+
+  Copyright (C) 2026 Andreas Heger
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+*/
+
+#if HAVE_CONFIG_H
+#include <config.h>
+#endif
+
+#ifndef HELPERS_PROFILE_LIBRARY_H
+#define HELPERS_PROFILE_LIBRARY_H 1
+
+#include <string>
+#include "alignlib_fwd.h"
+#include "ProfileLibrary.h"
+
+namespace alignlib
+{
+
+/**
+ *
+ * @defgroup FactoryProfileLibrary Factory functions for ProfileLibrary objects.
+ * @{
+ */
+
+/** @brief write profiles to a binary library file.
+ *
+ * Profiles are prepared before writing. Profiles that have not been
+ * prepared before are released again after writing, so that only one
+ * prepared profile is kept in memory at a time.
+ *
+ * The library starts with a header and an offset table. The counts,
+ * frequencies and scores of each profile follow as row-major matrices,
+ * each starting at a 64-byte boundary, followed by the masked columns.
+ *
+ * The profiles need to use the alphabet of the @ref Encoder of the
+ * default toolkit.
+ *
+ * @param filename	file to write to.
+ * @param profiles	@ref Profile objects to write.
+ */
+void writeProfileLibrary(
+		const std::string & filename,
+		const AlignandumVector & profiles );
+
+/** @brief open a library of profiles written with @ref writeProfileLibrary.
+ *
+ * The file is mapped into memory. Opening takes constant time, independent
+ * of the number of profiles, and profiles are created without copying data.
+ *
+ * The library needs to have been written with the same alphabet as the
+ * @ref Encoder of the default toolkit.
+ *
+ * @param filename	file to read from.
+ * @return a new @ref ProfileLibrary object.
+ */
+HProfileLibrary openProfileLibrary( const std::string & filename );
+
+/**
+ * @}
+ */
+
+}
+
+#endif	/* HELPERS_PROFILE_LIBRARY_H */
@@ -146,6 +146,24 @@ HRegularizor makeRegularizorDirichletInterpolate( WeightedCount fade_cutoff = 0)
 */
 HRegularizor makeRegularizorDirichletPrecomputed( WeightedCount fade_cutoff = 0);
 
+/** make @ref Regularizor object using the 9-component mixture model by Sjolander et al. (1996).
+ *
+ * For more information, see:
+ *
+ * Sjölander K, Karplus K, Brown M, Hughey R, Krogh A, Mian IS, Haussler D.
+ * Dirichlet mixtures: a method for improved detection of weak but significant protein sequence homology.
+ * Comput Appl Biosci. 1996 Aug;12(4):327-45.
+ * PMID: 8902360
+ *
+ * This object processes several columns at a time and approximates the Gamma function
+ * with vector instructions. It can be used by several threads at the same time.
+ *
+ * @param fade_cutoff	do not apply regularizor if there are least this number of counts.
+ *
+ * @return a new @ref Regularizor object.
+*/
+HRegularizor makeRegularizorDirichletVectorized( WeightedCount fade_cutoff = 0);
+
 /** @} */
 
 /** @addtogroup Defaults
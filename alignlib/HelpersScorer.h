@@ -66,6 +66,20 @@ HScorer makeScorer(
 		const HAlignandum & col,
 		const HSubstitutionMatrix & matrix);
 
+/** return a new, uninitialized @ref Scorer that precomputes
+ * scores for profile/profile alignments.
+ * 
+ * Set this object as the scorer in a @ref Toolkit. The scores
+ * of all pairs of positions are then computed before the alignment.
+ * This is faster for dynamic programming over most of the matrix,
+ * but requires memory proportional to the product of the lengths
+ * of both profiles. Other alignandum types are scored with
+ * the default @ref Scorer objects.
+ * 
+ * @return a new @ref Scorer object.
+ */
+HScorer makeScorerProfileProfileCached();
+
 /** return a new, uninitialized @ref Scorer.
  * @return a new @ref Scorer object.
  * 
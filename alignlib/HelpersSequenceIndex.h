@@ -0,0 +1,85 @@
+/*
+  alignlib - a library for aligning protein sequences
+
+  $Id$
+
+  Copyright (C) 2026 Andreas Heger
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+*/
+
+
+#if HAVE_CONFIG_H
+#include <config.h>
+#endif
+
+#ifndef HELPERS_SEQUENCE_INDEX_H
+#define HELPERS_SEQUENCE_INDEX_H 1
+
+#include <iosfwd>
+#include <string>
+
+#include "alignlib_fwd.h"
+#include "SequenceIndex.h"
+
+namespace alignlib
+{
+
+/**
+ *
+ * @defgroup FactorySequenceIndex Factory functions for SequenceIndex objects.
+ * @{
+ */
+
+/** @brief make an index of tuples of size ktuple in a collection of sequences.
+ *
+ * @param sequences	@ref Alignandum objects to index.
+ * @param ktuple	tuple size.
+ *
+ * @return a new @ref SequenceIndex object.
+ */
+HSequenceIndex makeSequenceIndex(
+		const AlignandumVector & sequences,
+		int ktuple = 3 );
+
+/** @brief make an index of spaced seeds in a collection of sequences.
+ *
+ * @param sequences	@ref Alignandum objects to index.
+ * @param seed		seed pattern. Positions marked 1 need to match, positions
+ * 					marked 0 are ignored. The pattern needs to start and end with 1.
+ *
+ * @return a new @ref SequenceIndex object.
+ */
+HSequenceIndex makeSequenceIndex(
+		const AlignandumVector & sequences,
+		const std::string & seed );
+
+/** @brief load a @ref SequenceIndex object from stream.
+ *
+ * The index needs to have been built with the same alphabet as the
+ * @ref Encoder of the default toolkit.
+ *
+ * @param input	stream to read from.
+ * @return a new @ref SequenceIndex object.
+ */
+HSequenceIndex loadSequenceIndex( std::istream & input );
+
+/**
+ * @}
+ */
+
+}
+
+#endif	/* HELPERS_SEQUENCE_INDEX_H */
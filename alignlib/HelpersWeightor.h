@@ -43,9 +43,11 @@ namespace alignlib
 
 /** @brief make a new @ref Weightor object without weighting.
  * 
+ * @param num_threads number of threads used for counting. If 0, use one thread per processor.
+ *
  * @return a new @ref Weightor object.
  */
-HWeightor makeWeightor();
+HWeightor makeWeightor( unsigned int num_threads = 1 );
 
 /** @brief make a new @ref Weightor object using the Henikoff weighting scheme. 
  * 
@@ -55,10 +57,13 @@ HWeightor makeWeightor();
  * 
  * @param rescale_counts if true, weights are scaled to the number of sequences.
  * 			Otherwise, they will sum to one.
+ * @param num_threads number of threads used for counting. If 0, use one thread per processor.
  * 
  * @return a new @ref Weightor object.
  */
-HWeightor makeWeightorHenikoff( const bool rescale_counts = false );
+HWeightor makeWeightorHenikoff(
+		const bool rescale_counts = false,
+		unsigned int num_threads = 1 );
 
 /** @} */
 
@@ -33,11 +33,20 @@
 #include "HelpersEncoder.h"
 #include "HelpersToolkit.h"
 
+#ifdef HAVE_BOOST_THREAD
+#include <boost/thread/mutex.hpp>
+#endif
+
 using namespace std;
 
 namespace alignlib
 {
 
+#ifdef HAVE_BOOST_THREAD
+/** protects the cached indices, which are built by const methods */
+static boost::mutex kmer_index_mutex;
+#endif
+
 //--------------------------------------------------------------------------------------
 ImplAlignandum::ImplAlignandum() :
 	mFrom(NO_POS),
@@ -87,6 +96,7 @@ void ImplAlignandum::mask( const Position & from, const Position & to)
 void ImplAlignandum::mask( const Position & pos )
 {
 	mMasked[pos] = true;
+	clearCache();
 }
 
 //--------------------------------------------------------------------------------------
@@ -115,6 +125,8 @@ void ImplAlignandum::useSegment(Position from, Position to)
 		mTo = mLength;
 	else
 		mTo = std::min( to, mLength );
+
+	clearCache();
 }
 
 //--------------------------------------------------------------------------------------
@@ -136,6 +148,7 @@ void ImplAlignandum::resize( Position length)
 	mFrom = 0;
 	mTo = mLength = length;
 	mMasked.resize( length, false );
+	clearCache();
 }
 
 //--------------------------------------------------------------------------------------
@@ -154,6 +167,29 @@ bool ImplAlignandum::isPrepared() const
 void ImplAlignandum::setPrepared( bool flag ) const
 {
 	mIsPrepared = flag;
+	// objects are no longer prepared, if their contents have changed
+	if (!flag)
+		clearCache();
+}
+
+//--------------------------------------------------------------------------------------
+void ImplAlignandum::clearCache() const
+{
+#ifdef HAVE_BOOST_THREAD
+	boost::mutex::scoped_lock lock( kmer_index_mutex );
+#endif
+	mKmerIndex.reset();
+}
+
+//--------------------------------------------------------------------------------------
+HKmerIndex ImplAlignandum::getKmerIndex( int ktuple ) const
+{
+#ifdef HAVE_BOOST_THREAD
+	boost::mutex::scoped_lock lock( kmer_index_mutex );
+#endif
+	if (!mKmerIndex || mKmerIndex->getKtuple() != ktuple)
+		mKmerIndex = HKmerIndex( new KmerIndex( *this, ktuple ) );
+	return mKmerIndex;
 }
 
 //--------------------------------------------------------------------------------------
@@ -268,6 +304,7 @@ void ImplAlignandum::load( std::istream & input)
 	mMasked.clear();
 	mMasked.resize( mLength, false);
 
+	clearCache();
 }
 
 
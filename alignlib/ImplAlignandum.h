@@ -32,6 +32,7 @@
 #include <vector>
 #include "alignlib_fwd.h"
 #include "Alignandum.h"
+#include "KmerIndex.h"
 #include "ImplAlignlibBase.h"
 
 namespace alignlib
@@ -122,6 +123,14 @@ class ImplAlignandum : public virtual Alignandum, public ImplAlignlibBase
 	/** get the storage type */
 	virtual StorageType getStorageType( ) const;
 
+	/** return an index of the tuples of size ktuple in this object.
+	 *
+	 * The index is kept until the object is changed or an index
+	 * for a different tuple size is requested. The index can be
+	 * requested from several threads at the same time.
+	 */
+	virtual HKmerIndex getKmerIndex( int ktuple ) const;
+
  protected:
     /** the member functions below are protected, because they have to be only accessible for
 	derived classes. They should know, what they are doing. */
@@ -140,6 +149,12 @@ class ImplAlignandum : public virtual Alignandum, public ImplAlignlibBase
     /** set prepared flag */
     virtual void setPrepared( bool flag ) const;
 
+    /** discard data computed from the residues in this object.
+     *
+     * Call this method whenever residues are changed.
+     */
+    virtual void clearCache() const;
+
     /** save state of object into stream
      */
     virtual void __save( std::ostream & output, MagicNumberType type = MNNoType ) const;
@@ -163,8 +178,14 @@ class ImplAlignandum : public virtual Alignandum, public ImplAlignlibBase
     /** flag, whether object is ready for alignment */
     mutable bool mIsPrepared;
 
+    /** cached index of tuples */
+    mutable HKmerIndex mKmerIndex;
+
 };
 
+// handle definition for down-casting
+typedef boost::shared_ptr<ImplAlignandum>HImplAlignandum;
+
 
 }
 
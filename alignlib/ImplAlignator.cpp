@@ -41,6 +41,7 @@
 #include "HelpersScorer.h"
 
 #include "ImplAlignator.h"
+#include "AlignlibSimd.h"
 
 #include <math.h>
 
@@ -50,7 +51,7 @@ namespace alignlib
 {
 
   //----------------------------------------------------------------------------------------
-  ImplAlignator::ImplAlignator() : Alignator()
+  ImplAlignator::ImplAlignator() : Alignator(), mNumCells(0)
     {
 	  debug_func_cerr( 5 );
     }
@@ -62,7 +63,9 @@ namespace alignlib
     }
 
   ImplAlignator::ImplAlignator( const ImplAlignator & src ) : Alignator(src),
-  mIterator(src.mIterator)
+  ImplAlignlibBase(src),
+  mIterator(src.mIterator),
+  mNumCells(src.mNumCells)
   {
   }
 
@@ -87,7 +90,16 @@ namespace alignlib
           << *mIterator->row_begin() << "-" <<  *mIterator->row_end() << ":" << mIterator->row_size() << " col="
           << *mIterator->col_begin() << "-" <<  *mIterator->col_end() << ":" << mIterator->col_size() );
 
-      mScorer = getToolkit()->getScorer()->getNew( row, col );
+      // in a batch, the scorer set up for the query is re-used for
+      // all targets and only initialized for the new target.
+      if (mBatchQuery && row == mBatchQuery)
+        {
+          if (!mBatchScorer || !mBatchScorer->setCol( col ))
+            mBatchScorer = getToolkit()->getScorer()->getNew( row, col );
+          mScorer = mBatchScorer;
+        }
+      else
+        mScorer = getToolkit()->getScorer()->getNew( row, col );
 
       ali->clear();
     }
@@ -102,6 +114,109 @@ namespace alignlib
        */
       ali->setScore( round(ali->getScore()) );
 
+      mNumCells = mIterator ? mIterator->getNumCells() : 0;
+    }
+
+  //-------------------------------------------------------------------------------------------------------------------------------
+  void ImplAlignator::alignMany( HAlignment & ali,
+		  const HAlignandum & query,
+		  const AlignandumVector & targets,
+		  AlignatorCallback & callback )
+    {
+      debug_func_cerr(5);
+
+      query->prepare();
+
+      startBatch( query, targets );
+
+      for (size_t x = 0; x < targets.size(); ++x)
+        {
+          align( ali, query, targets[x] );
+          if (!callback( x, targets[x], ali ))
+            break;
+        }
+
+      finishBatch();
+    }
+
+  void ImplAlignator::startBatch( const HAlignandum & query,
+		  const AlignandumVector & targets )
+    {
+      debug_func_cerr(5);
+      mBatchQuery = query;
+      mBatchScorer.reset();
+    }
+
+  void ImplAlignator::finishBatch()
+    {
+      debug_func_cerr(5);
+      mBatchQuery.reset();
+      mBatchScorer.reset();
+    }
+
+  void ImplAlignator::trimWorkspace()
+    {
+      debug_func_cerr(5);
+    }
+
+  void ImplAlignator::resetStatistics()
+    {
+    }
+
+  void ImplAlignator::addStatistics( const ImplAlignator & other )
+    {
+    }
+
+  size_t ImplAlignator::getNumCells() const
+    {
+      return mNumCells;
+    }
+
+  //-------------------------------------------------------------------------------------------------------------------------------
+  void ImplAlignator::findResidues( const Residue * residues,
+		  Position from, Position to,
+		  const Residue * codes, int num_codes,
+		  std::vector<Position> & positions )
+    {
+      if (num_codes == 0)
+        return;
+
+      Position x = from;
+
+#ifdef ALIGNLIB_HAVE_SIMD
+      typedef SimdInt8 V;
+      const int lanes = V::LANES;
+
+      // at most eight codes are kept in registers
+      if (num_codes <= 8)
+        {
+          V::Vector v_codes[8];
+          for (int i = 0; i < num_codes; ++i)
+            v_codes[i] = V::set1( codes[i] );
+
+          for (; x + lanes <= to; x += lanes)
+            {
+              const V::Vector v = V::loadu( residues + x );
+              V::Vector mask = V::cmpeq( v, v_codes[0] );
+              for (int i = 1; i < num_codes; ++i)
+                mask = V::bitwiseOr( mask, V::cmpeq( v, v_codes[i] ) );
+
+              for (unsigned int bits = V::movemask( mask ); bits != 0; bits &= bits - 1)
+                positions.push_back( x + __builtin_ctz( bits ) );
+            }
+        }
+#endif
+
+      for (; x < to; ++x)
+        {
+          const Residue residue = residues[x];
+          for (int i = 0; i < num_codes; ++i)
+            if (residue == codes[i])
+              {
+                positions.push_back( x );
+                break;
+              }
+        }
     }
 
 } // namespace alignlib
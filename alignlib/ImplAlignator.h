@@ -28,6 +28,7 @@
 #ifndef IMPL_ALIGNATOR_H
 #define IMPL_ALIGNATOR_H 1
 
+#include <vector>
 #include "alignlib_fwd.h"
 #include "Alignator.h"
 #include "ImplAlignlibBase.h"
@@ -58,6 +59,50 @@ namespace alignlib
       /** copy constructor */
       ImplAlignator( const ImplAlignator & src);
 
+      /** align a query against many targets.
+       *
+       * The default implementation calls @ref align for each target
+       * between @ref startBatch and @ref finishBatch.
+       */
+      virtual void alignMany( HAlignment & dest,
+    		  const HAlignandum & query,
+    		  const AlignandumVector & targets,
+    		  AlignatorCallback & callback );
+
+      /** prepare for aligning query against targets. Overload, but call this function in subclasses!
+       *
+       * Subclasses can pre-compute data for the query and keep buffers
+       * between alignments until @ref finishBatch is called.
+       */
+      virtual void startBatch( const HAlignandum & query,
+    		  const AlignandumVector & targets );
+
+      /** release data kept between alignments of a batch. Overload, but call this function in subclasses! */
+      virtual void finishBatch();
+
+      /** release work space. Overload, but call this function in subclasses! */
+      virtual void trimWorkspace();
+
+      /** reset statistics collected during alignments. The default
+       * implementation does nothing.
+       */
+      virtual void resetStatistics();
+
+      /** add statistics collected by other to this object.
+       *
+       * This is used to collect the statistics of copies of this
+       * object, for example those aligning in separate threads.
+       * The default implementation does nothing.
+       */
+      virtual void addStatistics( const ImplAlignator & other );
+
+      /** return the number of cells computed in the last alignment.
+       *
+       * This is the number of cells of the iterator used in the
+       * alignment, see @ref Iterator2D::getNumCells.
+       */
+      virtual size_t getNumCells() const;
+
     protected:
 
         /** perform initialisation before alignment. Overload, but call this function in subclasses! */
@@ -68,6 +113,41 @@ namespace alignlib
         virtual void cleanUp( HAlignment & ali,
       		  const HAlignandum & row, const HAlignandum & col );
 
+        /** make sure that buffer holds at least size elements.
+         *
+         * The buffer is only re-allocated if it needs to grow, its contents are not preserved.
+         */
+        template< class T >
+        static void reserveBuffer( T *& buffer, size_t & capacity, size_t size )
+        {
+      	  if (buffer != NULL && size <= capacity)
+      		  return;
+      	  if (buffer != NULL)
+      		  delete [] buffer;
+      	  buffer = new T[ size > 0 ? size : 1 ];
+      	  capacity = size;
+        }
+
+        /** append positions in the range from to to, at which residues has one of the codes.
+         *
+         * residues is indexed by position. Positions are appended in increasing order.
+         * Residues are compared in vectors of bytes if SIMD instructions are available.
+         */
+        static void findResidues( const Residue * residues,
+        		Position from, Position to,
+        		const Residue * codes, int num_codes,
+        		std::vector<Position> & positions );
+
+        /** release a buffer allocated by @ref reserveBuffer */
+        template< class T >
+        static void releaseBuffer( T *& buffer, size_t & capacity )
+        {
+      	  if (buffer != NULL)
+      		  delete [] buffer;
+      	  buffer = NULL;
+      	  capacity = 0;
+        }
+
     protected:
       /** object for iteration over sequences */
       HIterator2D mIterator;
@@ -78,6 +158,15 @@ namespace alignlib
       /** length of row */
       int mRowLength;
 
+      /** number of cells computed in the last alignment */
+      size_t mNumCells;
+
+      /** query of the current batch, empty outside of @ref alignMany */
+      HAlignandum mBatchQuery;
+
+      /** scorer for the query of the current batch */
+      HScorer mBatchScorer;
+
     };
 
 }
@@ -24,6 +24,7 @@
 #include <iostream>
 #include <iomanip>
 #include <limits>
+#include <algorithm>
 
 #include "alignlib_fwd.h"
 #include "alignlib_interfaces.h"
@@ -70,6 +71,8 @@ ImplAlignatorDP::ImplAlignatorDP() :
 	ImplAlignator(),
 	mCC(NULL),
 	mDD(NULL),
+	mCCBuffer(NULL), mDDBuffer(NULL),
+	mCCCapacity(0), mDDCapacity(0),
 	mAlignmentType(ALIGNMENT_LOCAL),
 	mPenalizeRowLeft( false ),
 	mPenalizeRowRight( false ),
@@ -87,6 +90,8 @@ ImplAlignatorDP::ImplAlignatorDP( AlignmentType alignment_type,
 			ImplAlignator(),
 			mCC(NULL),
 			mDD(NULL),
+			mCCBuffer(NULL), mDDBuffer(NULL),
+			mCCCapacity(0), mDDCapacity(0),
 			mAlignmentType(alignment_type),
 			mPenalizeRowLeft( penalize_row_left ),
 			mPenalizeRowRight( penalize_row_right ),
@@ -116,6 +121,8 @@ ImplAlignatorDP::ImplAlignatorDP( const ImplAlignatorDP & src ) :
 
 	mCC = NULL;
 	mDD = NULL;
+	mCCBuffer = mDDBuffer = NULL;
+	mCCCapacity = mDDCapacity = 0;
 	}
 
 //----------------------------------------------------------------------------------------------------------------------------------------
@@ -124,6 +131,8 @@ ImplAlignatorDP::~ImplAlignatorDP()
 {
 	debug_func_cerr(5);
 
+	releaseBuffer( mCCBuffer, mCCCapacity );
+	releaseBuffer( mDDBuffer, mDDCapacity );
 }
 
 //----------------------------------------------------------------------------------------------------------------------------------------
@@ -164,6 +173,31 @@ void ImplAlignatorDP::align(
 
 }
 
+//------------------------------------------------------------------------------------------
+void ImplAlignatorDP::startBatch( const HAlignandum & query,
+		const AlignandumVector & targets )
+{
+	debug_func_cerr(5);
+	ImplAlignator::startBatch( query, targets );
+
+	Position max_length = 0;
+	for (size_t x = 0; x < targets.size(); ++x)
+		max_length = std::max( max_length, targets[x]->getLength() );
+
+	reserveBuffer( mCCBuffer, mCCCapacity, max_length + 1 );
+	reserveBuffer( mDDBuffer, mDDCapacity, max_length + 1 );
+}
+
+//------------------------------------------------------------------------------------------
+void ImplAlignatorDP::trimWorkspace()
+{
+	debug_func_cerr(5);
+	ImplAlignator::trimWorkspace();
+
+	releaseBuffer( mCCBuffer, mCCCapacity );
+	releaseBuffer( mDDBuffer, mDDCapacity );
+}
+
 //------------------------------------------------------------------------------------------
 void ImplAlignatorDP::startUp(HAlignment & ali,
 		const HAlignandum & row,
@@ -178,8 +212,10 @@ void ImplAlignatorDP::startUp(HAlignment & ali,
 	//----------------------------------------------------------------------------------------
 	// create vector for affine gap penalties
 	// add one element for -1 element
-	mCC    = new Score[mColLength + 1];
-	mDD    = new Score[mColLength + 1];
+	reserveBuffer( mCCBuffer, mCCCapacity, mColLength + 1 );
+	reserveBuffer( mDDBuffer, mDDCapacity, mColLength + 1 );
+	mCC    = mCCBuffer;
+	mDD    = mDDBuffer;
 
 	for (Position x = 0; x < mColLength +1; ++x)
 	{
@@ -202,18 +238,9 @@ void ImplAlignatorDP::cleanUp(HAlignment & ali,
 {
     debug_func_cerr(5);
 
-	if (mCC != NULL)
-	{
-		mCC += (mIterator->col_front() - 1);
-		delete [] mCC;
-		mCC = NULL;
-	}
-	if (mDD != NULL)
-	{
-		mDD += (mIterator->col_front() - 1);
-		delete [] mDD;
-		mDD = NULL;
-	}
+	// buffers are kept for the next alignment
+	mCC = NULL;
+	mDD = NULL;
 
 	ImplAlignator::cleanUp(ali, row, col );
 
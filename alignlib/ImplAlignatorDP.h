@@ -97,6 +97,12 @@ class ImplAlignatorDP : public ImplAlignator
     /** method for aligning two arbitrary objects */
     virtual void align( HAlignment & , const HAlignandum & , const HAlignandum &);
 
+    /** allocate buffers for the longest target */
+    virtual void startBatch( const HAlignandum & query, const AlignandumVector & targets );
+
+    /** release buffers */
+    virtual void trimWorkspace();
+
     /* member access functions--------------------------------------------------------------- */
 
     /** set gap opening penalty for row */
@@ -147,6 +153,18 @@ class ImplAlignatorDP : public ImplAlignator
     /** internal helper array for the calculation of affine gap penalties */
     Score *mDD;
 
+    /** memory for mCC, kept between alignments */
+    Score *mCCBuffer;
+
+    /** memory for mDD, kept between alignments */
+    Score *mDDBuffer;
+
+    /** allocated size of mCCBuffer */
+    size_t mCCCapacity;
+
+    /** allocated size of mDDBuffer */
+    size_t mDDCapacity;
+
     // pointers to memory location of encoded sequences/profiles/...
 
     /** alignment type */
@@ -23,6 +23,9 @@
 
 #include <iostream>
 #include <iomanip>
+#include <algorithm>
+#include <cmath>
+#include <limits>
 #include "alignlib_fwd.h"
 #include "alignlib_interfaces.h"
 #include "alignlib_fwd.h"
@@ -46,6 +49,7 @@
 #include "ImplSequence.h"
 #include "ImplProfile.h"
 #include "Iterator2D.h"
+#include "ImplIterator2DXDrop.h"
 #include "Scorer.h"
 
 using namespace std;
@@ -64,6 +68,18 @@ HAlignator makeAlignatorDPFull( AlignmentType alignment_type,
 			penalize_row_left, penalize_row_right, penalize_col_left, penalize_col_right) );
 		}
 
+HAlignator makeAlignatorDPFullLowMemory( AlignmentType alignment_type,
+		Score gop, Score gep,
+		bool penalize_row_left,
+		bool penalize_row_right,
+		bool penalize_col_left,
+		bool penalize_col_right)
+		{
+	return HAlignator( new ImplAlignatorDPFull( alignment_type, gop, gep, gop, gep,
+			penalize_row_left, penalize_row_right, penalize_col_left, penalize_col_right,
+			true ) );
+		}
+
 /* How to write a fast algorithm:
      My design objective here was to not duplicate the algorithmic code without penalizing too much
      for function indirection. It the way I do it below, there is one indirection for every call to
@@ -84,20 +100,27 @@ HAlignator makeAlignatorDPFull( AlignmentType alignment_type,
 //----------------------------------------------------------------------------------------------
 ImplAlignatorDPFull::ImplAlignatorDPFull() :
 	ImplAlignatorDP(), mTraceMatrix(NULL), mTraceRowStarts(NULL),
+	mTraceCapacity(0), mTraceRowStartsBuffer(NULL), mTraceRowStartsCapacity(0),
 	mRowFrom(NO_POS), mRowTo( NO_POS),
-	mRowLast(NO_POS), mColLast(NO_POS)
+	mRowLast(NO_POS), mColLast(NO_POS),
+	mLowMemory(false), mTraceBlockSize(0),
+	mCheckpoints(NULL), mCheckpointsCapacity(0)
 	{}
 
 ImplAlignatorDPFull::ImplAlignatorDPFull( AlignmentType alignment_type,
 		Score row_gop, Score row_gep,
 		Score col_gop, Score col_gep,
 		bool penalize_row_left, bool penalize_row_right,
-		bool penalize_col_left, bool penalize_col_right) :
+		bool penalize_col_left, bool penalize_col_right,
+		bool low_memory ) :
 			ImplAlignatorDP( alignment_type, row_gop, row_gep, col_gop, col_gep,
 					penalize_row_left, penalize_row_right, penalize_col_left, penalize_col_right ),
 					mTraceMatrix(NULL), mTraceRowStarts(NULL),
+					mTraceCapacity(0), mTraceRowStartsBuffer(NULL), mTraceRowStartsCapacity(0),
 					mRowFrom(NO_POS), mRowTo( NO_POS),
-					mRowLast(NO_POS), mColLast(NO_POS)
+					mRowLast(NO_POS), mColLast(NO_POS),
+					mLowMemory(low_memory), mTraceBlockSize(0),
+					mCheckpoints(NULL), mCheckpointsCapacity(0)
 					{
 					}
 
@@ -109,17 +132,28 @@ ImplAlignatorDPFull::ImplAlignatorDPFull( const ImplAlignatorDPFull & src ) :
 
 	mTraceMatrix = NULL;
 	mTraceRowStarts = NULL;
+	mTraceCapacity = 0;
+	mTraceRowStartsBuffer = NULL;
+	mTraceRowStartsCapacity = 0;
 	mRowFrom = NO_POS;
 	mRowTo = NO_POS;
 	mRowLast = NO_POS;
 	mColLast = NO_POS;
 	mLevelLast = TBL_MATCH;
+	mLowMemory = src.mLowMemory;
+	mTraceBlockSize = 0;
+	mCheckpoints = NULL;
+	mCheckpointsCapacity = 0;
 	}
 
 //------------------------------------------------------------------------------------------------
 ImplAlignatorDPFull::~ImplAlignatorDPFull()
 {
 	debug_func_cerr(5);
+
+	releaseBuffer( mTraceMatrix, mTraceCapacity );
+	releaseBuffer( mTraceRowStartsBuffer, mTraceRowStartsCapacity );
+	releaseBuffer( mCheckpoints, mCheckpointsCapacity );
 }
 
 IMPLEMENT_CLONE( HAlignator, ImplAlignatorDPFull);
@@ -145,20 +179,57 @@ void ImplAlignatorDPFull::startUp( HAlignment & ali,
 	// - in other words: indexing for columns and rows starts at 0 in the trace matrix, but there is
 	//   a -1 element for each column
 	// the matrix is allocated in triplicate for affine gap penalties
+	Iterator2D::const_iterator rit(mIterator->row_begin()), rend(mIterator->row_end());
+	mRowFrom = *rit;
+	mRowTo = *rend;
+
+	mTraceFrom = mComputeFrom = mRowFrom;
+	mTraceTo = mComputeTo = mRowTo;
+	mRecompute = false;
+
+	mXDropIterator = boost::dynamic_pointer_cast< ImplIterator2DXDrop, Iterator2D >( mIterator );
+
+	if (mLowMemory)
+	{
+		//---------------------------------------------
+		// setup trace matrix for blocks of rows. Each block
+		// has its own -1 row.
+		mTraceBlockSize = std::max( 1, (Position)ceil( sqrt( (double)mIterator->row_size() ) ) );
+		Position nblocks = (mIterator->row_size() + mTraceBlockSize - 1) / mTraceBlockSize;
+
+		debug_cerr( 5, "allocating " << nblocks << " checkpoints for blocks of " << mTraceBlockSize << " rows." );
+
+		reserveBuffer( mCheckpoints, mCheckpointsCapacity, nblocks * 2 * (mColLength + 1) );
+		reserveBuffer( mTraceRowStartsBuffer, mTraceRowStartsCapacity, mTraceBlockSize + 1 );
+		mTraceRowStarts = mTraceRowStartsBuffer + 1;
+		mTraceRowStarts[-1] = 0;
+
+		// get size of largest block
+		TraceIndex max_size = 1 + mIterator->col_size();
+		for (Position block_from = mRowFrom; block_from < mRowTo; block_from += mTraceBlockSize)
+		{
+			TraceIndex matrix_size = 1 + mIterator->col_size();
+			for (Position row = block_from; row < std::min( block_from + mTraceBlockSize, mRowTo); ++row)
+				matrix_size += 1 + mIterator->col_size( row );
+			max_size = std::max( max_size, matrix_size );
+		}
+
+		mMatrixSize = max_size;
+		reserveBuffer( mTraceMatrix, mTraceCapacity, 3 * mMatrixSize );
+		setupTraceBlock( mRowFrom );
+		return;
+	}
+
 	debug_cerr( 5, "allocating start positions for " << mIterator->row_size() << " rows." );
 
-	mTraceRowStarts = new TraceIndex[mIterator->row_size() + 1];
+	reserveBuffer( mTraceRowStartsBuffer, mTraceRowStartsCapacity, mIterator->row_size() + 1 );
 	// shift index one up, so that there is a -1 element
-	++mTraceRowStarts;
+	mTraceRowStarts = mTraceRowStartsBuffer + 1;
 	mTraceRowStarts[-1] = 0;
 
 	// counter for the size of the traceback matrix
 	TraceIndex matrix_size =  1 + mIterator->col_size();
 
-	Iterator2D::const_iterator rit(mIterator->row_begin()), rend(mIterator->row_end());
-	mRowFrom = *rit;
-	mRowTo = *rend;
-
 	for (unsigned row = 0; rit != rend; ++rit, ++row)
 	{
 		mTraceRowStarts[row] = matrix_size;
@@ -168,7 +239,7 @@ void ImplAlignatorDPFull::startUp( HAlignment & ali,
 
 	mMatrixSize = matrix_size;
 	debug_cerr( 5, "allocating trace matrix for " << matrix_size << " elements. Total size = " << (sizeof( TraceEntry ) * matrix_size * 3) );
-	mTraceMatrix = new TraceEntry[ 3 * matrix_size];
+	reserveBuffer( mTraceMatrix, mTraceCapacity, 3 * matrix_size );
 	TraceIndex i = 0;
 	for (; i < 1 * matrix_size; i++)
 		mTraceMatrix[i] = TB_STOP;
@@ -183,12 +254,98 @@ void ImplAlignatorDPFull::startUp( HAlignment & ali,
 void ImplAlignatorDPFull::cleanUp(HAlignment & ali,
 		const HAlignandum & row, const HAlignandum & col )
 {
-	if (mTraceMatrix != NULL) { delete [] mTraceMatrix; mTraceMatrix = NULL; }
-	if (mTraceRowStarts != NULL) { --mTraceRowStarts; delete [] mTraceRowStarts; mTraceRowStarts = NULL; }
+	// buffers are kept for the next alignment
+	mTraceRowStarts = NULL;
 
 	ImplAlignatorDP::cleanUp(ali, row, col );
 }
 
+//--------------------------------------------------------------------------------------------------------------
+void ImplAlignatorDPFull::trimWorkspace()
+{
+	debug_func_cerr(5);
+
+	releaseBuffer( mTraceMatrix, mTraceCapacity );
+	releaseBuffer( mTraceRowStartsBuffer, mTraceRowStartsCapacity );
+	releaseBuffer( mCheckpoints, mCheckpointsCapacity );
+	std::vector<ResiduePair>().swap( mTracePairs );
+
+	ImplAlignatorDP::trimWorkspace();
+}
+
+//--------------------------------------------------------------------------------------------------------------
+void ImplAlignatorDPFull::setupTraceBlock( Position block_from )
+{
+	debug_func_cerr(5);
+
+	mTraceFrom = block_from;
+	mTraceTo = std::min( block_from + mTraceBlockSize, mRowTo );
+
+	TraceIndex matrix_size = 1 + mIterator->col_size();
+	for (Position row = mTraceFrom; row < mTraceTo; ++row)
+	{
+		mTraceRowStarts[row - mTraceFrom] = matrix_size;
+		matrix_size += 1 + mIterator->col_size( row );
+	}
+	assert( matrix_size <= (TraceIndex)mMatrixSize );
+
+	std::fill( mTraceMatrix, mTraceMatrix + 3 * mMatrixSize, (TraceEntry)TB_STOP );
+}
+
+//--------------------------------------------------------------------------------------------------------------
+void ImplAlignatorDPFull::checkpoint( Position row )
+{
+	Position block = (row - mRowFrom) / mTraceBlockSize;
+	Score * cc = mCheckpoints + block * 2 * (mColLength + 1);
+	Score * dd = cc + mColLength + 1;
+	Position offset = mIterator->col_front() - 1;
+
+	if (mRecompute)
+	{
+		debug_cerr( 5, "restoring checkpoint for row " << row );
+		std::copy( cc, cc + mColLength + 1, mCC + offset );
+		std::copy( dd, dd + mColLength + 1, mDD + offset );
+	}
+	else
+	{
+		debug_cerr( 5, "saving checkpoint for row " << row );
+		std::copy( mCC + offset, mCC + offset + mColLength + 1, cc );
+		std::copy( mDD + offset, mDD + offset + mColLength + 1, dd );
+		setupTraceBlock( row );
+	}
+}
+
+//--------------------------------------------------------------------------------------------------------------
+void ImplAlignatorDPFull::computeTraceBlock( HAlignment & ali,
+		const HAlignandum & prow, const HAlignandum & pcol,
+		Position row )
+{
+	debug_func_cerr(5);
+
+	Position block_from = mRowFrom + ((row - mRowFrom) / mTraceBlockSize) * mTraceBlockSize;
+
+	debug_cerr( 5, "recomputing trace matrix for rows " << block_from << "-" << block_from + mTraceBlockSize );
+
+	setupTraceBlock( block_from );
+
+	mComputeFrom = mTraceFrom;
+	mComputeTo = mTraceTo;
+	mRecompute = true;
+
+	// the maximum score does not change, but keep the end point
+	Score score = mScore;
+	Position row_last = mRowLast;
+	Position col_last = mColLast;
+	TraceBackLevel level_last = mLevelLast;
+
+	computeMatrix( ali, prow, pcol );
+
+	mScore = score;
+	mRowLast = row_last;
+	mColLast = col_last;
+	mLevelLast = level_last;
+}
+
 //-------------------------------------< BackTrace >----------------------------------------------------------------------
 
 // wrapping around for col but not for row, because otherwise there could be an infinite loop.
@@ -249,9 +406,8 @@ void ImplAlignatorDPFull::traceBack( HAlignment & result,
 		return;
 
 #ifdef DEBUG
+	if (!mLowMemory)
 	{
-
-
 		printTraceMatrix( TBL_MATCH );
 		printTraceMatrix( TBL_INSERTION );
 		printTraceMatrix( TBL_DELETION );
@@ -269,7 +425,9 @@ void ImplAlignatorDPFull::traceBack( HAlignment & result,
 	Position row_from = mIterator->row_front();
 
 	TraceBackLevel level = mLevelLast;
-	t = mTraceMatrix[getTraceIndex(level,row,col)];
+	t = getTraceEntry( level, row, col, result, prow, pcol );
+
+	mTracePairs.clear();
 
 	while ( t != TB_STOP )
 	{
@@ -319,7 +477,7 @@ void ImplAlignatorDPFull::traceBack( HAlignment & result,
 			break;
 		case TB_MATCH :
 			level = TBL_MATCH;
-			result->addPair( ResiduePair( row, col, mScorer->getScore( row, col)));
+			mTracePairs.push_back( ResiduePair( row, col, mScorer->getScore( row, col)));
 			--row;
 			--col;
 			break;
@@ -332,8 +490,14 @@ void ImplAlignatorDPFull::traceBack( HAlignment & result,
 			break;
 		}
 		if (row < row_from) break;
-		t = mTraceMatrix[getTraceIndex(level,row,col)];
+		t = getTraceEntry( level, row, col, result, prow, pcol );
 	}
+
+	// pairs have been collected from the last row backwards
+	std::reverse( mTracePairs.begin(), mTracePairs.end() );
+	if (!mTracePairs.empty())
+		result->addPairs( &mTracePairs[0], mTracePairs.size(), true );
+
 	result->setScore ( mScore );
 }
 
@@ -364,6 +528,17 @@ void ImplAlignatorDPFull::performAlignment(
       e/mDD: last op was gap
 	 */
 
+	computeMatrix( ali, prow, pcol );
+
+	traceBack(ali, prow, pcol );
+}
+
+//-----------------------------------------------------------------------------------
+void ImplAlignatorDPFull::computeMatrix(
+		HAlignment & ali,
+		const HAlignandum & prow,
+		const HAlignandum & pcol )
+{
 	switch (mAlignmentType)
 	{
 	case ALIGNMENT_LOCAL:
@@ -379,8 +554,6 @@ void ImplAlignatorDPFull::performAlignment(
 			performAlignmentLocal( ali, prow, pcol );
 		break;
 	}
-
-	traceBack(ali, prow, pcol );
 }
 
 //-----------------------------------------------------------------------------------
@@ -488,6 +661,7 @@ void ImplAlignatorDPFull::performAlignmentGlobal(
 	for (; rit != rend; ++rit)
 	{
 		Position row = *rit;
+		if (!startRow( row )) continue;
 		Position row_length = mIterator->row_size();
 		Position row_from   = mIterator->row_front( row );
 		Position col_length = mIterator->col_size( row );
@@ -672,6 +846,7 @@ void ImplAlignatorDPFull::performAlignmentWrapped( HAlignment & ali,
 	for (; rit != rend; ++rit)
 	{
 		Position row = *rit;
+		if (!startRow( row )) continue;
 		Position row_length = mIterator->row_size();
 		Position row_from   = mIterator->row_front( row );
 		Position col_length = mIterator->col_size( row );
@@ -842,15 +1017,28 @@ void ImplAlignatorDPFull::performAlignmentLocal(
 			<< *mIterator->row_begin() << "-" <<  *mIterator->row_end() << ":" << mIterator->row_size() << " col="
 			<< *mIterator->col_begin() << "-" <<  *mIterator->col_end() << ":" << mIterator->col_size() );
 
+	// X-drop banding: columns of a row are set while computing the matrix. Cells
+	// that have not been computed in the previous row are treated as minus infinity.
+	// When recomputing a block, the columns have already been set.
+	const bool xdrop = mXDropIterator && !mRecompute;
+	const Score xdrop_threshold = mXDropIterator ? mXDropIterator->getXDrop() : 0;
+	const Score dead = -std::numeric_limits<Score>::max() / 4;
+	Position live_limit = mIterator->col_back();
+
 	for (; rit != rend; ++rit)
 	{
 		Position row = *rit;
+		if (!startRow( row )) continue;
 		Position row_length = mIterator->row_size();
 		Position row_from   = mIterator->row_front( row );
 		Position col_length = mIterator->col_size( row );
 
 		Iterator2D::const_iterator cit(mIterator->col_begin(row)), cend(mIterator->col_end(row));
+		if (mXDropIterator && cit == cend) continue;
 		Position col_from = *cit;
+		Position col_to = mIterator->col_back( row );
+		Position live_from = NO_POS;
+		Position live_to = NO_POS;
 
 		s = mCC[col_from - 1];
 		mCC[col_from - 1] = c = 0;
@@ -941,6 +1129,46 @@ void ImplAlignatorDPFull::performAlignmentLocal(
 				mColLast = col;
 				mLevelLast = level;
 			}
+
+			if (xdrop)
+			{
+				if (c >= mScore - xdrop_threshold)
+				{
+					if (live_from == NO_POS) live_from = col;
+					live_to = col;
+				}
+				else if (col >= live_limit)
+				{
+					// no cell to the right can be within xdrop
+					col_to = col;
+					break;
+				}
+			}
+		}
+
+		if (mXDropIterator)
+		{
+			// set the cells beyond the end of this row, that have been computed in the
+			// previous row, to minus infinity.
+			Position previous_to = (row == mRowFrom) ? mIterator->col_back() : mIterator->col_back( row - 1 );
+			for (Position col = col_to + 1; col <= previous_to; ++col)
+			{
+				mCC[col] = dead;
+				mDD[col] = dead;
+			}
+		}
+
+		if (xdrop)
+		{
+			mXDropIterator->setColRange( row, col_from, col_to );
+			if (live_from == NO_POS)
+			{
+				debug_cerr( 5, "X-drop: no cells left after row " << row );
+				mXDropIterator->clearRows( row + 1 );
+				break;
+			}
+			mXDropIterator->setColRange( row + 1, live_from, mIterator->col_back() );
+			live_limit = live_to + 1;
 		}
 	}
 }
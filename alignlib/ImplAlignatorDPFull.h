@@ -27,6 +27,7 @@
 #ifndef IMPL_ALIGNATOR_DP_FULL_H
 #define IMPL_ALIGNATOR_DP_FULL_H 1
 
+#include <vector>
 #include "alignlib_fwd.h"
 #include "ImplAlignatorDP.h"
 #include "Iterator2D.h"
@@ -35,6 +36,8 @@
 namespace alignlib
 {
 
+	class ImplIterator2DXDrop;
+
     /* re: Global functions and pointers for the fast determination of match score.
 
       I don't know how to use member functions as function pointers. After all, this is what
@@ -61,6 +64,14 @@ namespace alignlib
 
     This class implements the back-tracking algorithm used by several of its children.
 
+    If low_memory is set, the trace matrix is not kept for all rows. Instead, the
+    values of the affine gap arrays are saved at regularly spaced rows (checkpoints)
+    during the forward pass. During the trace back, the trace for a block of rows
+    is recomputed from the checkpoint preceeding it. Blocks are sqrt(rows) in size,
+    so that memory usage is O(sqrt(rows) * cols) instead of O(rows * cols). As the
+    same recurrences are used, the alignments are identical to the ones obtained
+    with the full trace matrix.
+
     @author Andreas Heger
     @version $Id: ImplAlignatorDPFull.h,v 1.1 2005/02/24 11:08:24 aheger Exp $
 */
@@ -103,7 +114,8 @@ class ImplAlignatorDPFull : public ImplAlignatorDP
 			 Score row_gop, Score row_gep,
 			 Score col_gop = 0, Score col_gep = 0,
 			 bool penalize_row_left = false, bool penalize_row_right = false,
-			 bool penalize_col_left = false, bool penzlize_col_right = false);
+			 bool penalize_col_left = false, bool penzlize_col_right = false,
+			 bool low_memory = false );
 
     /** copy constructor */
     ImplAlignatorDPFull( const ImplAlignatorDPFull & );
@@ -111,6 +123,9 @@ class ImplAlignatorDPFull : public ImplAlignatorDP
     /** destructor */
     virtual ~ImplAlignatorDPFull();
 
+    /** release buffers */
+    virtual void trimWorkspace();
+
     DEFINE_CLONE( HAlignator );
 
     /* operators------------------------------------------------------------------------------ */
@@ -150,24 +165,68 @@ class ImplAlignatorDPFull : public ImplAlignatorDP
 									const HAlignandum & row,
 	    							const HAlignandum & col );
 
+	    /** fill the dynamic programming matrix according to the alignment type */
+	    virtual void computeMatrix(HAlignment & dest,
+	    							const HAlignandum & row,
+	    							const HAlignandum & col );
+
+	    /** setup the trace matrix for the block of rows starting at row */
+	    void setupTraceBlock( Position row );
+
+	    /** recompute the trace matrix for the block of rows containing row */
+	    void computeTraceBlock( HAlignment & dest,
+	    		const HAlignandum & prow, const HAlignandum & pcol,
+	    		Position row );
+
+	    /** called at the start of each row in the dynamic programming matrix.
+	     *
+	     * Saves or restores checkpoints in low memory mode.
+	     *
+	     * @return false, if the row is not to be computed.
+	     */
+	    inline bool startRow( Position row )
+	    {
+	    	if (!mLowMemory) return true;
+	    	if (row < mComputeFrom || row >= mComputeTo) return false;
+	    	if ((row - mRowFrom) % mTraceBlockSize == 0)
+	    		checkpoint( row );
+	    	return true;
+	    }
+
+	    /** save (forward pass) or restore (recomputation) the checkpoint at row */
+	    void checkpoint( Position row );
 
 
     /** traces back through trace matrix and put in the alignment in Alignment-object */
     virtual void traceBack( HAlignment & dest,
     		const HAlignandum & row, const HAlignandum & col );
 
+    /** return entry in trace matrix. In low memory mode, the
+     * trace matrix is recomputed if necessary.
+     */
+    inline TraceEntry getTraceEntry( TraceBackLevel level, Position row, Position col,
+    		HAlignment & dest,
+    		const HAlignandum & prow, const HAlignandum & pcol )
+    {
+    	if (mLowMemory && (row >= mTraceTo ||
+    			(mTraceFrom > mRowFrom &&
+    			(row < mTraceFrom - 1 || (row == mTraceFrom - 1 && col >= mIterator->col_front(row))))))
+    		computeTraceBlock( dest, prow, pcol, row );
+    	return mTraceMatrix[getTraceIndex(level,row,col)];
+    }
+
     /** return index for given row and length.
      * */
     inline int getTraceIndex( TraceBackLevel level, Position row, Position col ) const
       {
-    	assert( row >= mRowFrom - 1);
-    	assert( row < mRowTo );
+    	assert( row >= mTraceFrom - 1);
+    	assert( row < mTraceTo );
     	// col can be before element 0 in wrap-around alignments
     	assert( col >= mIterator->col_front(row) - 1);
     	assert( col <= mIterator->col_back(row) );
     	// the first element in each column is the carry over value from the previous
     	// column, thus the +1 modifier.
-    	int index = mTraceRowStarts[row-mRowFrom] + col - mIterator->col_front(row) + 1;
+    	int index = mTraceRowStarts[row-mTraceFrom] + col - mIterator->col_front(row) + 1;
 #ifdef DEBUG
     	if (index < 0 || index >= mMatrixSize )
     		std::cout << "mRowFrom=" << mRowFrom << " row=" << row << " col=" << col << std::endl;
@@ -203,6 +262,15 @@ class ImplAlignatorDPFull : public ImplAlignatorDP
     /** list of start position of trace for a given row */
     TraceIndex * mTraceRowStarts;
 
+    /** allocated size of mTraceMatrix */
+    size_t mTraceCapacity;
+
+    /** memory for mTraceRowStarts */
+    TraceIndex * mTraceRowStartsBuffer;
+
+    /** allocated size of mTraceRowStartsBuffer */
+    size_t mTraceRowStartsCapacity;
+
     /** first row */
     Position mRowFrom;
 
@@ -218,6 +286,39 @@ class ImplAlignatorDPFull : public ImplAlignatorDP
     /** level on which trace ended */
     TraceBackLevel mLevelLast;
 
+    /** keep only a block of the trace matrix */
+    bool mLowMemory;
+
+    /** number of rows in a block of the trace matrix */
+    Position mTraceBlockSize;
+
+    /** first row in trace matrix */
+    Position mTraceFrom;
+
+    /** last row + 1 in trace matrix */
+    Position mTraceTo;
+
+    /** first row to compute */
+    Position mComputeFrom;
+
+    /** last row + 1 to compute */
+    Position mComputeTo;
+
+    /** true, if a block of the trace matrix is recomputed */
+    bool mRecompute;
+
+    /** saved affine gap arrays for each block */
+    Score * mCheckpoints;
+
+    /** allocated size of mCheckpoints */
+    size_t mCheckpointsCapacity;
+
+    /** aligned pairs collected during traceback */
+    std::vector<ResiduePair> mTracePairs;
+
+    /** adaptive iterator, if X-drop banding is used */
+    boost::shared_ptr<ImplIterator2DXDrop> mXDropIterator;
+
     /** print traceback matrix (for debugging purposes)
      */
 	void printTraceMatrix( TraceBackLevel level ) const;
@@ -0,0 +1,806 @@
+/*
+  alignlib - a library for aligning protein sequences
+
+  $Id$
+
+  Copyright (C) 2026 Andreas Heger
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+ */
+
+
+#include <iostream>
+#include <iomanip>
+#include <cassert>
+#include <cmath>
+#include <algorithm>
+#include "alignlib_fwd.h"
+#include "alignlib_interfaces.h"
+#include "AlignlibDebug.h"
+#include "AlignlibException.h"
+#include "AlignlibSimd.h"
+
+#include "Alignment.h"
+#include "HelpersAlignment.h"
+
+#include "Alignandum.h"
+#include "ImplSequence.h"
+#include "ImplIterator2DFull.h"
+#include "ImplScorerSequenceSequence.h"
+#include "ImplAlignatorDPScoreOnly.h"
+#include "Alignator.h"
+#include "Iterator2D.h"
+#include "Scorer.h"
+
+using namespace std;
+
+namespace alignlib
+{
+
+HAlignator makeAlignatorDPScoreOnly( AlignmentType alignment_type,
+		Score gop, Score gep,
+		bool penalize_row_left,
+		bool penalize_row_right,
+		bool penalize_col_left,
+		bool penalize_col_right)
+{
+	return HAlignator( new ImplAlignatorDPScoreOnly( alignment_type, gop, gep, gop, gep,
+			penalize_row_left, penalize_row_right, penalize_col_left, penalize_col_right) );
+}
+
+
+#ifdef ALIGNLIB_HAVE_SIMD
+
+/** local alignment of a query against a group of targets.
+
+	Each target occupies one lane, the query is processed row by row.
+	Penalties are positive numbers that are subtracted. Open penalties
+	include the penalty for the first gap position.
+
+	For each target, the best score and the first cell (in row-major order)
+	attaining it are returned, which is the cell that
+	@ref ImplAlignatorDPScoreOnly::performAlignmentLocal reports.
+
+	The function returns false if the computation saturated.
+ */
+template< class V >
+static bool alignGroup(
+		const Residue * query, Position query_length,
+		const Residue * const * targets, const Position * target_lengths,
+		int num_targets,
+		const Score * matrix, int matrix_width, int matrix_height,
+		Score max_match,
+		int row_open, int row_extend,
+		int col_open, int col_extend,
+		Score * best_scores, Position * best_rows, Position * best_cols )
+{
+	typedef typename V::Vector Vector;
+	typedef typename V::Value Value;
+
+	const int lanes = V::LANES;
+	assert( num_targets <= lanes );
+
+	Position length = 0;
+	for (int l = 0; l < num_targets; ++l)
+		length = std::max( length, target_lengths[l] );
+
+	// build the target profile: for each residue in the query the
+	// scores against all targets, one vector per column
+	Vector * profile = allocateVectors<Vector>( matrix_height * length );
+	for (int residue = 0; residue < matrix_height; ++residue)
+	{
+		Value * p = (Value*)(profile + residue * length);
+		for (Position j = 0; j < length; ++j)
+			for (int l = 0; l < lanes; ++l)
+				// padding receives a large negative score, but not minus infinity
+				// in order to avoid overflow when adding to the diagonal.
+				p[ j * lanes + l] = (l < num_targets && j < target_lengths[l]) ?
+						(Value)matrix[ residue * matrix_width + targets[l][j] ] : V::minValue() / 2;
+	}
+
+	Vector * h = allocateVectors<Vector>( length );
+	Vector * d = allocateVectors<Vector>( length );
+
+	const Vector v_zero = V::zero();
+	const Vector v_row_open = V::set1( row_open );
+	const Vector v_row_extend = V::set1( row_extend );
+	const Vector v_col_open = V::set1( col_open );
+	const Vector v_col_extend = V::set1( col_extend );
+
+	for (Position j = 0; j < length; ++j)
+	{
+		V::store( h + j, v_zero );
+		V::store( d + j, V::set1( -row_open ) );
+	}
+
+	// the first cell always attains the initial maximum of 0
+	Value best[lanes] __attribute__((aligned(ALIGNLIB_SIMD_ALIGNMENT)));
+	Value row_max[lanes] __attribute__((aligned(ALIGNLIB_SIMD_ALIGNMENT)));
+	for (int l = 0; l < lanes; ++l)
+	{
+		best[l] = 0;
+		best_rows[l] = 0;
+		best_cols[l] = 0;
+	}
+	Vector v_best = v_zero;
+	const Value * hh = (const Value*)h;
+
+	for (Position i = 0; i < query_length; ++i)
+	{
+		const Vector * p = profile + query[i] * length;
+
+		Vector v_s = v_zero;
+		Vector v_c = v_zero;
+		Vector v_e = V::set1( -col_open );
+		Vector v_max = v_zero;
+
+		for (Position j = 0; j < length; ++j)
+		{
+			v_e = V::max( V::sub( v_c, v_col_open ), V::sub( v_e, v_col_extend ) );
+			Vector v_h = V::load( h + j );
+			Vector v_d = V::max( V::sub( v_h, v_row_open ), V::sub( V::load( d + j ), v_row_extend ) );
+			v_c = V::add( v_s, V::load( p + j ) );
+			v_c = V::max( v_c, v_e );
+			v_c = V::max( v_c, v_d );
+			v_c = V::max( v_c, v_zero );
+			v_s = v_h;
+			V::store( h + j, v_c );
+			V::store( d + j, v_d );
+			v_max = V::max( v_max, v_c );
+		}
+
+		// locate the first cell attaining a new maximum in this row. Padding cells
+		// can not exceed the maximum of the real cells.
+		if (V::any( V::cmpgt( v_max, v_best ) ))
+		{
+			V::store( (Vector*)row_max, v_max );
+			for (int l = 0; l < num_targets; ++l)
+			{
+				if (row_max[l] <= best[l])
+					continue;
+				for (Position j = 0; j < target_lengths[l]; ++j)
+					if (hh[j * lanes + l] == row_max[l])
+					{
+						best[l] = row_max[l];
+						best_rows[l] = i;
+						best_cols[l] = j;
+						break;
+					}
+			}
+			v_best = V::load( (Vector*)best );
+		}
+	}
+
+	releaseVectors( profile );
+	releaseVectors( h );
+	releaseVectors( d );
+
+	bool saturated = false;
+	for (int l = 0; l < num_targets; ++l)
+	{
+		best_scores[l] = best[l];
+		if (best[l] + max_match >= V::maxValue())
+			saturated = true;
+	}
+
+	return !saturated;
+}
+
+#endif
+
+//----------------------------------------------------------------------------------------------
+ImplAlignatorDPScoreOnly::ImplAlignatorDPScoreOnly() :
+	ImplAlignatorDP(),
+	mRowLast(NO_POS), mColLast(NO_POS)
+	{}
+
+ImplAlignatorDPScoreOnly::ImplAlignatorDPScoreOnly( AlignmentType alignment_type,
+		Score row_gop, Score row_gep,
+		Score col_gop, Score col_gep,
+		bool penalize_row_left, bool penalize_row_right,
+		bool penalize_col_left, bool penalize_col_right) :
+			ImplAlignatorDP( alignment_type, row_gop, row_gep, col_gop, col_gep,
+					penalize_row_left, penalize_row_right, penalize_col_left, penalize_col_right ),
+					mRowLast(NO_POS), mColLast(NO_POS)
+					{
+					}
+
+//----------------------------------------------------------------------------------------------
+ImplAlignatorDPScoreOnly::ImplAlignatorDPScoreOnly( const ImplAlignatorDPScoreOnly & src ) :
+	ImplAlignatorDP( src ),
+	mRowLast(NO_POS), mColLast(NO_POS)
+	{
+	debug_func_cerr(5);
+	}
+
+//------------------------------------------------------------------------------------------------
+ImplAlignatorDPScoreOnly::~ImplAlignatorDPScoreOnly()
+{
+	debug_func_cerr(5);
+}
+
+IMPLEMENT_CLONE( HAlignator, ImplAlignatorDPScoreOnly);
+
+//------------------------------------------------------------------------------------------------
+void ImplAlignatorDPScoreOnly::startUp( HAlignment & ali,
+		const HAlignandum & row,
+		const HAlignandum & col )
+{
+	debug_func_cerr(5);
+
+	ImplAlignatorDP::startUp(ali, row, col );
+
+	mRowLast = NO_POS;
+	mColLast = NO_POS;
+}
+
+#ifdef ALIGNLIB_HAVE_SIMD
+//-----------------------------------------------------------------------------------
+static inline bool isIntegral( const Score & value )
+{
+	return floor(value) == value;
+}
+
+/** sort targets by length */
+struct LongerTarget
+{
+	LongerTarget( const std::vector<Position> & lengths ) : mLengths( lengths ) {}
+	bool operator()( size_t a, size_t b ) const
+	{
+		return mLengths[a] > mLengths[b] || (mLengths[a] == mLengths[b] && a < b);
+	}
+	const std::vector<Position> & mLengths;
+};
+#endif
+
+//-----------------------------------------------------------------------------------
+void ImplAlignatorDPScoreOnly::alignGroups(
+		const HAlignandum & query,
+		const AlignandumVector & targets,
+		size_t from, size_t to,
+		std::vector<GroupResult> & results )
+{
+	debug_func_cerr(5);
+
+#ifdef ALIGNLIB_HAVE_SIMD
+	if (mAlignmentType != ALIGNMENT_LOCAL)
+		return;
+
+	// the vertical recurrence is only valid on the full matrix
+	if (!boost::dynamic_pointer_cast< ImplIterator2DFull, Iterator2D>(getToolkit()->getIterator2D()))
+		return;
+
+	const HImplSequence q(boost::dynamic_pointer_cast< ImplSequence, Alignandum>(query));
+	if (!q)
+		return;
+
+	// check if penalties can be represented as integers
+	if (!isIntegral( mRowGop ) || !isIntegral( mRowGep ) ||
+			!isIntegral( mColGop ) || !isIntegral( mColGep ) )
+		return;
+
+	int row_open = (int)-(mRowGop + mRowGep);
+	int row_extend = (int)-mRowGep;
+	int col_open = (int)-(mColGop + mColGep);
+	int col_extend = (int)-mColGep;
+
+	if (row_extend < 0 || row_open < row_extend || col_extend < 0 || col_open < col_extend)
+		return;
+
+	const Position query_from = query->getFrom();
+	const Position query_length = query->getTo() - query_from;
+	if (query_length <= 0)
+		return;
+	const Residue * query_residues = &(*q->getSequence())[query_from];
+
+	//--------------------------------------------------------------------------
+	// collect targets that can be aligned in groups. All of them need to
+	// be scored with the same substitution matrix.
+	HSubstitutionMatrix matrix;
+	Score max_match = 0;
+	const Score * data = NULL;
+	int matrix_width = 0;
+	int matrix_height = 0;
+
+	std::vector<size_t> indices;
+	std::vector<Position> lengths( to - from, 0 );
+	std::vector<Position> starts( to - from, 0 );
+	std::vector<const Residue*> residues( to - from, (const Residue*)NULL );
+
+	for (size_t x = from; x < to; ++x)
+	{
+		const HImplSequence t(boost::dynamic_pointer_cast< ImplSequence, Alignandum>(targets[x]));
+		if (!t)
+			continue;
+		targets[x]->prepare();
+
+		const Position target_from = t->getFrom();
+		const Position target_length = t->getTo() - target_from;
+		if (target_length <= 0)
+			continue;
+
+		const boost::shared_ptr<ImplScorerSequenceSequence> scorer(
+				boost::dynamic_pointer_cast< ImplScorerSequenceSequence, Scorer>(
+						getToolkit()->getScorer()->getNew( query, targets[x] ) ));
+		if (!scorer)
+			continue;
+
+		if (!matrix)
+		{
+			matrix = scorer->getSubstitutionMatrix();
+			matrix_width = matrix->getNumCols();
+			matrix_height = matrix->getNumRows();
+			data = matrix->getData();
+			for (int y = 0; y < matrix_width * matrix_height; ++y)
+			{
+				if (!isIntegral( data[y] ) || fabs(data[y]) >= SimdInt32::maxValue() / 2)
+					return;
+				max_match = std::max( max_match, data[y] );
+			}
+			for (Position y = 0; y < query_length; ++y)
+				if (query_residues[y] >= matrix_height) return;
+		}
+		else if (scorer->getSubstitutionMatrix() != matrix)
+			continue;
+
+		const Residue * target_residues = &(*t->getSequence())[target_from];
+		bool valid = true;
+		for (Position y = 0; y < target_length && valid; ++y)
+			valid = target_residues[y] < matrix_width;
+		if (!valid)
+			continue;
+
+		indices.push_back( x - from );
+		starts[x - from] = target_from;
+		lengths[x - from] = target_length;
+		residues[x - from] = target_residues;
+	}
+
+	if (indices.empty())
+		return;
+
+	// group targets of similar length
+	std::sort( indices.begin(), indices.end(), LongerTarget( lengths ) );
+
+	//--------------------------------------------------------------------------
+	const int lanes = SimdInt16::LANES;
+	const Residue * group_residues[lanes];
+	Position group_target_lengths[lanes];
+	Score scores[lanes];
+	Position rows[lanes];
+	Position cols[lanes];
+
+	for (size_t first = 0; first < indices.size(); first += lanes)
+	{
+		int num_targets = (int)std::min( (size_t)lanes, indices.size() - first );
+		for (int l = 0; l < num_targets; ++l)
+		{
+			group_residues[l] = residues[indices[first + l]];
+			group_target_lengths[l] = lengths[indices[first + l]];
+		}
+
+		// try with 16-bit integers first and use 32-bit integers on saturation.
+		// Targets, for which the 32-bit computation saturates, are left undone.
+		std::vector<bool> done( num_targets, false );
+
+		if (max_match < SimdInt16::maxValue() / 2 &&
+				row_open < SimdInt16::maxValue() / 2 && col_open < SimdInt16::maxValue() / 2 &&
+				alignGroup<SimdInt16>( query_residues, query_length,
+						group_residues, group_target_lengths, num_targets,
+						data, matrix_width, matrix_height, max_match,
+						row_open, row_extend, col_open, col_extend,
+						scores, rows, cols ))
+		{
+			done.assign( num_targets, true );
+		}
+		else
+		{
+			debug_cerr( 5, "16-bit group alignment saturated - switching to 32-bit" );
+
+			for (int sub = 0; sub < num_targets; sub += SimdInt32::LANES)
+			{
+				int num_sub = std::min( (int)SimdInt32::LANES, num_targets - sub );
+				if (alignGroup<SimdInt32>( query_residues, query_length,
+						group_residues + sub, group_target_lengths + sub, num_sub,
+						data, matrix_width, matrix_height, max_match,
+						row_open, row_extend, col_open, col_extend,
+						scores + sub, rows + sub, cols + sub ))
+					for (int l = sub; l < sub + num_sub; ++l)
+						done[l] = true;
+			}
+		}
+
+		for (int l = 0; l < num_targets; ++l)
+		{
+			if (!done[l])
+				continue;
+			size_t x = indices[first + l];
+			GroupResult & r = results[x];
+			r.mDone = true;
+			r.mScore = scores[l];
+			r.mRow = query_from + rows[l];
+			r.mCol = starts[x] + cols[l];
+			r.mMatch = data[ query_residues[rows[l]] * matrix_width + group_residues[l][cols[l]] ];
+		}
+	}
+#endif
+}
+
+//-----------------------------------------------------------------------------------
+void ImplAlignatorDPScoreOnly::alignMany(
+		HAlignment & dest,
+		const HAlignandum & query,
+		const AlignandumVector & targets,
+		AlignatorCallback & callback )
+{
+	debug_func_cerr(5);
+
+	query->prepare();
+
+	startBatch( query, targets );
+
+	// targets are grouped within windows in order to bound the memory
+	// for results kept before the callback is called.
+	const size_t window_size = 1024;
+	std::vector<GroupResult> results;
+
+	for (size_t from = 0; from < targets.size(); from += window_size)
+	{
+		size_t to = std::min( from + window_size, targets.size() );
+		results.assign( to - from, GroupResult() );
+
+		alignGroups( query, targets, from, to, results );
+
+		for (size_t x = from; x < to; ++x)
+		{
+			const GroupResult & r = results[x - from];
+			if (r.mDone)
+			{
+				dest->clear();
+				if (r.mScore > 0)
+				{
+					dest->addPair( ResiduePair( r.mRow, r.mCol, r.mMatch ) );
+					dest->setScore( r.mScore );
+				}
+			}
+			else
+				align( dest, query, targets[x] );
+
+			if (!callback( x, targets[x], dest ))
+			{
+				finishBatch();
+				return;
+			}
+		}
+	}
+
+	finishBatch();
+}
+
+//-----------------------------------------------------------------------------------
+void ImplAlignatorDPScoreOnly::performAlignment(
+		HAlignment & ali,
+		const HAlignandum & prow,
+		const HAlignandum & pcol )
+{
+	debug_func_cerr(5);
+
+	switch (mAlignmentType)
+	{
+	case ALIGNMENT_LOCAL:
+		performAlignmentLocal( ali, prow, pcol );
+		break;
+	case ALIGNMENT_WRAP:
+		performAlignmentWrapped( ali, prow, pcol );
+		break;
+	case ALIGNMENT_GLOBAL:
+		if (mPenalizeRowLeft || mPenalizeRowRight || mPenalizeColLeft || mPenalizeColRight)
+			performAlignmentGlobal( ali, prow, pcol );
+		else
+			performAlignmentLocal( ali, prow, pcol );
+		break;
+	}
+
+	// save end of alignment
+	if (mRowLast == NO_POS || mColLast == NO_POS)
+		return;
+
+	// local alignments without a positive score are empty
+	if (mScore <= 0 && (mAlignmentType != ALIGNMENT_GLOBAL ||
+			!(mPenalizeRowLeft || mPenalizeRowRight || mPenalizeColLeft || mPenalizeColRight)))
+		return;
+
+	ali->addPair( ResiduePair( mRowLast, mColLast, mScorer->getScore( mRowLast, mColLast ) ) );
+	ali->setScore( mScore );
+}
+
+//-----------------------------------------------------------------------------------
+void ImplAlignatorDPScoreOnly::performAlignmentGlobal(
+		HAlignment & ali,
+		const HAlignandum & prow,
+		const HAlignandum & pcol )
+{
+
+	debug_func_cerr(5);
+
+	Score row_gop = getRowGop();
+	Score row_gep = getRowGep();
+	Score col_gop = getColGop();
+	Score col_gep = getColGep();
+
+	Score c, e, d, s;                  // helper variables
+	c = e = d = s = 0;
+
+	Score row_m = row_gop + row_gep;
+	Score col_m = col_gop + col_gep;
+
+	//---> Initialise affine penalty arrays <--------------------------
+	{
+		Position row = mIterator->row_front();
+		Iterator2D::const_iterator cit(mIterator->col_begin(row)), cend(mIterator->col_end(row));
+		assert( (*cit) -1 >= -1);
+		mCC[(*cit)-1] = 0;
+
+		/* set initial values for upper border */
+		if (mPenalizeRowLeft)
+		{
+			for (; cit != cend; ++cit)
+			{
+				Position col = *cit;
+				mCC[col]   = row_gop + row_gep * (col+1);
+				mDD[col]   = mCC[col];
+			}
+		}
+		else
+		{
+			for (; cit != cend; ++cit)
+			{
+				Position col = *cit;
+				mCC[col]   = 0;
+				mDD[col]   = row_gop;
+			}
+		}
+	}
+
+	//----------------------------> iterate over rows <--------------------------------------------
+	Iterator2D::const_iterator rit(mIterator->row_begin()), rend(mIterator->row_end());
+
+	for (; rit != rend; ++rit)
+	{
+		Position row = *rit;
+		Position row_length = mIterator->row_size();
+		Position row_from   = mIterator->row_front( row );
+		Position col_length = mIterator->col_size( row );
+
+		Iterator2D::const_iterator cit(mIterator->col_begin(row)), cend(mIterator->col_end(row));
+		Position col_from = *cit;
+
+		if (mPenalizeColLeft)
+		{
+			s = mCC[col_from-1];
+			mCC[col_from-1] += col_gep;
+			if (row == row_from)
+				mCC[col_from-1] += col_gop;
+			e = c = col_gop + col_gep * (row + 1);
+		}
+		else
+		{
+			s = 0;
+			c = 0;
+			e = col_gop;
+		}
+
+		//-------------------------> iterate over cols <------------------------------------------------
+		for (; cit != cend; ++cit)
+		{
+			Position col = *cit;
+
+			if ((c = c + col_m) > (e = e + col_gep))
+				e = c;
+
+			if ((c = mCC[col] + row_m) > (d = mDD[col] + row_gep))
+				d = c;
+
+			c = s + mScorer->getScore(row,col);
+
+			if (e > c) c = e;
+			if (d > c) c = d;
+
+			s = mCC[col];
+			mCC[col] = c;
+			mDD[col] = d;
+
+			if (mPenalizeColRight && row < row_length - 1)
+				continue;
+			if (mPenalizeRowRight && col < col_length - 1)
+				continue;
+
+			if (mScore < c)
+			{
+				mScore   = c;
+				mRowLast = row;
+				mColLast = col;
+			}
+		}
+	}
+}
+
+//-----------------------------------------------------------------------------------
+void ImplAlignatorDPScoreOnly::performAlignmentWrapped( HAlignment & ali,
+		const HAlignandum & prow, const HAlignandum & pcol )
+{
+	debug_func_cerr(5);
+
+	Score row_gop = getRowGop();
+	Score row_gep = getRowGep();
+	Score col_gop = getColGop();
+	Score col_gep = getColGep();
+
+	Score c, e, d, s;                  // helper variables
+	c = e = d = s = 0;
+
+	Score row_m = row_gop + row_gep;
+	Score col_m = col_gop + col_gep;
+
+	//---> Initialise affine penalty arrays <--------------------------
+	{
+		Position row = mIterator->row_front();
+		Iterator2D::const_iterator cit(mIterator->col_begin(row)), cend(mIterator->col_end(row));
+		assert( (*cit) -1 >= -1);
+		mCC[(*cit)-1] = 0;
+
+		for (; cit != cend; ++cit)
+		{
+			Position col = *cit;
+			mCC[col]   = 0;
+			mDD[col]   = row_gop;
+		}
+		mCC[mIterator->col_back()] = col_gop;
+	}
+
+	//----------------------------> iterate over rows <--------------------------------------------
+	Iterator2D::const_iterator rit(mIterator->row_begin()), rend(mIterator->row_end());
+
+	for (; rit != rend; ++rit)
+	{
+		Position row = *rit;
+		Position col_length = mIterator->col_size( row );
+
+		Iterator2D::const_iterator cit(mIterator->col_begin(row)), cend(mIterator->col_end(row));
+		Position col_from = *cit;
+
+		// the wrapping around part
+		if (mCC[col_length-1] > 0)
+			mCC[col_from - 1] = c = mCC[col_length-1];
+		else
+			mCC[col_from - 1] = c = 0;
+
+		s = mCC[col_from - 1];
+		e = col_gop;
+
+		//-------------------------> iterate over cols <------------------------------------------------
+		for (; cit != cend; ++cit)
+		{
+			Position col = *cit;
+
+			if ((c = c + col_m) > (e = e + col_gep))
+				e = c;
+
+			if ((c = mCC[col] + row_m) > (d = mDD[col] + row_gep))
+				d = c;
+
+			c = s + mScorer->getScore(row,col);
+
+			if (e > c) c = e;
+			if (d > c) c = d;
+			if (c <= 0) c = 0;
+
+			s = mCC[col];
+			mCC[col] = c;
+			mDD[col] = d;
+
+			if (mScore < c)
+			{
+				mScore   = c;
+				mRowLast = row;
+				mColLast = col;
+			}
+		}
+	}
+}
+
+//-----------------------------------------------------------------------------------
+void ImplAlignatorDPScoreOnly::performAlignmentLocal(
+		HAlignment & ali,
+		const HAlignandum & prow,
+		const HAlignandum & pcol )
+{
+
+	debug_func_cerr(5);
+
+	Score row_gop = getRowGop();
+	Score row_gep = getRowGep();
+	Score col_gop = getColGop();
+	Score col_gep = getColGep();
+
+	Score c, e, d, s;                  // helper variables
+	c = e = d = s = 0;
+
+	Score row_m = row_gop + row_gep;
+	Score col_m = col_gop + col_gep;
+
+	//---> Initialise affine penalty arrays <--------------------------
+	{
+		Position row = mIterator->row_front();
+		Iterator2D::const_iterator cit(mIterator->col_begin(row)), cend(mIterator->col_end(row));
+		assert( (*cit) -1 >= -1);
+		mCC[(*cit)-1] = 0;
+
+		for (; cit != cend; ++cit)
+		{
+			Position col = *cit;
+			mCC[col]   = 0;
+			mDD[col]   = row_gop;
+		}
+		mCC[mIterator->col_back()] = col_gop;
+	}
+
+	//----------------------------> iterate over rows <--------------------------------------------
+	Iterator2D::const_iterator rit(mIterator->row_begin()), rend(mIterator->row_end());
+
+	for (; rit != rend; ++rit)
+	{
+		Position row = *rit;
+
+		Iterator2D::const_iterator cit(mIterator->col_begin(row)), cend(mIterator->col_end(row));
+		Position col_from = *cit;
+
+		s = mCC[col_from - 1];
+		mCC[col_from - 1] = c = 0;
+		e = col_gop;
+
+		//-------------------------> iterate over cols <------------------------------------------------
+		for (; cit != cend; ++cit)
+		{
+			Position col = *cit;
+
+			if ((c = c + col_m) > (e = e + col_gep))
+				e = c;
+
+			if ((c = mCC[col] + row_m) > (d = mDD[col] + row_gep))
+				d = c;
+
+			c = s + mScorer->getScore(row,col);
+
+			if (e > c) c = e;
+			if (d > c) c = d;
+			if (c <= 0) c = 0;
+
+			s = mCC[col];
+			mCC[col] = c;
+			mDD[col] = d;
+
+			if (mScore < c)
+			{
+				mScore   = c;
+				mRowLast = row;
+				mColLast = col;
+			}
+		}
+	}
+}
+
+
+} // namespace alignlib
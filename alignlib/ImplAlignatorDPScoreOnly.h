@@ -0,0 +1,157 @@
+/*
+  alignlib - a library for aligning protein sequences
+
+  $Id$
+
+  Copyright (C) 2026 Andreas Heger
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+*/
+
+#if HAVE_CONFIG_H
+#include <config.h>
+#endif
+
+#ifndef IMPL_ALIGNATOR_DP_SCORE_ONLY_H
+#define IMPL_ALIGNATOR_DP_SCORE_ONLY_H 1
+
+#include "alignlib_fwd.h"
+#include "ImplAlignatorDP.h"
+
+namespace alignlib
+{
+
+/**
+    @brief dynamic programming alignment returning only the score.
+
+    This object computes the same recurrences as @ref ImplAlignatorDPFull,
+    but does not keep a trace matrix. Memory use is linear in the length
+    of the column object.
+
+    The resulting alignment contains only a single pair, namely the cell
+    in which the best alignment ends. The score of the alignment is
+    set to the score of the best alignment. The alignment is empty
+    if there is no alignment with positive score.
+
+    When aligning a query sequence against many target sequences
+    with @ref alignMany, local alignments are computed for several
+    targets at once with vector instructions. Targets are grouped
+    by length, each target occupying one lane of a vector.
+
+    @author Andreas Heger
+    @version $Id$
+*/
+class ImplAlignatorDPScoreOnly : public ImplAlignatorDP
+{
+ public:
+
+    /* Constructors and destructors */
+
+	/** constructor */
+	ImplAlignatorDPScoreOnly();
+
+    /** set affine gap penalties
+	@param row_gop		gap opening penalty in row
+	@param row_gep		gap elongation penalty in row
+	@param col_gop		gap opening penalty in column, default = row
+	@param col_gep		gap elongation penalty in row, default = col
+    */
+    ImplAlignatorDPScoreOnly( AlignmentType alignment_type,
+    		Score row_gop, Score row_gep,
+    		Score col_gop = 0, Score col_gep = 0,
+    		bool penalize_row_left = false, bool penalize_row_right = false,
+    		bool penalize_col_left = false, bool penalize_col_right = false);
+
+    /** copy constructor */
+    ImplAlignatorDPScoreOnly( const ImplAlignatorDPScoreOnly & );
+
+    /** destructor */
+    virtual ~ImplAlignatorDPScoreOnly();
+
+    DEFINE_CLONE( HAlignator );
+
+    /** align a query against many targets.
+     *
+     * Sequence targets are aligned in groups if possible.
+     */
+    virtual void alignMany( HAlignment & dest,
+    		const HAlignandum & query,
+    		const AlignandumVector & targets,
+    		AlignatorCallback & callback );
+
+ protected:
+
+    /** result of an alignment computed in a group of targets */
+    struct GroupResult
+    {
+    	GroupResult() : mDone( false ), mScore( 0 ), mRow( NO_POS ), mCol( NO_POS ), mMatch( 0 ) {}
+    	/** true, if the alignment has been computed */
+    	bool mDone;
+    	/** score of best alignment */
+    	Score mScore;
+    	/** row, where best alignment ended */
+    	Position mRow;
+    	/** column, where best alignment ended */
+    	Position mCol;
+    	/** score of the last aligned pair */
+    	Score mMatch;
+    };
+
+    /** compute local alignments for the targets from-to in groups.
+     *
+     * Targets that can not be aligned in a group are not marked as done.
+     */
+    void alignGroups( const HAlignandum & query,
+    		const AlignandumVector & targets,
+    		size_t from, size_t to,
+    		std::vector<GroupResult> & results );
+
+    /** perform initialization before alignment */
+    virtual void startUp(HAlignment & dest, const HAlignandum & row, const HAlignandum & col );
+
+    /** perform the alignment */
+    virtual void performAlignment(HAlignment & dest,
+    		const HAlignandum & row,
+    		const HAlignandum & col );
+
+    /** compute score of local alignment */
+    virtual void performAlignmentLocal(HAlignment & dest,
+    		const HAlignandum & row,
+    		const HAlignandum & col );
+
+    /** compute score of global alignment */
+    virtual void performAlignmentGlobal(HAlignment & dest,
+    		const HAlignandum & row,
+    		const HAlignandum & col );
+
+    /** compute score of wrapped alignment */
+    virtual void performAlignmentWrapped(HAlignment & dest,
+    		const HAlignandum & row,
+    		const HAlignandum & col );
+
+    /* member data --------------------------------------------------------------------------- */
+ protected:
+
+    /** row, where best alignment ended */
+    Position mRowLast;
+
+    /** column, where best alignment ended */
+    Position mColLast;
+};
+
+
+}
+
+#endif /* IMPL_ALIGNATOR_DP_SCORE_ONLY_H */
@@ -27,6 +27,7 @@
 
 #include <map>
 #include <vector>
+#include <algorithm>
 
 #include "alignlib_fwd.h"
 #include "alignlib_interfaces.h"
@@ -34,7 +35,7 @@
 #include "AlignlibException.h"
 #include "ImplAlignatorDots.h"
 #include "Alignandum.h"
-#include "ImplAlignmentMatrixRow.h"
+#include "ImplAlignmentMatrixArrays.h"
 
 #include "HelpersSubstitutionMatrix.h"
 #include "HelpersToolkit.h"
@@ -69,6 +70,7 @@ ImplAlignatorDots::ImplAlignatorDots(
 		Score row_gop, Score row_gep,
 		Score col_gop, Score col_gep )
 : ImplAlignator(), mDottor (dots),
+mTrace(NULL), mTraceCapacity(0),
 mRowGop( row_gop ), mRowGep( row_gep ),
 mColGop( col_gop ), mColGep( col_gep )
 {
@@ -81,6 +83,7 @@ mColGop( col_gop ), mColGep( col_gep )
 
 ImplAlignatorDots::ImplAlignatorDots()
 : ImplAlignator(), mDottor (getToolkit()->getAlignator()),
+mTrace(NULL), mTraceCapacity(0),
 mRowGop( 0 ), mRowGep( 0 ),
 mColGop( 0 ), mColGep( 0 )
 {
@@ -89,7 +92,10 @@ mColGop( 0 ), mColGep( 0 )
 	  //----------------------------------------------------------------------------------------------------------
 ImplAlignatorDots::ImplAlignatorDots( const ImplAlignatorDots & src )
 : ImplAlignator( src ),
-mDottor(src.mDottor)
+mDottor(src.mDottor->getClone()),
+mTrace(NULL), mTraceCapacity(0),
+mRowGop( src.mRowGop ), mRowGep( src.mRowGep ),
+mColGop( src.mColGop ), mColGep( src.mColGep )
 {
 	debug_func_cerr(5);
 }
@@ -99,6 +105,7 @@ mDottor(src.mDottor)
 ImplAlignatorDots::~ImplAlignatorDots()
 {
   debug_func_cerr(5);
+  releaseBuffer( mTrace, mTraceCapacity );
 }
 
 IMPLEMENT_CLONE( HAlignator, ImplAlignatorDots );
@@ -127,8 +134,10 @@ void ImplAlignatorDots::startUp(HAlignment & ali,
     mColLength = mIterator->col_size();
 
     // the algorithms assume that dots are sorted by row,
-    // so use AlignmentMatrixRow
-    mMatrix = makeAlignmentMatrixRow();
+    // so use AlignmentMatrixArrays. The matrix is re-used
+    // between alignments.
+    if (!mMatrix)
+    	mMatrix = makeAlignmentMatrixArrays();
 
     // setup matrix of dots
     mDottor->align( mMatrix, row, col );
@@ -143,11 +152,13 @@ void ImplAlignatorDots::startUp(HAlignment & ali,
     debug_cerr( 10, "dots=\n" << *(mMatrix) );
 
     // get pointers to location of dots(pairs)
-    const HImplAlignmentMatrix t = boost::dynamic_pointer_cast< ImplAlignmentMatrix, Alignment>(mMatrix);
-    mPairs	= &t->mPairs;
-    mRowIndices = t->mIndex;
+    const HImplAlignmentMatrixArrays t = boost::dynamic_pointer_cast< ImplAlignmentMatrixArrays, Alignment>(mMatrix);
+    mPairRows = t->mRows.empty() ? NULL : &t->mRows[0];
+    mPairCols = t->mCols.empty() ? NULL : &t->mCols[0];
+    mPairScores = t->mScores.empty() ? NULL : &t->mScores[0];
+    mRowIndices = t->mIndex.empty() ? NULL : &t->mIndex[0];
 
-    mTrace   = new int[mNDots];
+    reserveBuffer( mTrace, mTraceCapacity, mNDots );
     mLastDot = -1;
   }
 
@@ -157,14 +168,52 @@ void ImplAlignatorDots::cleanUp(HAlignment & ali,
   {
     debug_func_cerr(5);
 
-
-    if (mTrace != NULL)
-      delete [] mTrace;
-
+    // buffers are kept for the next alignment
     ImplAlignator::cleanUp(ali, row, col );
 
   }
 
+//-------------------------------------------------------------------------------------------------------
+void ImplAlignatorDots::startBatch( const HAlignandum & query,
+		const AlignandumVector & targets )
+{
+	debug_func_cerr(5);
+	ImplAlignator::startBatch( query, targets );
+
+	// let the dotter pre-compute data for the query
+	boost::shared_ptr<ImplAlignator> dottor( boost::dynamic_pointer_cast<ImplAlignator, Alignator>(mDottor) );
+	if (dottor)
+		dottor->startBatch( query, targets );
+}
+
+//-------------------------------------------------------------------------------------------------------
+void ImplAlignatorDots::finishBatch()
+{
+	debug_func_cerr(5);
+
+	boost::shared_ptr<ImplAlignator> dottor( boost::dynamic_pointer_cast<ImplAlignator, Alignator>(mDottor) );
+	if (dottor)
+		dottor->finishBatch();
+
+	ImplAlignator::finishBatch();
+}
+
+//-------------------------------------------------------------------------------------------------------
+void ImplAlignatorDots::trimWorkspace()
+{
+	debug_func_cerr(5);
+
+	mDottor->trimWorkspace();
+
+	releaseBuffer( mTrace, mTraceCapacity );
+	mMatrix.reset();
+	std::vector<Score>().swap( mDotScores );
+	std::vector<Dot>().swap( mDotStack );
+	std::vector<ResiduePair>().swap( mTracePairs );
+
+	ImplAlignator::trimWorkspace();
+}
+
 //----------------------------------------------------------------------------------------------------------------------------------------
 void ImplAlignatorDots::align(HAlignment & result,
 		  const HAlignandum & row,
@@ -194,27 +243,34 @@ void ImplAlignatorDots::traceBack(
     int idot   = mLastDot;
     int jleft  = row->getLength();
 
+    mTracePairs.clear();
+
     while ( idot >= 0)
       {
 
         debug_cerr( 5, "-->idot "     << setw(5) << idot      <<
-            " col[idot] "  << setw(5) << (*mPairs)[idot].mCol <<
-            " row[idot] "  << setw(5) << (*mPairs)[idot].mRow <<
+            " col[idot] "  << setw(5) << mPairCols[idot] <<
+            " row[idot] "  << setw(5) << mPairRows[idot] <<
             " mTrace[idot] "<< setw(5) << mTrace[idot] );
 
-        row_res = (*mPairs)[idot].mRow;
-        col_res = (*mPairs)[idot].mCol;
+        row_res = mPairRows[idot];
+        col_res = mPairCols[idot];
 
         if (row_res < 0) continue;
         if (col_res < 0) continue;
         if (row_res > jleft) break;
         jleft = row_res;                                   // just in case
 
-        result->addPair( ResiduePair(row_res, col_res, (*mPairs)[idot].mScore) );
+        mTracePairs.push_back( ResiduePair(row_res, col_res, mPairScores[idot]) );
 
         idot = mTrace[idot];
       }
 
+    // pairs have been collected from the last dot backwards
+    std::reverse( mTracePairs.begin(), mTracePairs.end() );
+    if (!mTracePairs.empty())
+      result->addPairs( &mTracePairs[0], mTracePairs.size(), true );
+
     result->setScore( mScore );
   }
 //------------------------------------------------------------------------------------------------------------
@@ -227,9 +283,9 @@ Position ImplAlignatorDots::getPairIndex( Position r, Position c ) const
   if ( x == NO_POS )
   	return NO_POS;
 
-  while ((*mPairs)[x].mRow == r )
+  while (mPairRows[x] == r )
   {
-  	if ((*mPairs)[x].mCol == c)
+  	if (mPairCols[x] == c)
   	{
   		found = true;
   		break;
@@ -247,10 +303,10 @@ Position ImplAlignatorDots::getPairIndex( Position r, Position c ) const
 Score ImplAlignatorDots::getGapCost( Dot x1, Dot x2 ) const
 {
 
-  Position c1 = (*mPairs)[x1].mCol;
-  Position c2 = (*mPairs)[x2].mCol;
-  Position r1 = (*mPairs)[x1].mRow;
-  Position r2 = (*mPairs)[x2].mRow;
+  Position c1 = mPairCols[x1];
+  Position c2 = mPairCols[x2];
+  Position r1 = mPairRows[x1];
+  Position r2 = mPairRows[x2];
 
   Score gap_cost = 0;
   Position d;
@@ -296,7 +352,7 @@ void ImplAlignatorDots::performAlignment(
 
 	// check if number of dots and the size of the dotplot
 	// correspond.
-	assert( mNDots == mPairs->size() );
+	assert( mNDots == mMatrix->getLength() );
 
 	Dot global_best_dot = NO_POS;
 	Score global_best_score = 0;
@@ -308,10 +364,12 @@ void ImplAlignatorDots::performAlignment(
 	MyDotSet search_region;
 
 	// array with scores of dots
-	vector<Score> scores(mNDots,0);
+	vector<Score> & scores = mDotScores;
+	scores.assign( mNDots, 0 );
 
 	// array with dots in current row
-	vector<Dot> dot_stack(mColLength, NO_POS);
+	vector<Dot> & dot_stack = mDotStack;
+	dot_stack.assign( mColLength, NO_POS );
 
 	unsigned int num_row_dots = 0;
 	Position last_row = 0;
@@ -320,8 +378,8 @@ void ImplAlignatorDots::performAlignment(
 	for ( Dot current_dot = 0; current_dot < mNDots; ++current_dot)
 	{
 
-		Position current_row = (*mPairs)[current_dot].mRow;
-		Position current_col = (*mPairs)[current_dot].mCol;
+		Position current_row = mPairRows[current_dot];
+		Position current_col = mPairCols[current_dot];
 
 		debug_cerr( 6, "working on: dot=" << current_dot << " row=" << current_row << " col=" << current_col );
 
@@ -331,7 +389,7 @@ void ImplAlignatorDots::performAlignment(
 			while (num_row_dots > 0)
 			{
 				Dot dot = dot_stack[--num_row_dots];
-				search_region.insert(pair<Position, Dot>((*mPairs)[dot].mCol, dot));
+				search_region.insert(pair<Position, Dot>(mPairCols[dot], dot));
 			}
 			last_row = current_row;
 		}
@@ -370,9 +428,9 @@ void ImplAlignatorDots::performAlignment(
 
 		// no positive trace found, new trace starts at current dot
 		if (search_best_dot == NO_POS)
-			search_best_score = (*mPairs)[current_dot].mScore;
+			search_best_score = mPairScores[current_dot];
 		else
-			search_best_score += (*mPairs)[current_dot].mScore;
+			search_best_score += mPairScores[current_dot];
 
 		debug_cerr( 5, "current_dot=" << current_dot << " current_row=" << current_row << " current_col=" << current_col );
 		debug_cerr( 5, "search_best_dot=" << search_best_dot << " search_best_score=" << search_best_score );
@@ -30,7 +30,7 @@
 #include "alignlib_fwd.h"
 
 #include "ImplAlignator.h"
-#include "ImplAlignmentMatrix.h"
+#include "ImplAlignmentMatrixArrays.h"
 #include "Macros.h"
 
 namespace alignlib
@@ -83,6 +83,15 @@ class ImplAlignatorDots : public ImplAlignator
 
     DEFINE_CLONE( HAlignator );
 
+    /** prepare the dotter for the query */
+    virtual void startBatch( const HAlignandum & query, const AlignandumVector & targets );
+
+    /** finish the batch in the dotter */
+    virtual void finishBatch();
+
+    /** release buffers */
+    virtual void trimWorkspace();
+
     /** set gap opening penalty for row */
     virtual void setRowGop( Score gop );
 
@@ -146,8 +155,14 @@ class ImplAlignatorDots : public ImplAlignator
     /* diverse helper variables */
     Position mNDots;
 
-    /** pointer to dots for fast access */
-    const ImplAlignmentMatrix::PAIRVECTOR * mPairs;
+    /** pointer to rows of dots for fast access */
+    const Position * mPairRows;
+
+    /** pointer to columns of dots for fast access */
+    const Position * mPairCols;
+
+    /** pointer to scores of dots for fast access */
+    const Score * mPairScores;
 
     /** pointer to first dot in row for fast access */
     const Dot * mRowIndices;
@@ -159,6 +174,18 @@ class ImplAlignatorDots : public ImplAlignator
     /** trace of dots that are part of the alignment */
     int	*mTrace;
 
+    /** allocated size of mTrace */
+    size_t mTraceCapacity;
+
+    /** scores of dots */
+    std::vector<Score> mDotScores;
+
+    /** dots in current row */
+    std::vector<Dot> mDotStack;
+
+    /** aligned pairs collected during traceback */
+    std::vector<ResiduePair> mTracePairs;
+
     /** the score of the alignment */
     Score mScore;
 
@@ -91,13 +91,13 @@ IMPLEMENT_CLONE( HAlignator, ImplAlignatorDotsDiagonal )
 Score ImplAlignatorDotsDiagonal::getGapCost(Dot x1, Dot x2) const
 {
 
-	const ResiduePair & p1 = (*mPairs)[x1];
-	const ResiduePair & p2 = (*mPairs)[x2];
+	const Position r1 = mPairRows[x1], c1 = mPairCols[x1];
+	const Position r2 = mPairRows[x2], c2 = mPairCols[x2];
 
-	Diagonal diagonal_difference = (p2.mRow - p2.mCol) - (p1.mRow - p1.mCol);
+	Diagonal diagonal_difference = (r2 - c2) - (r1 - c1);
 
 	if (diagonal_difference == 0)
-		return mRowGop + (p2.mRow - p1.mRow) * mRowGep;
+		return mRowGop + (r2 - r1) * mRowGep;
 	else
 		return mColGop + mColGep * abs(diagonal_difference);
 
@@ -163,8 +163,8 @@ void ImplAlignatorDotsQuick::performAlignment(
     	  // iterate through nextrow starting at first position
 
     	  if (current_dot < 0) continue;
-    	  row_res = (*mPairs)[current_dot].mRow;                           /* row_res = row */
-    	  col_res = (*mPairs)[current_dot].mCol;                           /* col_res = col, wrap around col */
+    	  row_res = mPairRows[current_dot];                           /* row_res = row */
+    	  col_res = mPairCols[current_dot];                           /* col_res = col, wrap around col */
 
     	  // some safety checks
     	  assert( row_res < mRowLength);
@@ -175,19 +175,19 @@ void ImplAlignatorDotsQuick::performAlignment(
         std::cout << "current_dot=" << current_dot
         << " row_res=" << row_res
         << " col_res=" << col_res
-        << " score=" << (*mPairs)[current_dot].mScore
+        << " score=" << mPairScores[current_dot]
         << std::endl;
 #endif
         /* calculate top row */
 
         /*------------------------------------------------------------------------------*/
         if ( (last_dot < 0) ||				/* enter first time */
-            (row_res  > (*mPairs)[last_dot].mRow) ) {		/* skip, if not in the same row as last time*/
+            (row_res  > mPairRows[last_dot]) ) {		/* skip, if not in the same row as last time*/
 
               /* commit changes to bestpercol from bestpercolstack */
               while( bestpercolstackptr > STACKEMPTY ) {
                 xdot = bestpercolstack[--bestpercolstackptr];
-                xcol = (*mPairs)[xdot].mCol;
+                xcol = mPairCols[xdot];
                 if ( (bestpercol[xcol] == -1) || best >= m[bestpercol[xcol]])
                   bestpercol[xcol] = xdot;
               }
@@ -208,8 +208,8 @@ void ImplAlignatorDotsQuick::performAlignment(
         xdot = mRowIndices[row_res-1];
         sc = 0;
         while ( (xdot > -1)  &&
-            ((*mPairs)[xdot].mRow == row_res-1 ) &&  /* stop, if dot in previous row any more*/
-            ((*mPairs)[xdot].mCol  < col_res-1 )     /* end, if direct contact to new dot*/
+            (mPairRows[xdot] == row_res-1 ) &&  /* stop, if dot in previous row any more*/
+            (mPairCols[xdot]  < col_res-1 )     /* end, if direct contact to new dot*/
         ) {
 
           s = m[xdot] + getGapCost( xdot, current_dot);
@@ -279,7 +279,7 @@ void ImplAlignatorDotsQuick::performAlignment(
         if( sc > best)  { best = sc; best_dot = prev_row_dot; }
 
         /* record mTraceback */
-        best += (*mPairs)[current_dot].mScore;
+        best += mPairScores[current_dot];
 
         if (best < 0) { /* local alignment, reset to zero or start new mTrace with single match */
           best    = 0;
@@ -0,0 +1,301 @@
+/*
+  alignlib - a library for aligning protein sequences
+
+  $Id$
+
+  Copyright (C) 2026 Andreas Heger
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+ */
+
+
+#include <iostream>
+#include <iomanip>
+#include <algorithm>
+#include <vector>
+
+#include "alignlib_fwd.h"
+#include "alignlib_interfaces.h"
+#include "AlignlibDebug.h"
+#include "AlignlibException.h"
+#include "ImplAlignmentMatrixArrays.h"
+#include "HelpersAlignator.h"
+
+#include "ImplAlignatorDotsSparse.h"
+
+using namespace std;
+
+namespace alignlib
+{
+
+/*---------------------factory functions ---------------------------------- */
+
+HAlignator makeAlignatorDotsSparse(
+		const HAlignator & alignator,
+		Score gop,
+		Score gep )
+{
+	return HAlignator( new ImplAlignatorDotsSparse( alignator, gop, gep, gop, gep ) );
+}
+
+//----------------------------------------------------------------------------------------------------------
+/** constructors and destructors */
+ImplAlignatorDotsSparse::ImplAlignatorDotsSparse() :
+	ImplAlignatorDots(), mColumnOffset(0)
+	{}
+
+ImplAlignatorDotsSparse::ImplAlignatorDotsSparse(
+		  const HAlignator & dots,
+		  Score row_gop, Score row_gep,
+		  Score col_gop, Score col_gep )
+: ImplAlignatorDots( dots, row_gop, row_gep, col_gop, col_gep),
+  mColumnOffset(0)
+{
+}
+
+//----------------------------------------------------------------------------------------------------------
+ImplAlignatorDotsSparse::ImplAlignatorDotsSparse( const ImplAlignatorDotsSparse & src )
+: ImplAlignatorDots( src ), mColumnOffset(0)
+{
+	debug_func_cerr(5);
+}
+
+//----------------------------------------------------------------------------------------------------------
+ImplAlignatorDotsSparse::~ImplAlignatorDotsSparse()
+{
+	debug_func_cerr(5);
+}
+
+IMPLEMENT_CLONE( HAlignator, ImplAlignatorDotsSparse );
+
+//----------------------------------------------------------------------------------------------------------
+void ImplAlignatorDotsSparse::trimWorkspace()
+{
+	debug_func_cerr(5);
+
+	std::vector<Candidate>().swap( mColumnTree );
+	std::vector<Candidate>().swap( mColumnBest );
+	std::vector<Candidate>().swap( mPreviousBest );
+	std::vector<Dot>().swap( mRowDots );
+	std::vector<Dot>().swap( mPreviousDots );
+
+	ImplAlignatorDots::trimWorkspace();
+}
+
+//----------------------------------------------------------------------------------------------------------
+void ImplAlignatorDotsSparse::addRow( const std::vector<Dot> & dots )
+{
+	const Position tree_size = mColumnTree.size();
+
+	for (std::vector<Dot>::const_iterator it = dots.begin(); it != dots.end(); ++it)
+	{
+		const Dot dot = *it;
+		const Position row = mPairRows[dot];
+		const Position col = mPairCols[dot];
+		const Score score = mDotScores[dot];
+
+		// gap in row only: key is independent of column
+		Candidate c( score - row * mRowGep, row, col, dot );
+		if (c.isBetter( mColumnBest[col - mColumnOffset] ))
+			mColumnBest[col - mColumnOffset] = c;
+
+		// gap in row and column
+		c.mKey = score - row * mRowGep - col * mColGep;
+		for (Position i = col - mColumnOffset + 1; i < tree_size; i += i & -i)
+			if (c.isBetter( mColumnTree[i] ))
+				mColumnTree[i] = c;
+	}
+}
+
+//----------------------------------------------------------------------------------------------------------
+ImplAlignatorDotsSparse::Candidate ImplAlignatorDotsSparse::queryColumns( Position col ) const
+{
+	Candidate best;
+	if (col < mColumnOffset)
+		return best;
+
+	for (Position i = std::min( col - mColumnOffset + 1, (Position)mColumnTree.size() - 1); i > 0; i -= i & -i)
+		if (mColumnTree[i].isBetter( best ))
+			best = mColumnTree[i];
+
+	return best;
+}
+
+//----------------------------------------------------------------------------------------------------------
+void ImplAlignatorDotsSparse::chooseCandidate(
+		Candidate & best,
+		const Candidate & candidate,
+		Dot dot ) const
+{
+	if (candidate.mDot == NO_POS)
+		return;
+
+	// compute the score exactly as ImplAlignatorDots does.
+	Candidate c( candidate );
+	c.mKey = mDotScores[c.mDot] + ImplAlignatorDots::getGapCost( c.mDot, dot );
+	if (c.isBetter( best ))
+		best = c;
+}
+
+//-----------------------------------------------------------< Alignment subroutine >----------------------------------------------
+void ImplAlignatorDotsSparse::performAlignment(
+		HAlignment & ali,
+		const HAlignandum & prow,
+		const HAlignandum & pcol )
+{
+	/**
+		Overview over the algorithm
+
+		Dots are processed by row and then by column. The predecessor of a dot
+		at (row, col) is the best of:
+
+		1. the dot at (row-1, col-1): no gap.
+		2. dots in row-1 before col-1: gap in column only. Found
+			by prefix maxima over the previous row.
+		3. dots in col-1 before row-1: gap in row only. Found
+			by keeping the best dot for each column.
+		4. dots before row-1 and col-1: gaps in row and column.
+			Found by a prefix maximum query in a Fenwick tree over columns.
+
+		Dots of a row enter the structures for 3 and 4 once the
+		current row is at least two rows further down.
+	*/
+
+	debug_func_cerr(5);
+
+	assert( mNDots == mMatrix->getLength() );
+
+
+	Dot global_best_dot = NO_POS;
+	Score global_best_score = 0;
+
+	vector<Score> & scores = mDotScores;
+	scores.assign( mNDots, 0 );
+
+	// setup search structures for the range of columns
+	Position col_min = 0;
+	Position col_max = -1;
+	if (mNDots > 0)
+	{
+		col_min = mMatrix->getColFrom();
+		col_max = mMatrix->getColTo() - 1;
+	}
+
+	mColumnOffset = col_min;
+	mColumnTree.assign( col_max - col_min + 2, Candidate() );
+	mColumnBest.assign( col_max - col_min + 1, Candidate() );
+	mRowDots.clear();
+	mPreviousDots.clear();
+	mPreviousBest.clear();
+
+	Position previous_row = NO_POS;
+	Dot current_dot = 0;
+
+	//----------------------------------> main alignment loop <----------------------------------------------------
+	while (current_dot < mNDots)
+	{
+		const Position current_row = mPairRows[current_dot];
+
+		// previous row is too far up for a pair without gap in row
+		if (previous_row != current_row - 1)
+		{
+			addRow( mPreviousDots );
+			mPreviousDots.clear();
+			mPreviousBest.clear();
+		}
+
+		mRowDots.clear();
+		size_t p = 0;
+
+		for (; current_dot < mNDots && mPairRows[current_dot] == current_row; ++current_dot)
+		{
+			const Position current_col = mPairCols[current_dot];
+
+			debug_cerr( 6, "working on: dot=" << current_dot << " row=" << current_row << " col=" << current_col );
+
+			Candidate best;
+
+			// gaps in row and column
+			chooseCandidate( best, queryColumns( current_col - 2 ), current_dot );
+
+			// gap in row only
+			if (current_col - 1 >= col_min)
+				chooseCandidate( best, mColumnBest[current_col - 1 - col_min], current_dot );
+
+			// gap in column only and no gap
+			while (p < mPreviousDots.size() && mPairCols[mPreviousDots[p]] < current_col - 1)
+				++p;
+			if (p > 0)
+				chooseCandidate( best, mPreviousBest[p-1], current_dot );
+			if (p < mPreviousDots.size() && mPairCols[mPreviousDots[p]] == current_col - 1)
+				chooseCandidate( best,
+						Candidate( 0, current_row - 1, current_col - 1, mPreviousDots[p] ),
+						current_dot );
+
+			// only positive traces lead to current dot
+			Dot search_best_dot = NO_POS;
+			Score search_best_score = mPairScores[current_dot];
+			if (best.mDot != NO_POS && best.mKey >= 0)
+			{
+				search_best_dot = best.mDot;
+				search_best_score += best.mKey;
+			}
+
+			debug_cerr( 5, "search_best_dot=" << search_best_dot << " search_best_score=" << search_best_score );
+
+			// do local alignment, traces with score <= 0 are skipped
+			if (search_best_score < 0)
+				continue;
+
+			scores[current_dot] = search_best_score;
+			mTrace[current_dot] = search_best_dot;
+
+			if (search_best_score > 0)
+				mRowDots.push_back( current_dot );
+
+			// remember end point of best trace
+			if (search_best_score > global_best_score)
+			{
+				global_best_score = search_best_score;
+				global_best_dot   = current_dot;
+			}
+		}
+
+		// the previous row is now at least two rows up
+		addRow( mPreviousDots );
+		mPreviousDots.swap( mRowDots );
+
+		// prefix maxima for pairs with a gap in column only
+		mPreviousBest.resize( mPreviousDots.size() );
+		for (size_t i = 0; i < mPreviousDots.size(); ++i)
+		{
+			const Dot dot = mPreviousDots[i];
+			Candidate c( scores[dot] - mPairCols[dot] * mColGep, current_row, mPairCols[dot], dot );
+			if (i > 0 && mPreviousBest[i-1].isBetter( c ))
+				mPreviousBest[i] = mPreviousBest[i-1];
+			else
+				mPreviousBest[i] = c;
+		}
+		previous_row = current_row;
+
+	} // end of alignment loop
+
+	mLastDot= global_best_dot;
+	mScore  = global_best_score;
+
+	debug_cerr( 5, "global_best_dot=" << global_best_dot << " global_best_score=" << global_best_score )
+}
+
+} // namespace alignlib
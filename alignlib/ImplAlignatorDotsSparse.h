@@ -0,0 +1,158 @@
+/*
+  alignlib - a library for aligning protein sequences
+
+  $Id$
+
+  Copyright (C) 2026 Andreas Heger
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+*/
+
+#if HAVE_CONFIG_H
+#include <config.h>
+#endif
+
+#ifndef IMPL_ALIGNATOR_DOTS_SPARSE_H
+#define IMPL_ALIGNATOR_DOTS_SPARSE_H 1
+
+#include <vector>
+#include "alignlib_fwd.h"
+#include "ImplAlignatorDots.h"
+
+namespace alignlib
+{
+
+/** @short Dot-alignment using sparse dynamic programming.
+
+    This class computes the same alignments as @ref ImplAlignatorDots,
+    but does not scan all dots in the search region for each dot.
+
+    The affine gap cost between two dots depends only on whether
+    the gap in row and column is longer than one residue. Within
+    each of the four cases the best predecessor maximizes a key that
+    depends only on the predecessor, for example score - row * row_gep -
+    col * col_gep if both gaps are longer than one residue. The best
+    predecessor is thus found with a range-maximum query over columns
+    (a Fenwick tree) in O(log N) instead of O(N) per dot.
+
+    Subclasses of @ref ImplAlignatorDots that overload getGapCost
+    can not use this class.
+
+    @author Andreas Heger
+    @version $Id$
+*/
+class ImplAlignatorDotsSparse : public ImplAlignatorDots
+{
+ public:
+
+    /* constructors and destructors */
+
+	/** constructor */
+	ImplAlignatorDotsSparse();
+
+    /** set affine gap penalties
+     @param row_gop		gap opening penalty in row
+     @param row_gep		gap elongation penalty in row
+     @param col_gop		gap opening penalty in column, default = row
+     @param col_gep		gap elongation penalty in row, default = col
+
+    */
+	ImplAlignatorDotsSparse(
+			const HAlignator & dottor,
+			Score row_gop,
+    		Score row_gep,
+    		Score col_gop = 0,
+    		Score col_gep = 0 );
+
+    /** copy constructor */
+    ImplAlignatorDotsSparse( const ImplAlignatorDotsSparse & );
+
+    /** destructor */
+    virtual ~ImplAlignatorDotsSparse();
+
+    DEFINE_CLONE( HAlignator );
+
+    /** release memory kept between alignments */
+    virtual void trimWorkspace();
+
+ protected:
+
+    /** a candidate predecessor of a dot.
+     *
+     * Candidates are compared by key first. Ties are resolved
+     * in favour of the larger column and then the larger row,
+     * which is the order in which @ref ImplAlignatorDots scans
+     * its search region.
+     */
+    struct Candidate
+    {
+    	Candidate() : mKey(0), mRow(NO_POS), mCol(NO_POS), mDot(NO_POS) {}
+    	Candidate( Score key, Position row, Position col, Dot dot ) :
+    		mKey(key), mRow(row), mCol(col), mDot(dot) {}
+
+    	/** true, if this candidate is preferred over other */
+    	bool isBetter( const Candidate & other ) const
+    	{
+    		if (mDot == NO_POS) return false;
+    		if (other.mDot == NO_POS) return true;
+    		if (mKey != other.mKey) return mKey > other.mKey;
+    		if (mCol != other.mCol) return mCol > other.mCol;
+    		return mRow > other.mRow;
+    	}
+
+    	Score mKey;
+    	Position mRow;
+    	Position mCol;
+    	Dot mDot;
+    };
+
+    /** perform the alignment */
+    virtual void performAlignment(
+    		HAlignment & dest,
+    		const HAlignandum & row,
+    		const HAlignandum & col );
+
+    /** enter dots of a row into the search structures */
+    void addRow( const std::vector<Dot> & dots );
+
+    /** return the best candidate in a column smaller or equal to col */
+    Candidate queryColumns( Position col ) const;
+
+    /** replace best by candidate, if it leads to a better trace into dot */
+    void chooseCandidate( Candidate & best, const Candidate & candidate, Dot dot ) const;
+
+    /** Fenwick tree for maximum over columns of dots with gaps in row and column */
+    std::vector<Candidate> mColumnTree;
+
+    /** best dot in each column for dots with a gap in row only */
+    std::vector<Candidate> mColumnBest;
+
+    /** first column of the search structures */
+    Position mColumnOffset;
+
+    /** dots with positive score in the current row */
+    std::vector<Dot> mRowDots;
+
+    /** dots with positive score in the previous row */
+    std::vector<Dot> mPreviousDots;
+
+    /** prefix maxima of dots in the previous row */
+    std::vector<Candidate> mPreviousBest;
+};
+
+
+}
+
+#endif /* IMPL_ALIGNATOR_DOTS_SPARSE_H */
@@ -89,10 +89,10 @@ IMPLEMENT_CLONE( HAlignator, ImplAlignatorDotsWrap );
 Score ImplAlignatorDotsWrap::getGapCost( Dot x1, Dot x2 ) const
 {
 
-  Position c1 = (*mPairs)[x1].mCol;
-  Position c2 = (*mPairs)[x2].mCol;
-  Position r1 = (*mPairs)[x1].mRow;
-  Position r2 = (*mPairs)[x2].mRow;
+  Position c1 = mPairCols[x1];
+  Position c2 = mPairCols[x2];
+  Position r1 = mPairRows[x1];
+  Position r2 = mPairRows[x2];
 
   Score gap_cost = 0;
   Position d;
@@ -150,8 +150,8 @@ void ImplAlignatorDotsWrap::performAlignment(
   for ( idot = mRowIndices[1]; idot < mNDots; idot++ ) {	   /* iterate through nextrow starting at first position */
 
     if (idot < 0) continue;
-    row_res = (*mPairs)[idot].mRow;                           /* row_res = row */
-    col_res = (*mPairs)[idot].mCol;                           /* col_res = col, wrap around col */
+    row_res = mPairRows[idot];                           /* row_res = row */
+    col_res = mPairCols[idot];                           /* col_res = col, wrap around col */
 
     // some safety checks
 #ifdef SAVE
@@ -162,17 +162,17 @@ void ImplAlignatorDotsWrap::performAlignment(
 
 #ifdef DEBUG
     printf("--------------------------------------------\n");
-    printf("idot = %i, row_res = %i, col_res = %i, score = %5.2f\n", idot, row_res, col_res, (*mPairs)[idot].mScore);
+    printf("idot = %i, row_res = %i, col_res = %i, score = %5.2f\n", idot, row_res, col_res, mPairScores[idot]);
 #endif
     /* calculate top row */
     if ( (hdot < 0) ||           /* enter first time */
-	 (row_res > (*mPairs)[hdot].mRow) ) {  /* skip, if not in the same row as last time*/
+	 (row_res > mPairRows[hdot]) ) {  /* skip, if not in the same row as last time*/
 
 	topdot[row_res] = idot;
 	while( bestpercolstackptr > STACKEMPTY ) {
 	    xdot = bestpercolstack[--bestpercolstackptr];
-	    if ( (*mPairs)[xdot].mRow >= row_res ) break;                 /* stop, if entering current row */
-	    xcol = (*mPairs)[xdot].mCol;
+	    if ( mPairRows[xdot] >= row_res ) break;                 /* stop, if entering current row */
+	    xcol = mPairCols[xdot];
 	    if (xdot < 0 )            continue;             /* safety check */
 	    if (bestpercol[xcol] < 0)
 		bestpercol[xcol] = xdot;
@@ -187,8 +187,8 @@ void ImplAlignatorDotsWrap::performAlignment(
     xdot = mRowIndices[row_res - 1];
     sc = 0;
     while ( (xdot > -1)  &&
-	    ((*mPairs)[xdot].mRow == row_res - 1 ) &&  /* stop, if dot in previous row any more*/
-	    ((*mPairs)[xdot].mCol  < col_res - 1 )     /* end, if direct contact to new dot*/
+	    (mPairRows[xdot] == row_res - 1 ) &&  /* stop, if dot in previous row any more*/
+	    (mPairCols[xdot]  < col_res - 1 )     /* end, if direct contact to new dot*/
 	    ) {
 
       s = m[xdot] + getGapCost( xdot, idot);
@@ -235,8 +235,8 @@ void ImplAlignatorDotsWrap::performAlignment(
 	  sa=s;
 	  adot=xdot;
 	}
-	if ((*mPairs)[xdot].mRow > left) {
-	  left = (*mPairs)[xdot].mRow;
+	if (mPairRows[xdot] > left) {
+	  left = mPairRows[xdot];
 	}
 	if(left == row_res-2) break;
       }
@@ -260,7 +260,7 @@ void ImplAlignatorDotsWrap::performAlignment(
       sf = m[fdot] +
 	getGapCost( fdot, idot) +
 	getGapCost( fdot, idot);
-      if( (*mPairs)[fdot].mCol <= col_res)
+      if( mPairCols[fdot] <= col_res)
 	fcol = col_res + 1;
     } else
       sf=0;
@@ -280,8 +280,8 @@ void ImplAlignatorDotsWrap::performAlignment(
 	fdot = xdot;
       }
 
-      if ((*mPairs)[xdot].mRow > left) {
-	left = (*mPairs)[xdot].mRow;
+      if (mPairRows[xdot] > left) {
+	left = mPairRows[xdot];
       }
 
       if ( left == row_res-2 ) break;
@@ -290,7 +290,7 @@ void ImplAlignatorDotsWrap::performAlignment(
     fcol = mColLength + 1;
 
     /* update e = */
-    if ( (edot > -1 && (*mPairs)[edot].mCol <= col_res) || (edot < 0) ) {
+    if ( (edot > -1 && mPairCols[edot] <= col_res) || (edot < 0) ) {
       if ( row_res > 1 ) {
 	xdot = topdot[row_res-1];
       } else {
@@ -300,10 +300,10 @@ void ImplAlignatorDotsWrap::performAlignment(
       edot = -1;
       if (xdot >= 0) {
 	for ( xdot = 0; xdot < mNDots; xdot++ ) {
-	  if ((*mPairs)[xdot].mRow != row_res - 1 ) break;	/* since sorted by row first. check, if we leave the row */
-	  if ((*mPairs)[xdot].mCol < 1) continue;	/* since sorted by column inside a column */
-	  if ((*mPairs)[xdot].mCol > mColLength) break;
-	  if ((*mPairs)[xdot].mCol >  col_res) {
+	  if (mPairRows[xdot] != row_res - 1 ) break;	/* since sorted by row first. check, if we leave the row */
+	  if (mPairCols[xdot] < 1) continue;	/* since sorted by column inside a column */
+	  if (mPairCols[xdot] > mColLength) break;
+	  if (mPairCols[xdot] >  col_res) {
 	    s = m[xdot] + getGapCost( xdot, idot );
 	    if (s>se) {
 	      se=s;
@@ -344,7 +344,7 @@ void ImplAlignatorDotsWrap::performAlignment(
     }
 
     /* record mTraceback */
-    best += (*mPairs)[idot].mScore;
+    best += mPairScores[idot];
 
     if (best < 0) { /* local alignment, reset to zero or start new mTrace with single match */
       best    = 0 ;
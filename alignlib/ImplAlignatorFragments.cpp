@@ -23,8 +23,8 @@
 #include <iostream>
 #include <iomanip>
 #include <stdio.h>
+#include <algorithm>
 
-#include <map>
 #include "alignlib_fwd.h"
 #include "alignlib_interfaces.h"
 #include "AlignlibDebug.h"
@@ -43,30 +43,6 @@ namespace alignlib
 
 #define NOFRAGMENT -1
 
-struct BorderPosition
-{
-	BorderPosition() :
-		mRow(0), mTop(false), mFragment(NOFRAGMENT)
-	{
-	}
-	BorderPosition(Position row, bool top, Fragment fragment) :
-		mRow(row), mTop(top), mFragment(fragment)
-	{
-	}
-	Position mRow;
-	bool mTop;
-	Fragment mFragment;
-};
-
-class BorderComparator
-{
-public:
-	int operator()(const BorderPosition & x, const BorderPosition & y) const
-	{
-		return x.mRow < y.mRow;
-	}
-};
-
 /*---------------------factory functions ---------------------------------- */
 
 /** make an alignator object, which does a dot-alignment. The default version can be given an AlignmentMatrix-
@@ -111,6 +87,21 @@ ImplAlignatorFragments::ImplAlignatorFragments(
 
 IMPLEMENT_CLONE( HAlignator, ImplAlignatorFragments );
 
+//--------------------------------------------------------------------------------------------------------
+void ImplAlignatorFragments::trimWorkspace()
+{
+	debug_func_cerr(5);
+	std::vector<Score>().swap( mFragmentScores );
+	std::vector<Fragment>().swap( mStarts );
+	std::vector<Fragment>().swap( mEnds );
+	std::vector<Candidate>().swap( mColumnTree );
+	std::vector<Candidate>().swap( mColumnBest );
+	std::vector<Fragment>().swap( mPreviousFragments );
+	std::vector<Candidate>().swap( mPreviousBest );
+	std::vector<Candidate>().swap( mPreviousColumnBest );
+	ImplAlignator::trimWorkspace();
+}
+
 //--------------------------------------------------------------------------------------------------------
 ImplAlignatorFragments::~ImplAlignatorFragments()
 {
@@ -260,6 +251,91 @@ Score ImplAlignatorFragments::getGapCost(Dot x1, Dot x2) const
 	return gap_cost;
 }
 
+/** order fragments by start: row, column, index */
+class FragmentStartComparator
+{
+public:
+	FragmentStartComparator( const FragmentVector & fragments ) : mFragments( fragments ) {}
+	bool operator()( Fragment x, Fragment y ) const
+	{
+		const HAlignment & a = mFragments[x];
+		const HAlignment & b = mFragments[y];
+		if (a->getRowFrom() != b->getRowFrom()) return a->getRowFrom() < b->getRowFrom();
+		if (a->getColFrom() != b->getColFrom()) return a->getColFrom() < b->getColFrom();
+		return x < y;
+	}
+	const FragmentVector & mFragments;
+};
+
+/** order fragments by end: row, column, index */
+class FragmentEndComparator
+{
+public:
+	FragmentEndComparator( const FragmentVector & fragments ) : mFragments( fragments ) {}
+	bool operator()( Fragment x, Fragment y ) const
+	{
+		const HAlignment & a = mFragments[x];
+		const HAlignment & b = mFragments[y];
+		if (a->getRowTo() != b->getRowTo()) return a->getRowTo() < b->getRowTo();
+		if (a->getColTo() != b->getColTo()) return a->getColTo() < b->getColTo();
+		return x < y;
+	}
+	const FragmentVector & mFragments;
+};
+
+//----------------------------------------------------------------------------------------------------------
+void ImplAlignatorFragments::addFragment( Fragment fragment )
+{
+	const Score score = mFragmentScores[fragment];
+	if (score <= 0)
+		return;
+
+	const Position row = (*mFragments)[fragment]->getRowTo();
+	const Position col = (*mFragments)[fragment]->getColTo();
+	const Position tree_size = mColumnTree.size();
+
+	// gap in row only: key is independent of column
+	Candidate c( score - row * mRowGep, row, col, fragment );
+	if (c.isBetter( mColumnBest[col - mColumnOffset] ))
+		mColumnBest[col - mColumnOffset] = c;
+
+	// gap in row and column
+	c.mKey = score - row * mRowGep - col * mColGep;
+	for (Position i = col - mColumnOffset + 1; i < tree_size; i += i & -i)
+		if (c.isBetter( mColumnTree[i] ))
+			mColumnTree[i] = c;
+}
+
+//----------------------------------------------------------------------------------------------------------
+ImplAlignatorFragments::Candidate ImplAlignatorFragments::queryColumns( Position col ) const
+{
+	Candidate best;
+	if (col < mColumnOffset)
+		return best;
+
+	for (Position i = std::min( col - mColumnOffset + 1, (Position)mColumnTree.size() - 1); i > 0; i -= i & -i)
+		if (mColumnTree[i].isBetter( best ))
+			best = mColumnTree[i];
+
+	return best;
+}
+
+//----------------------------------------------------------------------------------------------------------
+void ImplAlignatorFragments::chooseCandidate(
+		Candidate & best,
+		const Candidate & candidate,
+		Fragment fragment ) const
+{
+	if (candidate.mFragment == NO_POS)
+		return;
+
+	// compute the score exactly with the gap cost
+	Candidate c( candidate );
+	c.mKey = mFragmentScores[c.mFragment] + getGapCost( c.mFragment, fragment );
+	if (c.isBetter( best ))
+		best = c;
+}
+
 //-------------------------------------------< Alignment subroutine >----------------------------------------------
 void ImplAlignatorFragments::performAlignment(HAlignment & ali,
 		const HAlignandum & prow, const HAlignandum & pcol)
@@ -268,135 +344,142 @@ void ImplAlignatorFragments::performAlignment(HAlignment & ali,
 	/**
 	 Overview over the algorithm:
 
-	 - proceed row-wise.
-	 - update score of path up to current fragment,
-	 if left border is touched.
-	 - add fragment to search-region, if bottom is
-	 higher than the current row.
-
+	 Fragments are processed by the row they start in. A fragment
+	 starting at (row, col) can follow a fragment ending before
+	 row and col. Gaps of one residue are not penalized, thus the
+	 best predecessor is the best of:
+
+	 1. fragments ending in row-1 and col-1: no gap.
+	 2. fragments ending in row-1 before col-1: gap in column only. Found
+	 	 by prefix maxima over the fragments ending in the previous row.
+	 3. fragments ending in col-1 before row-1: gap in row only. Found
+	 	 by keeping the best fragment for each column.
+	 4. fragments ending before row-1 and col-1: gaps in row and column.
+	 	 Found by a prefix maximum query in a Fenwick tree over columns.
+
+	 Fragments enter the structures for 3 and 4 once the
+	 current row is at least two rows below their end.
 	 */
-	// #define DEBUG
-	// #define DEBUG2
+
+	debug_func_cerr(5);
+
+	const FragmentVector & fragments = *mFragments;
 
 	Fragment global_best_fragment = NOFRAGMENT;
 	Score global_best_score = 0;
 
-	// fill borders with fragments
-	vector<BorderPosition> borders;
-	typedef vector<BorderPosition>::const_iterator BorderIterator;
-	for (Fragment i = 0; i < mNFragments; i++)
+	mFragmentScores.assign( mNFragments, 0 );
+
+	mStarts.resize( mNFragments );
+	mEnds.resize( mNFragments );
+	for (Fragment i = 0; i < mNFragments; ++i)
 	{
-		borders.push_back(BorderPosition((*mFragments)[i]->getRowFrom(), true,
-				i));
-		borders.push_back(
-				BorderPosition((*mFragments)[i]->getRowTo(), false, i));
+		mStarts[i] = i;
+		mEnds[i] = i;
+		mTrace[i] = NOFRAGMENT;
 	}
+	std::sort( mStarts.begin(), mStarts.end(), FragmentStartComparator( fragments ) );
+	std::sort( mEnds.begin(), mEnds.end(), FragmentEndComparator( fragments ) );
 
-	// sort borders according to row
-	sort(borders.begin(), borders.end(), BorderComparator());
-
-	// create data structure for search region
-	// sort fragments in search region by increasing column
-	typedef multimap<Position, Fragment> MyFragmentSet;
-	MyFragmentSet search_region;
-
-	// array with scores of fragments
-	vector<Score> scores(mNFragments, 0);
+	// setup search structures for the range of columns
+	Position col_min = 0;
+	Position col_max = -1;
+	for (Fragment i = 0; i < mNFragments; ++i)
+	{
+		const Position col = fragments[i]->getColTo();
+		if (i == 0 || col < col_min) col_min = col;
+		if (i == 0 || col > col_max) col_max = col;
+	}
 
-	// array with fragments in current row
-	vector<Fragment> fragment_stack;
+	mColumnOffset = col_min;
+	mColumnTree.assign( col_max - col_min + 2, Candidate() );
+	mColumnBest.assign( col_max - col_min + 1, Candidate() );
 
-	Position last_row = 0;
+	// mEnds[0:next_end] are in the search structures for gaps in row
+	Fragment next_end = 0;
 
 	//----------------------------------> main alignment loop <----------------------------------------------------
-	BorderIterator it(borders.begin()), it_end(borders.end());
-	for (; it != it_end; ++it)
+	Fragment current = 0;
+	while (current < mNFragments)
 	{
-
-		Fragment current_fragment = it->mFragment;
-		Position current_row = it->mRow;
-		bool is_top = it->mTop;
-
-#ifdef DEBUG
-		cout << "current_fragment=" << current_fragment << " current_row="
-				<< current_row << " is_top=" << is_top << endl;
-#endif
-
-		/* if a new row is entered, enter fragments from stack to search-area */
-		if (current_row != last_row)
+		const Position current_row = fragments[mStarts[current]]->getRowFrom();
+
+		// fragments ending at least two rows up
+		while (next_end < mNFragments && fragments[mEnds[next_end]]->getRowTo() < current_row - 1)
+			addFragment( mEnds[next_end++] );
+
+		// fragments ending in the previous row, sorted by column
+		mPreviousFragments.clear();
+		for (Fragment e = next_end;
+				e < mNFragments && fragments[mEnds[e]]->getRowTo() == current_row - 1; ++e)
+			if (mFragmentScores[mEnds[e]] > 0)
+				mPreviousFragments.push_back( mEnds[e] );
+
+		const size_t nprevious = mPreviousFragments.size();
+		mPreviousBest.resize( nprevious );
+		mPreviousColumnBest.resize( nprevious );
+		for (size_t i = 0; i < nprevious; ++i)
 		{
+			const Fragment f = mPreviousFragments[i];
+			const Position col = fragments[f]->getColTo();
+			Candidate c( mFragmentScores[f] - col * mColGep, current_row - 1, col, f );
+			if (i > 0 && mPreviousBest[i-1].isBetter( c ))
+				mPreviousBest[i] = mPreviousBest[i-1];
+			else
+				mPreviousBest[i] = c;
 
-			while (!fragment_stack.empty())
-			{
-				Fragment fragment = fragment_stack.back();
-				fragment_stack.pop_back();
-				search_region.insert(pair<Position, Fragment> (
-						(*mFragments)[fragment]->getColTo(), fragment));
-			}
-			last_row = current_row;
+			c.mKey = mFragmentScores[f];
+			if (i > 0 && fragments[mPreviousFragments[i-1]]->getColTo() == col &&
+					mPreviousColumnBest[i-1].isBetter( c ))
+				mPreviousColumnBest[i] = mPreviousColumnBest[i-1];
+			else
+				mPreviousColumnBest[i] = c;
 		}
 
-		if (is_top)
+		size_t p = 0;
+		for (; current < mNFragments && fragments[mStarts[current]]->getRowFrom() == current_row; ++current)
 		{
-			/* search search-area: always lookup starting at col 1 until current_col - 1. Try to find
-			 a positive trace leading to current fragment. If it were negative, it would not be part of
-			 the optimum alignment up to current_fragment. */
-			Fragment search_best_fragment = NOFRAGMENT;
-			Position current_col =
-					(*mFragments)[current_fragment]->getColFrom();
-			Score search_best_score = 0;
-
-#ifdef DEBUG2
-			cout << "SEARCH_AREA" << endl;
-			for (MyFragmentSet::iterator search_it = search_region.begin(); search_it != search_region.end(); ++search_it)
-			cout << "  [" << (*search_it).first << ", " << (*search_it).second << "]"
-			<< "=" << scores[(*search_it).second]
-			<< " " << mTrace[(*search_it).second]
-			<< endl;
-#endif
+			const Fragment current_fragment = mStarts[current];
+			const Position current_col = fragments[current_fragment]->getColFrom();
 
-			MyFragmentSet::const_iterator search_it(search_region.begin()),
-					search_it_end(search_region.end());
-			while (search_it != search_it_end && ((*search_it).first
-					< current_col))
-			{
+			debug_cerr( 6, "working on: fragment=" << current_fragment << " row=" << current_row << " col=" << current_col );
 
-				Fragment const search_fragment = (*search_it).second;
-				Score search_score = scores[search_fragment];
-
-				if (search_score > 0)
-				{
-					search_score += getGapCost(search_fragment,
-							current_fragment);
-					if (search_score >= search_best_score)
-					{
-						search_best_score = search_score;
-						search_best_fragment = search_fragment;
-					}
-				}
-
-				++search_it;
-			}
+			Candidate best;
 
-			/* no positive trace found, new trace starts at current fragment */
-			if (search_best_fragment == NOFRAGMENT)
-				search_best_score = (*mFragments)[current_fragment]->getScore();
-			else
-				search_best_score
-						+= (*mFragments)[current_fragment]->getScore();
+			// gaps in row and column
+			chooseCandidate( best, queryColumns( current_col - 2 ), current_fragment );
 
-#ifdef DEBUG
-			cout << "current_fragment=" << current_fragment << " current_row="
-					<< current_row << " current_col=" << current_col << endl;
-			cout << "search_best_fragment=" << search_best_fragment
-					<< " search_best_score=" << search_best_score << endl;
-#endif
+			// gap in row only
+			if (current_col - 1 >= col_min && current_col - 1 <= col_max)
+				chooseCandidate( best, mColumnBest[current_col - 1 - col_min], current_fragment );
+
+			// gap in column only and no gap
+			while (p < nprevious && fragments[mPreviousFragments[p]]->getColTo() < current_col - 1)
+				++p;
+			if (p > 0)
+				chooseCandidate( best, mPreviousBest[p-1], current_fragment );
+			size_t q = p;
+			while (q < nprevious && fragments[mPreviousFragments[q]]->getColTo() == current_col - 1)
+				++q;
+			if (q > p)
+				chooseCandidate( best, mPreviousColumnBest[q-1], current_fragment );
+
+			/* only positive traces lead to current fragment */
+			Fragment search_best_fragment = NOFRAGMENT;
+			Score search_best_score = fragments[current_fragment]->getScore();
+			if (best.mFragment != NO_POS && best.mKey >= 0)
+			{
+				search_best_fragment = best.mFragment;
+				search_best_score += best.mKey;
+			}
+
+			debug_cerr( 5, "search_best_fragment=" << search_best_fragment << " search_best_score=" << search_best_score );
 
 			/* do local alignment, traces with score <= 0 are skipped */
 			if (search_best_score < 0)
 				continue;
 
-			scores[current_fragment] = search_best_score;
+			mFragmentScores[current_fragment] = search_best_score;
 			mTrace[current_fragment] = search_best_fragment;
 
 			/* remember end point of best trace */
@@ -405,13 +488,6 @@ void ImplAlignatorFragments::performAlignment(HAlignment & ali,
 				global_best_score = search_best_score;
 				global_best_fragment = current_fragment;
 			}
-
-		}
-		else
-		{
-			/* add fragment to list of fragments, that are to be added to the
-			 search area, once the current row has finished */
-			fragment_stack.push_back(current_fragment);
 		}
 	}
 	/* ---->end of alignment loop<----- */
@@ -419,14 +495,7 @@ void ImplAlignatorFragments::performAlignment(HAlignment & ali,
 	mLastFragment = global_best_fragment;
 	mScore = global_best_score;
 
-#ifdef DEBUG
-	cout << "global_best_fragment=" << global_best_fragment
-			<< " global_best_score=" << global_best_score << endl;
-#endif
-
-	//--------------> cleaning up <---------------------------------------------------------------
-	//--------------------------------------------------------------------------------------------------
-
+	debug_cerr( 5, "global_best_fragment=" << global_best_fragment << " global_best_score=" << global_best_score );
 }
 
 } // namespace alignlib
@@ -27,6 +27,7 @@
 #ifndef IMPL_ALIGNATOR_FRAGMENTS_H
 #define IMPL_ALIGNATOR_FRAGMENTS_H 1
 
+#include <vector>
 #include "alignlib_fwd.h"
 #include "alignlib_fwd.h"
 #include "ImplAlignator.h"
@@ -47,6 +48,14 @@ namespace alignlib
     The difference to @ref ImplAlignatorDots is that a fragment is longer than a
     dot.
 
+    Fragments are chained by sweeping over them by row. A fragment can
+    follow another, if it starts in a later row and a later column than
+    the other ends. As in @ref ImplAlignatorDotsSparse, the best predecessor
+    is found with a range-maximum query over the column ends of the
+    fragments that are at least two rows further up (a Fenwick tree),
+    and with prefix maxima over the fragments ending in the previous row.
+    Thus n fragments are chained in O(n log n).
+
     @author Andreas Heger
     @version $Id: ImplAlignatorFragments.h,v 1.3 2004/03/19 18:23:41 aheger Exp $
 */
@@ -81,6 +90,9 @@ class ImplAlignatorFragments : public ImplAlignator
 
     DEFINE_CLONE( HAlignator );
 
+    /** release memory kept between alignments */
+    virtual void trimWorkspace();
+
     /* operators------------------------------------------------------------------------------ */
     /** method for aligning two arbitrary objects */
     virtual void align( HAlignment & dest,
@@ -114,6 +126,43 @@ class ImplAlignatorFragments : public ImplAlignator
 
  protected:
 
+    /** a candidate predecessor of a fragment.
+     *
+     * Candidates are compared by key first. Ties are resolved
+     * in favour of the larger column and then the larger row,
+     * at which the candidate ends.
+     */
+    struct Candidate
+    {
+    	Candidate() : mKey(0), mRow(NO_POS), mCol(NO_POS), mFragment(NO_POS) {}
+    	Candidate( Score key, Position row, Position col, Fragment fragment ) :
+    		mKey(key), mRow(row), mCol(col), mFragment(fragment) {}
+
+    	/** true, if this candidate is preferred over other */
+    	bool isBetter( const Candidate & other ) const
+    	{
+    		if (mFragment == NO_POS) return false;
+    		if (other.mFragment == NO_POS) return true;
+    		if (mKey != other.mKey) return mKey > other.mKey;
+    		if (mCol != other.mCol) return mCol > other.mCol;
+    		return mRow > other.mRow;
+    	}
+
+    	Score mKey;
+    	Position mRow;
+    	Position mCol;
+    	Fragment mFragment;
+    };
+
+    /** enter a fragment with gaps in row into the search structures */
+    void addFragment( Fragment fragment );
+
+    /** return the best candidate ending in a column smaller or equal to col */
+    Candidate queryColumns( Position col ) const;
+
+    /** replace best by candidate, if it leads to a better trace into fragment */
+    void chooseCandidate( Candidate & best, const Candidate & candidate, Fragment fragment ) const;
+
     /** perform the alignment */
     virtual void performAlignment( HAlignment & dest,
     		const HAlignandum & row,
@@ -176,6 +225,33 @@ class ImplAlignatorFragments : public ImplAlignator
     /** maximum length of a column */
     Position mColLength;
 
+    /** scores of traces ending in each fragment */
+    std::vector<Score> mFragmentScores;
+
+    /** fragments sorted by start */
+    std::vector<Fragment> mStarts;
+
+    /** fragments sorted by end */
+    std::vector<Fragment> mEnds;
+
+    /** Fenwick tree for maximum over columns of fragments with gaps in row and column */
+    std::vector<Candidate> mColumnTree;
+
+    /** best fragment ending in each column for fragments with a gap in row only */
+    std::vector<Candidate> mColumnBest;
+
+    /** first column of the search structures */
+    Position mColumnOffset;
+
+    /** fragments with positive score ending in the previous row, sorted by column */
+    std::vector<Fragment> mPreviousFragments;
+
+    /** prefix maxima of fragments in the previous row */
+    std::vector<Candidate> mPreviousBest;
+
+    /** best fragment in the previous row ending in the same column */
+    std::vector<Candidate> mPreviousColumnBest;
+
 };
 
 
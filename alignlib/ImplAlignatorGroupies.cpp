@@ -83,13 +83,21 @@ ImplAlignatorGroupies::~ImplAlignatorGroupies()
 
 ImplAlignatorGroupies::ImplAlignatorGroupies(const ImplAlignatorGroupies & src) :
 	ImplAlignator(src), mTubeSize(src.mTubeSize), mTupleSize(src.mTupleSize),
-			mAlignatorDots(src.mAlignatorDots), mAlignatorGaps(
-					src.mAlignatorGaps), mGop(src.mGop), mGep(src.mGep)
+			mAlignatorDots(src.mAlignatorDots->getClone()), mAlignatorGaps(
+					src.mAlignatorGaps->getClone()), mGop(src.mGop), mGep(src.mGep)
 {
 }
 
 IMPLEMENT_CLONE( HAlignator, ImplAlignatorGroupies);
 
+void ImplAlignatorGroupies::trimWorkspace()
+{
+	debug_func_cerr(5);
+	mAlignatorDots->trimWorkspace();
+	mAlignatorGaps->trimWorkspace();
+	ImplAlignator::trimWorkspace();
+}
+
 void ImplAlignatorGroupies::align(HAlignment & result, const HAlignandum & row,
 		const HAlignandum & col)
 {
@@ -88,6 +88,9 @@ namespace alignlib
 
       DEFINE_CLONE( HAlignator );
 
+      /** release work space of the helper alignators */
+      virtual void trimWorkspace();
+
     protected:
       /** perform the alignment.
       */
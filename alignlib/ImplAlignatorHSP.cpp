@@ -0,0 +1,347 @@
+/*
+  alignlib - a library for aligning protein sequences
+
+  $Id$
+
+  Copyright (C) 2026 Andreas Heger
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+ */
+
+#include <iostream>
+#include <iomanip>
+#include <algorithm>
+#include "alignlib_fwd.h"
+#include "alignlib_interfaces.h"
+#include "AlignlibDebug.h"
+#include "AlignlibException.h"
+#include "Alignandum.h"
+#include "Alignment.h"
+#include "ImplAlignatorHSP.h"
+#include "AlignmentIterator.h"
+#include "HelpersAlignment.h"
+#include "Iterator2D.h"
+#include "Scorer.h"
+#include "HelpersIterator2D.h"
+#include "HelpersAlignator.h"
+#include "HelpersToolkit.h"
+
+using namespace std;
+
+namespace alignlib
+{
+
+HAlignator makeAlignatorHSP(
+		const HAlignator & alignator_dots,
+		const HAlignator & alignator_gapped,
+		const Position tuple_size,
+		const Position window,
+		const Score xdrop,
+		const Score min_score,
+		const Diagonal band )
+{
+	return HAlignator(new ImplAlignatorHSP(alignator_dots, alignator_gapped,
+			tuple_size, window, xdrop, min_score, band));
+}
+
+/** return alignator as ImplAlignatorHSP or throw */
+static HImplAlignatorHSP toAlignatorHSP( const HAlignator & alignator )
+{
+	HImplAlignatorHSP a(boost::dynamic_pointer_cast< ImplAlignatorHSP, Alignator >( alignator ));
+	if (!a)
+		THROW( "alignator has not been created by makeAlignatorHSP" );
+	return a;
+}
+
+HSPCounts getHSPCounts( const HAlignator & alignator )
+{
+	return toAlignatorHSP( alignator )->getCounts();
+}
+
+void resetHSPCounts( const HAlignator & alignator )
+{
+	toAlignatorHSP( alignator )->resetCounts();
+}
+
+//---------------------------------------------------------< constructors and destructors >--------------------------------------
+ImplAlignatorHSP::ImplAlignatorHSP() :
+	ImplAlignator(),
+	mAlignatorDots(getToolkit()->getAlignator()),
+	mAlignatorGapped(getToolkit()->getAlignator()->getClone()),
+	mTupleSize(3), mWindow(40),
+	mXDrop(20), mMinScore(30), mBand(16),
+	mDots(makeAlignmentMatrixUnsorted()),
+	mGapped(makeAlignmentVector())
+{
+	debug_func_cerr(5);
+	mAlignatorGapped->cloneToolkit();
+}
+
+ImplAlignatorHSP::ImplAlignatorHSP(
+		const HAlignator & alignator_dots,
+		const HAlignator & alignator_gapped,
+		const Position tuple_size,
+		const Position window,
+		const Score xdrop,
+		const Score min_score,
+		const Diagonal band ) :
+	ImplAlignator(),
+	mAlignatorDots(alignator_dots),
+	mAlignatorGapped(alignator_gapped->getClone()),
+	mTupleSize(tuple_size), mWindow(window),
+	mXDrop(xdrop), mMinScore(min_score), mBand(band),
+	mDots(makeAlignmentMatrixUnsorted()),
+	mGapped(makeAlignmentVector())
+{
+	debug_func_cerr(5);
+	// the iterator of the gapped alignator is changed for each HSP
+	mAlignatorGapped->cloneToolkit();
+}
+
+ImplAlignatorHSP::~ImplAlignatorHSP()
+{
+	debug_func_cerr(5);
+}
+
+ImplAlignatorHSP::ImplAlignatorHSP(const ImplAlignatorHSP & src) :
+	ImplAlignator(src),
+	mAlignatorDots(src.mAlignatorDots->getClone()),
+	mAlignatorGapped(src.mAlignatorGapped->getClone()),
+	mTupleSize(src.mTupleSize), mWindow(src.mWindow),
+	mXDrop(src.mXDrop), mMinScore(src.mMinScore), mBand(src.mBand),
+	mCounts(src.mCounts),
+	mDots(makeAlignmentMatrixUnsorted()),
+	mGapped(makeAlignmentVector())
+{
+	debug_func_cerr(5);
+	mAlignatorGapped->cloneToolkit();
+}
+
+IMPLEMENT_CLONE( HAlignator, ImplAlignatorHSP);
+
+void ImplAlignatorHSP::startBatch( const HAlignandum & query,
+		const AlignandumVector & targets )
+{
+	debug_func_cerr(5);
+	ImplAlignator::startBatch( query, targets );
+
+	// let the helpers pre-compute data for the query
+	boost::shared_ptr<ImplAlignator> dots( boost::dynamic_pointer_cast<ImplAlignator, Alignator>(mAlignatorDots) );
+	if (dots)
+		dots->startBatch( query, targets );
+	boost::shared_ptr<ImplAlignator> gapped( boost::dynamic_pointer_cast<ImplAlignator, Alignator>(mAlignatorGapped) );
+	if (gapped)
+		gapped->startBatch( query, targets );
+}
+
+void ImplAlignatorHSP::finishBatch()
+{
+	debug_func_cerr(5);
+
+	boost::shared_ptr<ImplAlignator> dots( boost::dynamic_pointer_cast<ImplAlignator, Alignator>(mAlignatorDots) );
+	if (dots)
+		dots->finishBatch();
+	boost::shared_ptr<ImplAlignator> gapped( boost::dynamic_pointer_cast<ImplAlignator, Alignator>(mAlignatorGapped) );
+	if (gapped)
+		gapped->finishBatch();
+
+	ImplAlignator::finishBatch();
+}
+
+void ImplAlignatorHSP::trimWorkspace()
+{
+	debug_func_cerr(5);
+	mAlignatorDots->trimWorkspace();
+	mAlignatorGapped->trimWorkspace();
+	mDots->clear();
+	mGapped->clear();
+	std::vector<Seed>().swap( mSeeds );
+	std::vector<Segment>().swap( mSegments );
+	ImplAlignator::trimWorkspace();
+}
+
+const HSPCounts & ImplAlignatorHSP::getCounts() const
+{
+	return mCounts;
+}
+
+void ImplAlignatorHSP::resetCounts()
+{
+	mCounts = HSPCounts();
+}
+
+void ImplAlignatorHSP::resetStatistics()
+{
+	resetCounts();
+}
+
+void ImplAlignatorHSP::addStatistics( const ImplAlignator & other )
+{
+	const ImplAlignatorHSP * hsp = dynamic_cast<const ImplAlignatorHSP*>( &other );
+	if (!hsp)
+		return;
+	mCounts.mNumSeeds += hsp->mCounts.mNumSeeds;
+	mCounts.mNumTwoHits += hsp->mCounts.mNumTwoHits;
+	mCounts.mNumHSPs += hsp->mCounts.mNumHSPs;
+	mCounts.mNumExtensions += hsp->mCounts.mNumExtensions;
+}
+
+//-------------------------------------------------------------------------------------------------------------------------------
+ImplAlignatorHSP::Segment ImplAlignatorHSP::extendSeed(
+		Diagonal diagonal, Position row,
+		const HAlignandum & row_sequence,
+		const HAlignandum & col_sequence ) const
+{
+	const Position row_from = std::max( (Diagonal)row_sequence->getFrom(), col_sequence->getFrom() - diagonal );
+	const Position row_to = std::min( (Diagonal)row_sequence->getTo(), col_sequence->getTo() - diagonal );
+
+	Segment segment;
+	segment.mDiagonal = diagonal;
+
+	// extend to the right including the seed
+	Score score = 0;
+	Score best_right = 0;
+	segment.mTo = row;
+	for (Position x = row; x < row_to; ++x)
+	{
+		score += mScorer->getScore( x, x + diagonal );
+		if (score > best_right)
+		{
+			best_right = score;
+			segment.mTo = x + 1;
+		}
+		else if (best_right - score > mXDrop)
+			break;
+	}
+
+	// extend to the left
+	score = 0;
+	Score best_left = 0;
+	segment.mFrom = row;
+	for (Position x = row - 1; x >= row_from; --x)
+	{
+		score += mScorer->getScore( x, x + diagonal );
+		if (score > best_left)
+		{
+			best_left = score;
+			segment.mFrom = x;
+		}
+		else if (best_left - score > mXDrop)
+			break;
+	}
+
+	segment.mScore = best_left + best_right;
+	return segment;
+}
+
+//-------------------------------------------------------------------------------------------------------------------------------
+void ImplAlignatorHSP::align(HAlignment & result,
+		const HAlignandum & row,
+		const HAlignandum & col)
+{
+	debug_func_cerr(5);
+
+	startUp(result, row, col);
+
+	// 1. collect seeds
+	mAlignatorDots->align(mDots, row, col);
+
+	mSeeds.clear();
+	for (AlignmentIterator it = mDots->begin(); it != mDots->end(); ++it)
+	{
+		Seed seed;
+		seed.mDiagonal = it->mCol - it->mRow;
+		seed.mRow = it->mRow;
+		mSeeds.push_back( seed );
+	}
+	mCounts.mNumSeeds += mSeeds.size();
+
+	// 2. bin seeds by diagonal and extend two-hits without gaps
+	std::sort( mSeeds.begin(), mSeeds.end() );
+
+	mSegments.clear();
+	size_t x = 0;
+	while (x < mSeeds.size())
+	{
+		const Diagonal diagonal = mSeeds[x].mDiagonal;
+		Position last_hit = NO_POS;
+		Position extended_to = NO_POS;
+
+		for (; x < mSeeds.size() && mSeeds[x].mDiagonal == diagonal; ++x)
+		{
+			const Position hit = mSeeds[x].mRow;
+
+			// skip seeds within a segment that has been extended
+			if (hit < extended_to)
+				continue;
+
+			if (last_hit == NO_POS || hit - last_hit > mWindow)
+			{
+				last_hit = hit;
+				continue;
+			}
+
+			// overlapping seeds do not count as two hits
+			if (hit - last_hit < mTupleSize)
+				continue;
+
+			++mCounts.mNumTwoHits;
+			Segment segment(extendSeed( diagonal, hit, row, col ));
+			extended_to = std::max( segment.mTo, hit + 1 );
+			last_hit = NO_POS;
+
+			if (segment.mScore >= mMinScore)
+				mSegments.push_back( segment );
+		}
+	}
+	mCounts.mNumHSPs += mSegments.size();
+
+	debug_cerr( 5, "-> seeds=" << mSeeds.size() << " hsps=" << mSegments.size() );
+
+	// 3. extend HSPs with gaps, starting with the best
+	std::sort( mSegments.begin(), mSegments.end() );
+
+	Score best_score = 0;
+	std::vector<HAlignment> extended;
+	for (size_t s = 0; s < mSegments.size(); ++s)
+	{
+		const Segment & segment = mSegments[s];
+
+		// skip HSPs that are part of a previous gapped alignment
+		const Position middle = (segment.mFrom + segment.mTo) / 2;
+		bool done = false;
+		for (size_t e = 0; e < extended.size() && !done; ++e)
+			done = extended[e]->mapRowToCol( middle ) == middle + segment.mDiagonal;
+		if (done)
+			continue;
+
+		++mCounts.mNumExtensions;
+		mAlignatorGapped->getToolkit()->setIterator2D(
+				makeIterator2DBanded( segment.mDiagonal - mBand, segment.mDiagonal + mBand ) );
+		mAlignatorGapped->align( mGapped, row, col );
+
+		if (mGapped->getScore() > best_score)
+		{
+			best_score = mGapped->getScore();
+			copyAlignment( result, mGapped );
+			result->setScore( best_score );
+		}
+		extended.push_back( mGapped->getClone() );
+	}
+
+	cleanUp(result, row, col);
+}
+
+} // namespace alignlib
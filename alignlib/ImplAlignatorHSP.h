@@ -0,0 +1,211 @@
+/*
+  alignlib - a library for aligning protein sequences
+
+  $Id$
+
+  Copyright (C) 2026 Andreas Heger
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+*/
+
+
+#if HAVE_CONFIG_H
+#include <config.h>
+#endif
+
+#ifndef IMPL_ALIGNATOR_HSP_H
+#define IMPL_ALIGNATOR_HSP_H 1
+
+#include <vector>
+#include "alignlib_fwd.h"
+#include "ImplAlignator.h"
+#include "HelpersAlignator.h"
+
+namespace alignlib
+{
+  /**
+     @short Seed-and-extend alignment via high-scoring segment pairs (HSP).
+
+     This @ref Alignator proceeds in the following way:
+
+     1. Build dots for both sequences, typically using a k-tuple dottor
+     (@ref ImplAlignatorTuples). Each dot is a seed.
+
+     2. Bin seeds by diagonal. A diagonal triggers an extension, if
+     it has two seeds at least mTupleSize and at most mWindow residues
+     apart (two-hit criterion).
+
+     3. Extend the second seed without gaps in both directions using
+     the @ref Scorer. The extension stops when the score drops more than
+     mXDrop below the best score. Seeds inside an extended segment
+     are skipped.
+
+     4. Segments scoring at least mMinScore are HSPs. Starting from the
+     best HSP, align row and col with mAlignatorGapped within a band of
+     mBand diagonals around the HSP. HSPs already aligned by a previous
+     gapped extension are skipped.
+
+     The alignment with the best score is returned. If there are no
+     HSPs, the alignment is empty.
+
+     The number of seeds, two-hits, HSPs and gapped extensions are
+     counted over all alignments, see @ref getHSPCounts. The counts
+     of a @ref searchDatabase are added to the alignator passed to it.
+
+     @author Andreas Heger
+     @version $Id$
+  */
+
+  class ImplAlignatorHSP : public ImplAlignator
+    {
+      /* class member functions-------------------------------------------------------------- */
+    public:
+      /* constructors and desctructors------------------------------------------------------- */
+
+      /** empty constructor */
+      ImplAlignatorHSP();
+
+      /** constructor
+       *
+       * @param alignator_dots		@ref Alignator to build seeds.
+       * @param alignator_gapped	@ref Alignator for gapped extension.
+       * @param tuple_size			minimum distance between two seeds.
+       * @param window				maximum distance between two seeds.
+       * @param xdrop				X-drop for ungapped extension.
+       * @param min_score			minimum score of an HSP.
+       * @param band				band width for gapped extension.
+       */
+      ImplAlignatorHSP(
+    		  const HAlignator & alignator_dots,
+    		  const HAlignator & alignator_gapped,
+    		  const Position tuple_size,
+    		  const Position window,
+    		  const Score xdrop,
+    		  const Score min_score,
+    		  const Diagonal band );
+
+      /** destructor */
+      virtual ~ImplAlignatorHSP ();
+
+      /** copy constructor */
+      ImplAlignatorHSP( const ImplAlignatorHSP & src);
+
+      DEFINE_CLONE( HAlignator );
+
+      /** forward the batch to the helper alignators */
+      virtual void startBatch( const HAlignandum & query,
+    		  const AlignandumVector & targets );
+
+      /** finish the batch in the helper alignators */
+      virtual void finishBatch();
+
+      /** release work space of the helper alignators */
+      virtual void trimWorkspace();
+
+      /** return counts accumulated since construction or the last reset */
+      const HSPCounts & getCounts() const;
+
+      /** reset counts */
+      void resetCounts();
+
+      /** reset counts */
+      virtual void resetStatistics();
+
+      /** add counts of other, if it is an ImplAlignatorHSP object */
+      virtual void addStatistics( const ImplAlignator & other );
+
+    protected:
+      /** perform the alignment.
+      */
+      virtual void align( HAlignment & ali,
+    		  const HAlignandum & row,
+    		  const HAlignandum & col );
+
+      /** a seed on a diagonal */
+      struct Seed
+      {
+    	  Diagonal mDiagonal;
+    	  Position mRow;
+    	  bool operator<( const Seed & other ) const
+    	  {
+    		  if (mDiagonal != other.mDiagonal) return mDiagonal < other.mDiagonal;
+    		  return mRow < other.mRow;
+    	  }
+      };
+
+      /** an ungapped segment on a diagonal, rows from mFrom to mTo */
+      struct Segment
+      {
+    	  Diagonal mDiagonal;
+    	  Position mFrom;
+    	  Position mTo;
+    	  Score mScore;
+    	  bool operator<( const Segment & other ) const
+    	  {
+    		  if (mScore != other.mScore) return mScore > other.mScore;
+    		  if (mFrom != other.mFrom) return mFrom < other.mFrom;
+    		  return mDiagonal < other.mDiagonal;
+    	  }
+      };
+
+      /** extend seed at row on diagonal without gaps */
+      Segment extendSeed( Diagonal diagonal, Position row,
+    		  const HAlignandum & row_sequence,
+    		  const HAlignandum & col_sequence ) const;
+
+    private:
+
+    	/** Alignator to use to build seeds */
+    	HAlignator mAlignatorDots;
+
+    	/** Alignator to use for gapped extension */
+    	HAlignator mAlignatorGapped;
+
+    	/** minimum distance between two seeds */
+    	Position mTupleSize;
+
+    	/** maximum distance between two seeds */
+    	Position mWindow;
+
+    	/** X-drop for ungapped extension */
+    	Score mXDrop;
+
+    	/** minimum score of an HSP */
+    	Score mMinScore;
+
+    	/** band width around HSP in gapped extension */
+    	Diagonal mBand;
+
+    	/** counts */
+    	HSPCounts mCounts;
+
+    	/** buffer for dots */
+    	HAlignment mDots;
+
+    	/** buffer for gapped alignment */
+    	HAlignment mGapped;
+
+    	/** buffer for seeds */
+    	std::vector<Seed> mSeeds;
+
+    	/** buffer for HSPs */
+    	std::vector<Segment> mSegments;
+    };
+
+  typedef boost::shared_ptr<ImplAlignatorHSP>HImplAlignatorHSP;
+
+}
+
+#endif /* IMPL_ALIGNATOR_HSP_H */
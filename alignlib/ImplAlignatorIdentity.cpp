@@ -24,6 +24,7 @@
 #include <iostream>
 #include <iomanip>
 #include <math.h>
+#include <algorithm>
 #include "alignlib_fwd.h"
 #include "alignlib_interfaces.h"
 #include "AlignlibDebug.h"
@@ -55,6 +56,15 @@ ImplAlignatorIdentity::ImplAlignatorIdentity (const ImplAlignatorIdentity & src
 
 IMPLEMENT_CLONE( HAlignator, ImplAlignatorIdentity)
 
+void ImplAlignatorIdentity::trimWorkspace()
+{
+	debug_func_cerr(5);
+	std::vector<Residue>().swap( mColResidues );
+	std::vector<Position>().swap( mCols );
+	std::vector<ResiduePair>().swap( mDots );
+	ImplAlignator::trimWorkspace();
+}
+
 //--------------------------------------------------------------------------------------------------------
 void ImplAlignatorIdentity::align(
 		HAlignment & result,
@@ -73,27 +83,38 @@ void ImplAlignatorIdentity::align(
 
 	HIterator2D it2d(mIterator->getNew( row, col ));
 
+	// copy column residues, indexed by position
+	const Position col_from = *it2d->col_begin();
+	const Position col_to = *it2d->col_end();
+	mColResidues.resize( std::max( col_to, 0 ) );
+	for (Position c = col_from; c < col_to; ++c)
+		mColResidues[c] = col->asResidue(c);
+	const Residue * residues = mColResidues.empty() ? NULL : &mColResidues[0];
+
 	Iterator2D::const_iterator rit(it2d->row_begin()), rend(it2d->row_end());
+	mDots.clear();
 
 	for (; rit != rend; ++rit)
 	{
 		Position r = *rit;
 
-		if (row->asResidue(r) != mask_code)
-		{
-			Iterator2D::const_iterator cit(it2d->col_begin(r)), cend(it2d->col_end(r));
-			for (; cit != cend; ++cit)
-			{
-				Position c = *cit;
-				if (row->asResidue(r) == col->asResidue(c))
-				{
-					result->addPair( ResiduePair( r, c, 1) );
-					total_score += 1;
-				}
-			}
-		}
+		const Residue residue = row->asResidue(r);
+		if (residue == mask_code)
+			continue;
+
+		mCols.clear();
+		findResidues( residues,
+				*it2d->col_begin(r), *it2d->col_end(r),
+				&residue, 1, mCols );
+
+		for (size_t x = 0; x < mCols.size(); ++x)
+			mDots.push_back( ResiduePair( r, mCols[x], 1) );
 	}
 
+	if (!mDots.empty())
+		result->addPairs( &mDots[0], mDots.size(), true );
+	total_score = mDots.size();
+
 	result->setScore( total_score );
 
 	cleanUp(result, row, col );
@@ -28,6 +28,7 @@
 #ifndef IMPL_ALIGNATOR_IDENTITY_H
 #define IMPL_ALIGNATOR_IDENTITY_H 1
 
+#include <vector>
 #include "alignlib_fwd.h"
 #include "ImplAlignator.h"
 
@@ -38,6 +39,10 @@ class Alignandum;
 
 /** @short align identical residues (dot-matrix creation).
 
+    The residues of col are copied into a buffer. Each row residue
+    is then compared to many column residues at once, see
+    @ref ImplAlignator::findResidues.
+
     @author Andreas Heger
     @version $Id: ImplAlignatorIdentity.h,v 1.3 2004/03/19 18:23:41 aheger Exp $
 */
@@ -60,6 +65,19 @@ class ImplAlignatorIdentity : public ImplAlignator
     		const HAlignandum & row, const HAlignandum & col );
 
     DEFINE_CLONE(HAlignator);
+
+    /** release memory kept between alignments */
+    virtual void trimWorkspace();
+
+ protected:
+    /** residues of col */
+    std::vector<Residue> mColResidues;
+
+    /** columns identical to the current row */
+    std::vector<Position> mCols;
+
+    /** dots, sorted by row and column */
+    std::vector<ResiduePair> mDots;
 };
 
 }
@@ -72,6 +72,13 @@ namespace alignlib
 
   IMPLEMENT_CLONE( HAlignator, ImplAlignatorIterative )
 
+  void ImplAlignatorIterative::trimWorkspace()
+  {
+      debug_func_cerr(5);
+      mAlignator->trimWorkspace();
+      ImplAlignator::trimWorkspace();
+  }
+
   void ImplAlignatorIterative::align(
 		  HAlignment & result,
 		  const HAlignandum & row,
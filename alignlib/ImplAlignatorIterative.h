@@ -58,6 +58,9 @@ namespace alignlib
       /** method for aligning two arbitrary objects */
       virtual void align( HAlignment &, const HAlignandum &, const HAlignandum & );
 
+      /** release work space of the helper alignator */
+      virtual void trimWorkspace();
+
    protected:
 	   /** perform one iterative alignment step
 	    */
@@ -0,0 +1,493 @@
+/*
+  alignlib - a library for aligning protein sequences
+
+  $Id$
+
+  Copyright (C) 2026 Andreas Heger
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+ */
+
+
+#include <iostream>
+#include <iomanip>
+#include <cmath>
+#include <vector>
+#include <algorithm>
+#include "alignlib_fwd.h"
+#include "alignlib_interfaces.h"
+#include "AlignlibDebug.h"
+#include "AlignlibException.h"
+#include "AlignlibSimd.h"
+
+#include "Alignment.h"
+#include "HelpersAlignment.h"
+#include "HelpersAlignator.h"
+
+#include "Alignandum.h"
+#include "ImplSequence.h"
+#include "ImplIterator2DFull.h"
+#include "ImplScorerSequenceSequence.h"
+#include "ImplAlignatorDPFull.h"
+#include "ImplAlignatorSWStriped.h"
+
+using namespace std;
+
+namespace alignlib
+{
+
+HAlignator makeAlignatorSWStriped( Score gop, Score gep )
+{
+	return HAlignator( new ImplAlignatorSWStriped( gop, gep, gop, gep ) );
+}
+
+#ifdef ALIGNLIB_HAVE_SIMD
+
+/** striped Smith-Waterman kernel.
+
+	Computes the best local alignment score between row and col. Penalties
+	are positive numbers that are subtracted. Open penalties include
+	the penalty for the first gap position.
+
+	The positions returned are the first cell (in row-major order) that
+	attains the maximum score, which is the cell that the scalar
+	implementation in @ref ImplAlignatorDPFull reports. In addition,
+	the largest row and the largest column of any cell attaining the
+	maximum score are returned in last_row and last_col.
+
+	The function returns false if the computation saturated.
+
+	see: Farrar M. (2007) Striped Smith-Waterman speeds database searches six times
+	over other SIMD implementations. Bioinformatics 23:156-161.
+ */
+template< class V >
+static bool alignStriped(
+		const Residue * row, Position row_length,
+		const Residue * col, Position col_length,
+		const Score * matrix, int matrix_width,
+		Score max_match,
+		int row_open, int row_extend,
+		int col_open, int col_extend,
+		Score & best_score, Position & best_row, Position & best_col,
+		Position & last_row, Position & last_col )
+{
+	typedef typename V::Vector Vector;
+	typedef typename V::Value Value;
+
+	const int lanes = V::LANES;
+	const int segment_length = (row_length + lanes - 1) / lanes;
+
+	best_score = 0;
+	best_row = NO_POS;
+	best_col = NO_POS;
+	last_row = NO_POS;
+	last_col = NO_POS;
+
+	if (row_length == 0 || col_length == 0)
+		return true;
+
+	// build the query profile: one striped vector set for each residue in col
+	Vector * profile = allocateVectors<Vector>( matrix_width * segment_length );
+	for (int residue = 0; residue < matrix_width; ++residue)
+	{
+		Value * p = (Value*)(profile + residue * segment_length);
+		for (int k = 0; k < segment_length; ++k)
+			for (int l = 0; l < lanes; ++l)
+			{
+				Position i = k + l * segment_length;
+				// padding positions receive minus infinity so that they never
+				// attain the maximum score
+				p[ k * lanes + l] = (i < row_length) ?
+						(Value)matrix[ row[i] * matrix_width + residue] : V::minValue();
+			}
+	}
+
+	Vector * h_store = allocateVectors<Vector>( segment_length );
+	Vector * h_load = allocateVectors<Vector>( segment_length );
+	Vector * e_store = allocateVectors<Vector>( segment_length );
+
+	const Vector v_zero = V::zero();
+	const Vector v_min = V::set1( V::minValue() );
+	const Vector v_min_first = V::first( V::minValue() );
+	const Vector v_row_open = V::set1( row_open );
+	const Vector v_row_extend = V::set1( row_extend );
+	const Vector v_col_open = V::set1( col_open );
+	const Vector v_col_extend = V::set1( col_extend );
+
+	for (int k = 0; k < segment_length; ++k)
+	{
+		V::store( h_store + k, v_zero );
+		V::store( e_store + k, v_min );
+	}
+
+	Value best = 0;
+
+	for (Position j = 0; j < col_length; ++j)
+	{
+		const Vector * p = profile + col[j] * segment_length;
+
+		Vector v_f = v_min;
+		// diagonal values for the first element in each lane
+		Vector v_h = V::shift( V::load( h_store + segment_length - 1 ) );
+		Vector v_max = v_zero;
+
+		std::swap( h_load, h_store );
+
+		for (int k = 0; k < segment_length; ++k)
+		{
+			v_h = V::add( v_h, V::load( p + k ) );
+			Vector v_e = V::load( e_store + k );
+			v_h = V::max( v_h, v_e );
+			v_h = V::max( v_h, v_f );
+			v_h = V::max( v_h, v_zero );
+			V::store( h_store + k, v_h );
+			v_max = V::max( v_max, v_h );
+
+			// horizontal gaps for the next column
+			V::store( e_store + k, V::max( V::sub( v_e, v_col_extend ), V::sub( v_h, v_col_open ) ) );
+			// vertical gaps for the next row
+			v_f = V::max( V::sub( v_f, v_row_extend ), V::sub( v_h, v_row_open ) );
+
+			v_h = V::load( h_load + k );
+		}
+
+		// lazy evaluation of vertical gaps crossing segment boundaries
+		v_f = V::shift( v_f, v_min_first );
+		int k = 0;
+		while (true)
+		{
+			Vector v_h = V::load( h_store + k );
+			if (!V::any( V::cmpgt( v_f, V::sub( v_h, v_row_open ) ) ))
+				break;
+			v_h = V::max( v_h, v_f );
+			V::store( h_store + k, v_h );
+			v_max = V::max( v_max, v_h );
+			V::store( e_store + k, V::max( V::load( e_store + k ), V::sub( v_h, v_col_open ) ) );
+			v_f = V::sub( v_f, v_row_extend );
+			if (++k >= segment_length)
+			{
+				k = 0;
+				v_f = V::shift( v_f, v_min_first );
+			}
+		}
+
+		// only inspect the column if it might contain a new maximum
+		if (!V::any( V::cmpgt( v_max, V::set1( best > 0 ? best - 1 : 0 ) ) ))
+			continue;
+
+		Value column_max = V::hmax( v_max );
+		const Value * h = (const Value*)h_store;
+		if (column_max < best)
+			continue;
+
+		Position first_row = row_length;
+		Position column_last_row = NO_POS;
+		for (int kk = 0; kk < segment_length; ++kk)
+			for (int l = 0; l < lanes; ++l)
+			{
+				Position i = kk + l * segment_length;
+				if (i < row_length && h[kk * lanes + l] == column_max)
+				{
+					first_row = std::min( first_row, i );
+					column_last_row = std::max( column_last_row, i );
+				}
+			}
+
+		if (column_max > best)
+		{
+			best = column_max;
+			best_row = first_row;
+			best_col = j;
+			last_row = column_last_row;
+		}
+		else
+		{
+			if (first_row < best_row)
+			{
+				best_row = first_row;
+				best_col = j;
+			}
+			last_row = std::max( last_row, column_last_row );
+		}
+		last_col = j;
+	}
+
+	releaseVectors( profile );
+	releaseVectors( h_store );
+	releaseVectors( h_load );
+	releaseVectors( e_store );
+
+	best_score = best;
+
+	// check for saturation
+	if (best + max_match >= V::maxValue())
+		return false;
+
+	return true;
+}
+
+/** compute score and end of best local alignment.
+ *
+ * Try with 16-bit integers first and use 32-bit integers on saturation.
+ */
+static bool alignStriped(
+		const Residue * row, Position row_length,
+		const Residue * col, Position col_length,
+		const Score * matrix, int matrix_width,
+		Score max_match,
+		int row_open, int row_extend,
+		int col_open, int col_extend,
+		Score & best_score, Position & best_row, Position & best_col,
+		Position & last_row, Position & last_col )
+{
+	if (max_match < SimdInt16::maxValue() / 2 &&
+			row_open < SimdInt16::maxValue() / 2 && col_open < SimdInt16::maxValue() / 2)
+		if (alignStriped<SimdInt16>( row, row_length, col, col_length,
+				matrix, matrix_width, max_match,
+				row_open, row_extend, col_open, col_extend,
+				best_score, best_row, best_col, last_row, last_col ))
+			return true;
+
+	debug_cerr( 5, "16-bit striped alignment saturated - switching to 32-bit" );
+
+	return alignStriped<SimdInt32>( row, row_length, col, col_length,
+			matrix, matrix_width, max_match,
+			row_open, row_extend, col_open, col_extend,
+			best_score, best_row, best_col, last_row, last_col );
+}
+
+#endif
+
+//----------------------------------------------------------------------------------------------------------------------------------------
+ImplAlignatorSWStriped::ImplAlignatorSWStriped() :
+	ImplAlignator(),
+	mRowGop( 0 ), mRowGep( 0 ),
+	mColGop( 0 ), mColGep( 0 ),
+	mAlignator( new ImplAlignatorDPFull( ALIGNMENT_LOCAL, 0, 0 ) )
+	{}
+
+ImplAlignatorSWStriped::ImplAlignatorSWStriped(
+		Score row_gop, Score row_gep,
+		Score col_gop, Score col_gep ) :
+			ImplAlignator(),
+			mRowGop( row_gop ), mRowGep( row_gep ),
+			mColGop( col_gop ), mColGep( col_gep )
+{
+	if (mColGop == 0)
+	{
+		mColGop = mRowGop;
+		mColGep = mRowGep;
+	}
+	mAlignator = HAlignator( new ImplAlignatorDPFull( ALIGNMENT_LOCAL,
+			mRowGop, mRowGep, mColGop, mColGep ) );
+}
+
+//----------------------------------------------------------------------------------------------------------------------------------------
+ImplAlignatorSWStriped::ImplAlignatorSWStriped( const ImplAlignatorSWStriped & src ) :
+	ImplAlignator( src ),
+	mRowGop( src.mRowGop), mRowGep( src.mRowGep),
+	mColGop( src.mColGop), mColGep( src.mColGep),
+	mAlignator( src.mAlignator->getClone() )
+	{
+	debug_func_cerr(5);
+	}
+
+//----------------------------------------------------------------------------------------------------------------------------------------
+ImplAlignatorSWStriped::~ImplAlignatorSWStriped()
+{
+	debug_func_cerr(5);
+}
+
+IMPLEMENT_CLONE( HAlignator, ImplAlignatorSWStriped );
+
+//----------------------------------------------------------------------------------------------------------------------------------------
+void ImplAlignatorSWStriped::trimWorkspace()
+{
+	debug_func_cerr(5);
+	mAlignator->trimWorkspace();
+	ImplAlignator::trimWorkspace();
+}
+
+//----------------------------------------------------------------------------------------------------------------------------------------
+void ImplAlignatorSWStriped::align(
+		HAlignment & result,
+		const HAlignandum & row,
+		const HAlignandum & col )
+{
+	debug_func_cerr(5);
+
+	startUp(result, row, col );
+
+	// the helper alignator has to work in the same environment
+	mAlignator->setToolkit( getToolkit() );
+
+	if (!performAlignment(result, row, col ))
+	{
+		debug_cerr( 5, "striped alignment not applicable - using full dynamic programming" );
+		mAlignator->align( result, row, col );
+	}
+
+	cleanUp(result, row, col );
+}
+
+//----------------------------------------------------------------------------------------------------------------------------------------
+static inline bool isIntegral( const Score & value )
+{
+	return floor(value) == value;
+}
+
+//----------------------------------------------------------------------------------------------------------------------------------------
+bool ImplAlignatorSWStriped::performAlignment(
+		HAlignment & result,
+		const HAlignandum & row,
+		const HAlignandum & col )
+{
+	debug_func_cerr(5);
+
+#ifndef ALIGNLIB_HAVE_SIMD
+	return false;
+#else
+	// the striped algorithm only works on the full matrix
+	if (!boost::dynamic_pointer_cast< ImplIterator2DFull, Iterator2D>(mIterator))
+		return false;
+
+	const boost::shared_ptr<ImplScorerSequenceSequence> scorer(
+			boost::dynamic_pointer_cast< ImplScorerSequenceSequence, Scorer>(mScorer));
+	const HImplSequence s1(boost::dynamic_pointer_cast< ImplSequence, Alignandum>(row));
+	const HImplSequence s2(boost::dynamic_pointer_cast< ImplSequence, Alignandum>(col));
+
+	if (!scorer || !s1 || !s2)
+		return false;
+
+	const HSubstitutionMatrix & matrix = scorer->getSubstitutionMatrix();
+
+	// check if penalties and scores can be represented as integers
+	if (!isIntegral( mRowGop ) || !isIntegral( mRowGep ) ||
+			!isIntegral( mColGop ) || !isIntegral( mColGep ) )
+		return false;
+
+	// the lazy evaluation of vertical gaps requires non-negative penalties
+	int row_open = (int)-(mRowGop + mRowGep);
+	int row_extend = (int)-mRowGep;
+	int col_open = (int)-(mColGop + mColGep);
+	int col_extend = (int)-mColGep;
+
+	if (row_extend < 0 || row_open < row_extend || col_extend < 0 || col_open < col_extend)
+		return false;
+
+	const int matrix_width = matrix->getNumCols();
+	const Score * data = matrix->getData();
+	Score max_match = 0;
+	for (unsigned int x = 0; x < matrix->getNumRows() * matrix->getNumCols(); ++x)
+	{
+		if (!isIntegral( data[x] ) || fabs(data[x]) >= SimdInt32::maxValue() / 2)
+			return false;
+		max_match = std::max( max_match, data[x] );
+	}
+
+	const Position row_from = row->getFrom();
+	const Position row_length = row->getTo() - row_from;
+	const Position col_from = col->getFrom();
+	const Position col_length = col->getTo() - col_from;
+
+	const Residue * row_residues = &(*s1->getSequence())[row_from];
+	const Residue * col_residues = &(*s2->getSequence())[col_from];
+
+	for (Position x = 0; x < row_length; ++x)
+		if (row_residues[x] >= matrix->getNumRows()) return false;
+	for (Position x = 0; x < col_length; ++x)
+		if (col_residues[x] >= matrix->getNumCols()) return false;
+
+	//------------------------------------------------------------------------------
+	// forward pass: get score and end of alignment
+	Score score;
+	Position row_last, col_last, row_tie, col_tie;
+
+	if (!alignStriped( row_residues, row_length,
+			col_residues, col_length,
+			data, matrix_width, max_match,
+			row_open, row_extend, col_open, col_extend,
+			score, row_last, col_last, row_tie, col_tie ))
+		return false;
+
+	debug_cerr( 5, "striped alignment: score=" << score << " row_last=" << row_last << " col_last=" << col_last );
+
+	if (score <= 0)
+	{
+		result->setScore( 0 );
+		return true;
+	}
+
+	//------------------------------------------------------------------------------
+	// reverse pass: get start of alignment.
+	// The reversed prefixes up to the end cell are aligned. Every start of an
+	// alignment with maximum score that ends in the end cell attains the
+	// maximum score in the reverse pass, including the starts that extend the
+	// alignment by a prefix of score zero. The start that full dynamic
+	// programming chooses is thus not before the largest row and column of
+	// any cell with maximum score in the reverse pass.
+	std::vector<Residue> reverse_row( row_residues, row_residues + row_last + 1 );
+	std::vector<Residue> reverse_col( col_residues, col_residues + col_last + 1 );
+	std::reverse( reverse_row.begin(), reverse_row.end() );
+	std::reverse( reverse_col.begin(), reverse_col.end() );
+
+	Score reverse_score;
+	Position reverse_row_best, reverse_col_best, reverse_row_tie, reverse_col_tie;
+
+	if (!alignStriped( &reverse_row[0], row_last + 1,
+			&reverse_col[0], col_last + 1,
+			data, matrix_width, max_match,
+			row_open, row_extend, col_open, col_extend,
+			reverse_score, reverse_row_best, reverse_col_best,
+			reverse_row_tie, reverse_col_tie ))
+		return false;
+
+	if (reverse_score != score)
+	{
+		debug_cerr( 5, "striped alignment: reverse score " << reverse_score << " != " << score );
+		return false;
+	}
+
+	const Position row_start = row_last - reverse_row_tie;
+	const Position col_start = col_last - reverse_col_tie;
+
+	debug_cerr( 5, "striped alignment: row_start=" << row_start << " col_start=" << col_start );
+
+	//------------------------------------------------------------------------------
+	// traceback in region between start and end of the alignment.
+	// Clipping does not change the scores of the cells on the path that full
+	// dynamic programming traces back and only lowers the scores of other
+	// cells. The end cell is the first cell with the maximum score in both
+	// algorithms, so the traceback gives the same alignment as full dynamic
+	// programming.
+	HAlignandum copy_row( row->getClone() );
+	HAlignandum copy_col( col->getClone() );
+	copy_row->useSegment( row_from + row_start, row_from + row_last + 1 );
+	copy_col->useSegment( col_from + col_start, col_from + col_last + 1 );
+
+	mAlignator->align( result, copy_row, copy_col );
+
+	// sanity check - the region must contain the optimal alignment
+	if (result->getScore() != score)
+	{
+		debug_cerr( 5, "striped alignment: traceback score " << result->getScore() << " != " << score );
+		return false;
+	}
+
+	return true;
+#endif
+}
+
+} // namespace alignlib
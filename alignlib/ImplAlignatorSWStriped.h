@@ -0,0 +1,124 @@
+/*
+  alignlib - a library for aligning protein sequences
+
+  $Id$
+
+  Copyright (C) 2026 Andreas Heger
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+*/
+
+#if HAVE_CONFIG_H
+#include <config.h>
+#endif
+
+#ifndef IMPL_ALIGNATOR_SW_STRIPED_H
+#define IMPL_ALIGNATOR_SW_STRIPED_H 1
+
+#include "alignlib_fwd.h"
+#include "ImplAlignator.h"
+
+namespace alignlib
+{
+
+/**
+    @brief local alignment of sequences with a striped, vectorized Smith-Waterman algorithm.
+
+    The algorithm follows Farrar (2007): a query profile is built from
+    the row sequence and the substitution matrix. The row positions are
+    distributed across the lanes of a vector in a striped fashion, so
+    that a column of the dynamic programming matrix is computed with
+    vector instructions. Vertical gaps are resolved lazily in a second
+    pass over the column.
+
+    The scores are computed with 16-bit integers. If the score saturates,
+    the computation is repeated with 32-bit integers. If the substitution
+    matrix or the gap penalties are not integral, or if the objects
+    are not sequences, this object behaves exactly like
+    an @ref ImplAlignatorDPFull object performing local alignment.
+
+    The vectorized pass only computes the score and the end position of the
+    best alignment. A second vectorized pass over the reversed sequences
+    from the end position gives the start of the alignment. As several
+    starts can give the same score, for example if a prefix of the
+    alignment scores zero, the region starts at the earliest row and
+    column of all of them. The alignment itself is then obtained by
+    running full dynamic programming with traceback on this region only.
+
+    @author Andreas Heger
+    @version $Id$
+*/
+class ImplAlignatorSWStriped : public ImplAlignator
+{
+ public:
+
+    /* Constructors and destructors */
+
+	/** empty constructor */
+	ImplAlignatorSWStriped();
+
+    /** set affine gap penalties
+     @param row_gop		gap opening penalty in row
+     @param row_gep		gap elongation penalty in row
+     @param col_gop		gap opening penalty in column, default = row
+     @param col_gep		gap elongation penalty in row, default = col
+    */
+    ImplAlignatorSWStriped( Score row_gop, Score row_gep,
+    		Score col_gop = 0, Score col_gep = 0 );
+
+    /** copy constructor */
+    ImplAlignatorSWStriped( const ImplAlignatorSWStriped & );
+
+    /** destructor */
+    virtual ~ImplAlignatorSWStriped();
+
+    DEFINE_CLONE( HAlignator );
+
+    /** method for aligning two arbitrary objects */
+    virtual void align( HAlignment & , const HAlignandum & , const HAlignandum &);
+
+    /** release work space of the helper alignator */
+    virtual void trimWorkspace();
+
+ protected:
+
+    /** perform the alignment with the vectorized algorithm.
+     *
+     * @return false, if the vectorized algorithm could not be applied.
+     */
+    virtual bool performAlignment( HAlignment & dest,
+    		const HAlignandum & row,
+    		const HAlignandum & col );
+
+    /* member data --------------------------------------------------------------------------- */
+ protected:
+
+    /** gap opening penalty for row-object */
+    Score mRowGop;
+    /** gap elongation penalty for col-object */
+    Score mRowGep;
+    /** gap opening penalty for row-object */
+    Score mColGop;
+    /** gap elongation penalty for col-object */
+    Score mColGep;
+
+    /** alignator used for the traceback and as fall-back */
+    HAlignator mAlignator;
+};
+
+
+}
+
+#endif /* IMPL_ALIGNATOR_SW_STRIPED_H */
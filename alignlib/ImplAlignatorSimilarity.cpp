@@ -24,6 +24,7 @@
 #include <iostream>
 #include <iomanip>
 #include <math.h>
+#include <algorithm>
 #include "alignlib_fwd.h"
 #include "alignlib_interfaces.h"
 #include "alignlib_fwd.h"
@@ -31,6 +32,8 @@
 #include "Alignandum.h"
 #include "Alignment.h"
 #include "Matrix.h"
+#include "ImplSequence.h"
+#include "ImplScorerSequenceSequence.h"
 #include "ImplAlignatorSimilarity.h"
 
 #include "Iterator2D.h"
@@ -63,34 +66,103 @@ namespace alignlib
 
   IMPLEMENT_CLONE( HAlignator, ImplAlignatorSimilarity );
 
+  void ImplAlignatorSimilarity::trimWorkspace()
+  {
+    debug_func_cerr(5);
+    std::vector<Residue>().swap( mColResidues );
+    std::vector<Residue>().swap( mCodes );
+    std::vector<Position>().swap( mCols );
+    std::vector<ResiduePair>().swap( mDots );
+    ImplAlignator::trimWorkspace();
+  }
+
   void ImplAlignatorSimilarity::align(
 		  HAlignment & result,
 		  const HAlignandum & row,
 		  const HAlignandum & col)
   {
+    debug_func_cerr(5);
 
     startUp(result, row, col );
 
+    // note: a dot is scored as 1, not with its similarity score
     Score score, total_score = 0;
 
     HIterator2D it2d(mIterator->getNew( row, col ));
 
     Iterator2D::const_iterator rit(it2d->row_begin()), rend(it2d->row_end());
 
-    for (; rit != rend; ++rit)
+    const boost::shared_ptr<ImplScorerSequenceSequence> scorer(
+    		boost::dynamic_pointer_cast< ImplScorerSequenceSequence, Scorer>( mScorer ));
+    const HImplSequence row_sequence(boost::dynamic_pointer_cast< ImplSequence, Alignandum>(row));
+    const HImplSequence col_sequence(boost::dynamic_pointer_cast< ImplSequence, Alignandum>(col));
+
+    if (scorer && row_sequence && col_sequence)
+      {
+    	// compare residues directly, the score is given by the substitution matrix
+    	const HSubstitutionMatrix & matrix = scorer->getSubstitutionMatrix();
+    	const ResidueVector & row_residues = *row_sequence->getSequence();
+    	const ResidueVector & col_residues = *col_sequence->getSequence();
+
+    	mDots.clear();
+    	const Position col_from = *it2d->col_begin();
+    	const Position col_to = *it2d->col_end();
+    	mColResidues.resize( std::max( col_to, 0 ) );
+    	for (Position c = col_from; c < col_to; ++c)
+    		mColResidues[c] = col_residues[c];
+    	const Residue * residues = mColResidues.empty() ? NULL : &mColResidues[0];
+
+    	for (; rit != rend; ++rit)
+    	  {
+    		Position r = *rit;
+    		const Residue residue = row_residues[r];
+
+    		mCols.clear();
+    		if (residue < matrix->getNumRows())
+    		  {
+    			mCodes.clear();
+    			for (unsigned int x = 0; x < matrix->getNumCols() && x <= Residue(-1); ++x)
+    				if (matrix->getValue( residue, x ) > 0)
+    					mCodes.push_back( x );
+
+    			findResidues( residues,
+    					*it2d->col_begin(r), *it2d->col_end(r),
+    					mCodes.empty() ? NULL : &mCodes[0], mCodes.size(), mCols );
+    		  }
+    		else
+    		  {
+    			// residues outside the matrix: use the scorer
+    			Iterator2D::const_iterator cit(it2d->col_begin(r)), cend(it2d->col_end(r));
+    			for (; cit != cend; ++cit)
+    				if (mScorer->getScore( r, *cit ) > 0)
+    					mCols.push_back( *cit );
+    		  }
+
+    		for (size_t x = 0; x < mCols.size(); ++x)
+    			mDots.push_back( ResiduePair( r, mCols[x], 1 ) );
+    	  }
+
+    	if (!mDots.empty())
+    		result->addPairs( &mDots[0], mDots.size(), true );
+    	total_score = mDots.size();
+      }
+    else
       {
-	Position r = *rit;
-
-	Iterator2D::const_iterator cit(it2d->col_begin(r)), cend(it2d->col_end(r));
-	for (; cit != cend; ++cit)
-	  {
-	    Position c = *cit;
-	    if ( (score = mScorer->getScore( r, c ) > 0) )
-	      {
-		result->addPair( ResiduePair( r, c, score ));
-		total_score += score;
-	      }
-	  }
+    	for (; rit != rend; ++rit)
+    	  {
+    		Position r = *rit;
+
+    		Iterator2D::const_iterator cit(it2d->col_begin(r)), cend(it2d->col_end(r));
+    		for (; cit != cend; ++cit)
+    		  {
+    			Position c = *cit;
+    			if ( (score = mScorer->getScore( r, c ) > 0) )
+    			  {
+    				result->addPair( ResiduePair( r, c, score ));
+    				total_score += score;
+    			  }
+    		  }
+    	  }
       }
 
     result->setScore( total_score );
@@ -28,6 +28,7 @@
 #ifndef IMPL_ALIGNATOR_SIMILARITY_H
 #define IMPL_ALIGNATOR_SIMILARITY_H 1
 
+#include <vector>
 #include "alignlib_fwd.h"
 #include "ImplAlignator.h"
 
@@ -39,6 +40,12 @@ namespace alignlib
     Create a dot for similar residue pairs. Similarity is given by
     a substitution matrix.
 
+    If two sequences are scored with a substitution matrix, the
+    residues similar to each row residue are looked up once. Column
+    residues are then compared to these in vectors, see
+    @ref ImplAlignator::findResidues. Otherwise, each pair is
+    scored with the @ref Scorer.
+
     @author Andreas Heger
     @version $Id: ImplAlignatorSimilarity.h,v 1.3 2004/03/19 18:23:41 aheger Exp $
 */
@@ -63,6 +70,22 @@ class ImplAlignatorSimilarity : public ImplAlignator
     		const HAlignandum & col );
 
     DEFINE_CLONE( HAlignator );
+
+    /** release memory kept between alignments */
+    virtual void trimWorkspace();
+
+ protected:
+    /** residues of col */
+    std::vector<Residue> mColResidues;
+
+    /** residues similar to the current row residue */
+    std::vector<Residue> mCodes;
+
+    /** columns similar to the current row */
+    std::vector<Position> mCols;
+
+    /** dots, sorted by row and column */
+    std::vector<ResiduePair> mDots;
 };
 
 }
@@ -24,15 +24,16 @@
 #include <iterator>
 #include <iostream>
 #include <iomanip>
-#include <map>
 #include <vector>
-#include <set>
+#include <algorithm>
+#include <numeric>
 #include <math.h>
 #include "alignlib_fwd.h"
 #include "alignlib_interfaces.h"
 #include "alignlib_fwd.h"
 #include "AlignlibDebug.h"
 #include "Alignandum.h"
+#include "ImplAlignandum.h"
 #include "ImplAlignatorTuples.h"
 #include "ImplAlignmentMatrix.h"
 #include "HelpersSubstitutionMatrix.h"
@@ -44,9 +45,6 @@ using namespace std;
 namespace alignlib
 {
 
-// map for mapping strings (tuples) to sequenceposotions.
-typedef map<string, vector<Position> > TUPLES;
-
 /*---------------------factory functions ---------------------------------- */
 HAlignator makeAlignatorTuples( int ktuple )
 {
@@ -73,6 +71,44 @@ ImplAlignatorTuples::ImplAlignatorTuples (const ImplAlignatorTuples & src ) :
 IMPLEMENT_CLONE( HAlignator, ImplAlignatorTuples );
 
 //---------------------------------------------> Alignment <-----------------------------------------
+void ImplAlignatorTuples::startBatch( const HAlignandum & query,
+		const AlignandumVector & targets )
+{
+	debug_func_cerr(5);
+	ImplAlignator::startBatch( query, targets );
+	mIndex = getIndex( query );
+}
+
+void ImplAlignatorTuples::finishBatch()
+{
+	debug_func_cerr(5);
+	mIndex.reset();
+	ImplAlignator::finishBatch();
+}
+
+void ImplAlignatorTuples::trimWorkspace()
+{
+	debug_func_cerr(5);
+	std::vector<Position>().swap( mCovered );
+	std::vector<Position>().swap( mDotRows );
+	std::vector<Position>().swap( mDotCols );
+	std::vector<Position>().swap( mCounts );
+	std::vector<Position>().swap( mOrder );
+	std::vector<ResiduePair>().swap( mSorted );
+	ImplAlignator::trimWorkspace();
+}
+
+HKmerIndex ImplAlignatorTuples::getIndex( const HAlignandum & row ) const
+{
+	debug_func_cerr(5);
+
+	// use the index cached on the object, if possible
+	const HImplAlignandum impl( boost::dynamic_pointer_cast<ImplAlignandum, Alignandum>(row) );
+	if (impl)
+		return impl->getKmerIndex( mKtuple );
+	else
+		return HKmerIndex( new KmerIndex( *row, mKtuple ) );
+}
 
 void ImplAlignatorTuples::align(
 		HAlignment & result,
@@ -83,80 +119,91 @@ void ImplAlignatorTuples::align(
 
 	startUp(result, row, col);
 
-	TUPLES tuples;
-
-	// 1. create map of tuples of length ktuple for row_sequence (this is a map of vectors)
-	int row_len = row->getLength();
-
-	// get some sort of string representation for the sequences (i.e., consensus-string for profiles)
-	std::string row_sequence = row->asString();
-
-	// xrow and xcol are positions in the string and are therefore starting at 0.
-
-	for (int xrow = 0; xrow <= (row_len - mKtuple); xrow++)
-		tuples[row_sequence.substr(xrow, mKtuple)].push_back(xrow);
-
-#ifdef DEBUG
-	debug_cerr( 5, "Tuples " );
-	if (AlignlibDebug::mVerbosity >= 5)
+	// within a batch, the index for the query has been obtained already
+	HKmerIndex index( (row == mBatchQuery && mIndex) ? mIndex : getIndex( row ) );
+
+	const Position row_len = row->getLength();
+	const Position col_len = col->getLength();
+	const int bits = index->getBits();
+	const KmerIndex::Key mask = index->getMask();
+	const Residue max_residue = index->getMaxResidue();
+
+	// 1. look up tuples in col. Dots are unique, as tuples on the same
+	// diagonal only add the residues not covered by a previous tuple.
+	// Diagonals are numbered xcol - xrow + row_len.
+	mCovered.assign( row_len + col_len + 1, 0 );
+	mDotRows.clear();
+	mDotCols.clear();
+
+	KmerIndex::Key key = 0;
+	Position valid = 0;
+	for (Position xcol = 0; xcol < col_len; ++xcol)
 	{
-		for (TUPLES::iterator it = tuples.begin(); it != tuples.end(); ++it)
+		const Residue residue = col->asResidue( xcol );
+
+		// residues not in the row can not be part of a tuple
+		if (residue > max_residue)
 		{
-			std::cerr << (*it).first << "\t" ;
-			vector<int> & v = tuples[(*it).first];
-			copy(v.begin(), v.end(), std::ostream_iterator<int>(std::cerr, " "));
-			std::cerr << endl;
+			valid = 0;
+			continue;
 		}
-	}
-#endif
-
-	// 2. look up tuples in col_sequence and add dots to a set, so that they are unique
-	int col_len = col->getLength();
-	std::string col_sequence = col->asString();
 
-	// set of newly generated aligned residue pairs. The residue pair is encoded as
-	// (column_length) * (row) + (column). This step is needed, so all pairs are unique.
+		key = ((key << bits) | residue) & mask;
+		if (++valid < mKtuple)
+			continue;
 
-	set<Position> newdots;
+		const Position start = xcol - mKtuple + 1;
+		const Position * it;
+		const Position * end;
+		index->find( key, it, end );
 
-	// go through object in col
-	for (Position xcol = 0; xcol <= (col_len - mKtuple); xcol++)
-	{
-
-		// build tuple
-		std::string tuple = col_sequence.substr( xcol, mKtuple);
-
-		// look up tuple
-		if ( tuples.find(tuple) != tuples.end() )
+		for (; it != end; ++it)
 		{
-			// if tuple was there, iterate through all rows and add aligned residues
-			vector<Position>& rows = tuples[tuple];
-
-			for (vector<Position>::iterator it = rows.begin(); it != rows.end(); ++it)
+			Position & covered = mCovered[start - *it + row_len];
+			for (Position c = std::max( start, covered ); c < start + mKtuple; ++c)
 			{
-				for (Position i = 0; i < mKtuple; i++)
-				{
-					Position code = ((*it) + i) * col_len + xcol + i;
-					newdots.insert( code );
-				}
+				mDotRows.push_back( c - start + *it );
+				mDotCols.push_back( c );
 			}
+			covered = start + mKtuple;
 		}
 	}
 
-	// Add dots from set to dots, nice side-effect:
-	// the dots are already sorted by row and then by column !!
+	// 2. sort dots by row and then by column: sort by column
+	// and then stably by row.
+	const Position ndots = mDotRows.size();
+
+	mCounts.assign( col_len + 1, 0 );
+	for (Position x = 0; x < ndots; ++x)
+		++mCounts[mDotCols[x] + 1];
+	std::partial_sum( mCounts.begin(), mCounts.end(), mCounts.begin() );
+	mOrder.resize( ndots );
+	for (Position x = 0; x < ndots; ++x)
+		mOrder[mCounts[mDotCols[x]]++] = x;
+
+	mCounts.assign( row_len + 1, 0 );
+	for (Position x = 0; x < ndots; ++x)
+		++mCounts[mDotRows[x] + 1];
+	std::partial_sum( mCounts.begin(), mCounts.end(), mCounts.begin() );
+	mSorted.resize( ndots );
+	for (Position x = 0; x < ndots; ++x)
+	{
+		const Position xrow = mDotRows[mOrder[x]];
+		mSorted[mCounts[xrow]++] = ResiduePair( xrow, mDotCols[mOrder[x]] );
+	}
 
+	// 3. score and add dots
 	Score total_score = 0;
-	for (set<int>::iterator it = newdots.begin(); it != newdots.end(); ++it)
+	for (Position x = 0; x < ndots; ++x)
 	{
-		int xrow = (*it) / col_len;
-		int xcol = (*it) % col_len;
-		Score score =  mScorer->getScore( xrow, xcol);
-
-		total_score += score;
-		result->addPair( ResiduePair( xrow, xcol, score));
+		ResiduePair & p = mSorted[x];
+		p.mScore = mScorer->getScore( p.mRow, p.mCol );
+		total_score += p.mScore;
 	}
 
+	if (ndots > 0)
+		result->addPairs( &mSorted[0], ndots, true );
+
 	result->setScore( total_score );
 
 	cleanUp(result, row, col);
@@ -31,6 +31,8 @@
 #include "alignlib_fwd.h"
 #include "alignlib_fwd.h"
 #include "ImplAlignator.h"
+#include "KmerIndex.h"
+#include <vector>
 
 namespace alignlib
 {
@@ -39,6 +41,10 @@ namespace alignlib
 
     Both the substitution matrix and the size of the tuples can be set.
 
+    Tuples in the row are looked up in a @ref KmerIndex, which
+    is cached on the row object. Tuples are compared by
+    residue codes.
+
     @author Andreas Heger
     @version $Id: ImplAlignatorTuples.h,v 1.3 2004/03/19 18:23:41 aheger Exp $
 */
@@ -66,10 +72,43 @@ class ImplAlignatorTuples : public ImplAlignator
 
     DEFINE_CLONE( HAlignator );
 
+    /** get the index of tuples for the query */
+    virtual void startBatch( const HAlignandum & query, const AlignandumVector & targets );
+
+    /** release the index of tuples */
+    virtual void finishBatch();
+
+    /** release memory kept between alignments */
+    virtual void trimWorkspace();
+
  private:
 
+    /** return the index of tuples in row */
+    HKmerIndex getIndex( const HAlignandum & row ) const;
+
     /** the tuple sized used by this object */
     int mKtuple;
+
+    /** index of tuples in the query of a batch */
+    HKmerIndex mIndex;
+
+    /** first column not covered by a tuple for each diagonal */
+    std::vector<Position> mCovered;
+
+    /** rows of dots */
+    std::vector<Position> mDotRows;
+
+    /** columns of dots */
+    std::vector<Position> mDotCols;
+
+    /** counts for sorting dots */
+    std::vector<Position> mCounts;
+
+    /** dots sorted by column */
+    std::vector<Position> mOrder;
+
+    /** dots sorted by row and column */
+    std::vector<ResiduePair> mSorted;
 };
 
 }
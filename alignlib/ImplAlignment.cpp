@@ -221,6 +221,22 @@ void ImplAlignment::addPair( const ResiduePair & pair )
 	setChangedLength();
 }
 
+//--------------------------------------------------------------------------------------------------------------
+void ImplAlignment::reserve( Position n )
+{
+}
+
+//--------------------------------------------------------------------------------------------------------------
+void ImplAlignment::addPairs(
+		const ResiduePair * pairs,
+		Position n,
+		bool already_sorted )
+{
+	debug_func_cerr( 5 );
+	for (Position x = 0; x < n; ++x)
+		addPair( pairs[x] );
+}
+
 //--------------------------------------------------------------------------------------------------------------
 void ImplAlignment::addDiagonal(
 		Position row_from,
@@ -161,6 +161,16 @@ class ImplAlignment : public Alignment, public ImplAlignlibBase
     /** adds a pair of residues to the alignment */
     virtual void addPair( Position row, Position col, Score score = 0);
 
+    /** reserve space for n residue pairs. The default does nothing. */
+    virtual void reserve( Position n );
+
+    /** adds n residue pairs to the alignment. The default calls
+     * addPair for each pair. */
+    virtual void addPairs(
+    		const ResiduePair * pairs,
+    		Position n,
+    		bool already_sorted = false );
+
 	/** adds a diagonal to the alignment.
 	 *
 	 * @param row_from	  	row start
@@ -59,6 +59,8 @@ namespace alignlib
 //------------------------------------< constructors and destructors >-----
 ImplAlignmentMatrix::ImplAlignmentMatrix() : ImplAlignment(), 
 mIndex(NULL),
+mSortedByRow(true),
+mNumRemoved(0),
 mAllocatedIndexSize(0) 
 {
 	debug_func_cerr(5);
@@ -73,6 +75,8 @@ ImplAlignmentMatrix::ImplAlignmentMatrix( const ImplAlignmentMatrix & src) :
 	ImplAlignment( src ), 
 	mPairs(),			
 	mIndex(NULL),
+	mSortedByRow( src.mSortedByRow ),
+	mNumRemoved( src.mNumRemoved ),
 	mAllocatedIndexSize( src.mAllocatedIndexSize) 
 	{
 	debug_func_cerr(5);
@@ -123,13 +127,33 @@ AlignmentIterator ImplAlignmentMatrix::end() const
 ResiduePair ImplAlignmentMatrix::front() const 
 { 
 	if (mChangedLength) calculateLength(); 
-	return (mPairs.size() > 0) ? (mPairs.front()) : ResiduePair(NO_POS,NO_POS,0); 
+	for (PairConstIterator it = mPairs.begin(); it != mPairs.end(); ++it)
+		if (it->mCol != NO_POS)
+			return *it;
+	return ResiduePair(NO_POS,NO_POS,0); 
 }
 
 ResiduePair ImplAlignmentMatrix::back()  const 
 { 
 	if (mChangedLength) calculateLength(); 
-	return (mPairs.size() > 0) ? (mPairs.back()) : ResiduePair(NO_POS,NO_POS,0); 
+	for (PAIRVECTOR::const_reverse_iterator it = mPairs.rbegin(); it != mPairs.rend(); ++it)
+		if (it->mCol != NO_POS)
+			return *it;
+	return ResiduePair(NO_POS,NO_POS,0); 
+}
+
+//-------------------------------------------------------------------------------------------------------------
+/** true, if lhs comes before rhs when sorting by row and then by column */
+static inline bool isBefore( const ResiduePair & lhs, const ResiduePair & rhs )
+{
+	return lhs.mRow < rhs.mRow || (lhs.mRow == rhs.mRow && lhs.mCol < rhs.mCol);
+}
+
+//-------------------------------------------------------------------------------------------------------------
+/** true, if dot has been removed in place */
+static inline bool isRemoved( const ResiduePair & p )
+{
+	return p.mCol == NO_POS;
 }
 
 //-------------------------------------------------------------------------------------------------------------
@@ -139,10 +163,63 @@ void ImplAlignmentMatrix::addPair( const ResiduePair & pair )
     debug_cerr( 5, "adding pair " <<  pair << " to container of size " 
     		<< mPairs.size() << " coords=" << mRowFrom << "-" << mRowTo << ":" << mColFrom << "-" << mColTo );
 
+	// removed dots do not have a column, so order can not be checked
+	if (!mPairs.empty() && (mNumRemoved > 0 || !isBefore( mPairs.back(), pair )))
+		mSortedByRow = false;
 	mPairs.push_back( pair );
 	setChangedLength();
 } 
 
+//-------------------------------------------------------------------------------------------------------------
+void ImplAlignmentMatrix::reserve( Position n )
+{
+	mPairs.reserve( n );
+}
+
+//-------------------------------------------------------------------------------------------------------------
+void ImplAlignmentMatrix::addPairs(
+		const ResiduePair * pairs,
+		Position n,
+		bool already_sorted )
+{
+	debug_func_cerr( 5 );
+	if (n <= 0)
+		return;
+
+	// update boundaries
+	Position row_from = pairs[0].mRow, row_to = pairs[0].mRow;
+	Position col_from = pairs[0].mCol, col_to = pairs[0].mCol;
+	for (Position x = 1; x < n; ++x)
+	{
+		const Position row = pairs[x].mRow;
+		const Position col = pairs[x].mCol;
+		if (row < row_from) row_from = row;
+		if (row > row_to) row_to = row;
+		if (col < col_from) col_from = col;
+		if (col > col_to) col_to = col;
+	}
+	if (mRowFrom == NO_POS)
+	{
+		mRowFrom = row_from;
+		mColFrom = col_from;
+		mRowTo = row_to + 1;
+		mColTo = col_to + 1;
+	}
+	else
+	{
+		mRowFrom = std::min( mRowFrom, row_from );
+		mColFrom = std::min( mColFrom, col_from );
+		mRowTo = std::max( mRowTo, row_to + 1 );
+		mColTo = std::max( mColTo, col_to + 1 );
+	}
+
+	if (!already_sorted || (!mPairs.empty() && (mNumRemoved > 0 || !isBefore( mPairs.back(), pairs[0] ))))
+		mSortedByRow = false;
+
+	mPairs.insert( mPairs.end(), pairs, pairs + n );
+	setChangedLength();
+}
+
 //-------------------------------------------------------------------------------------------------------------
 /** retrieves a pair of residues from the alignment */
 ResiduePair ImplAlignmentMatrix::getPair( const ResiduePair & p) const 
@@ -150,7 +227,7 @@ ResiduePair ImplAlignmentMatrix::getPair( const ResiduePair & p) const
   /** generic implementation - returns any pair of row */
   PAIRVECTOR::iterator it(mPairs.begin()), it_end(mPairs.end());
   for (;it != it_end; ++it)
-    if (it->mRow == p.mRow)
+    if (it->mRow == p.mRow && it->mCol != NO_POS)
       return *it;
   
   return ResiduePair();
@@ -179,6 +256,9 @@ void ImplAlignmentMatrix::updateBoundaries() const
     	const Position row = (*it).mRow;
     	const Position col = (*it).mCol;
     	
+    	if (col == NO_POS) 
+    		continue;
+    	
 		// get maximum boundaries
     	if (row < mRowFrom) mRowFrom = row;
     	if (col < mColFrom) mColFrom = col;
@@ -224,9 +304,19 @@ void ImplAlignmentMatrix::clear()
 
 	PAIRVECTOR::iterator it(mPairs.begin()), it_end(mPairs.end());
 	mPairs.clear();
+	mSortedByRow = true;
+	mNumRemoved = 0;
+	mColumnDots.clear();
+	mColumnStarts.clear();
+	mColumnCounts.clear();
 }
 
 //------------------------------------> sorting subroutines <-----------------------------------------------
+bool ImplAlignmentMatrix::hasRowOrder() const
+{
+	return false;
+}
+
 
 bool SortPredicateDiagonal(const ResiduePair & lhs, const ResiduePair & rhs)
 {
@@ -349,20 +439,213 @@ void ImplAlignmentMatrix::calculateLength() const
 
 	mAllocatedIndexSize = 0;
 	setNumGaps(0);
+
+	// dots might move, so discard column index
+	mColumnDots.clear();
+	mColumnStarts.clear();
+	mColumnCounts.clear();
+	if (mNumRemoved > 0)
+		removeTombstones();
+
 	setLength(mPairs.size());
 
 	if (mPairs.empty()) 
 		return;
 
-	// 1. sort Dots
-	sortDots();
+	if (mSortedByRow && hasRowOrder())
+	{
+		// dots are in order already, only set mRowFrom, mRowTo, etc.
+		updateBoundaries();
+	}
+	else
+	{
+		// 1. sort Dots
+		sortDots();
 
-	// 2. eliminate duplicates. At the same time, this sets mRowFrom, mRowTo, etc.
-	eliminateDuplicates();
+		// 2. eliminate duplicates. At the same time, this sets mRowFrom, mRowTo, etc.
+		eliminateDuplicates();
+
+		mSortedByRow = hasRowOrder();
+	}
 
 	// 3. build index for quick access (row, col, diagonal, etc.)
 	buildIndex();
 
 }  
 
+//--------------------------------------------------------------------------------------------------------------
+void ImplAlignmentMatrix::removeTombstones() const
+{
+	debug_func_cerr(5);
+
+	// keeps order of remaining dots
+	mPairs.erase( std::remove_if( mPairs.begin(), mPairs.end(), isRemoved ), mPairs.end() );
+	mNumRemoved = 0;
+}
+
+//--------------------------------------------------------------------------------------------------------------
+/* counting sort of dots by column. Only called on non-empty dotplots,
+ * when boundaries are up-to-date.
+ */
+void ImplAlignmentMatrix::buildColumnIndex() const
+{
+	debug_func_cerr(5);
+
+	mColumnCounts.assign( mColTo, 0 );
+	for (PairConstIterator it = mPairs.begin(); it != mPairs.end(); ++it)
+		if (it->mCol != NO_POS)
+			++mColumnCounts[it->mCol];
+
+	mColumnStarts.assign( mColTo + 1, 0 );
+	for (Position col = 0; col < mColTo; ++col)
+		mColumnStarts[col+1] = mColumnStarts[col] + mColumnCounts[col];
+
+	mColumnDots.resize( mColumnStarts[mColTo] );
+	std::vector<Dot> fill( mColumnStarts.begin(), mColumnStarts.end() - 1 );
+	for (Dot dot = 0; dot < (Dot)mPairs.size(); ++dot)
+		if (mPairs[dot].mCol != NO_POS)
+			mColumnDots[fill[mPairs[dot].mCol]++] = dot;
+}
+
+//--------------------------------------------------------------------------------------------------------------
+void ImplAlignmentMatrix::removeDot( Dot dot ) const
+{
+	ResiduePair & p = mPairs[dot];
+	--mColumnCounts[p.mCol];
+	p.mCol = NO_POS;
+
+	// the row index points to the first dot in a row that has not been removed
+	const Position row = p.mRow;
+	if (mIndex[row] != dot)
+		return;
+
+	const Dot ndots = mPairs.size();
+	Dot next = dot + 1;
+	while (next < ndots && mPairs[next].mRow == row && mPairs[next].mCol == NO_POS)
+		++next;
+
+	mIndex[row] = (next < ndots && mPairs[next].mRow == row) ? next : NODOT;
+}
+
+//--------------------------------------------------------------------------------------------------------------
+void ImplAlignmentMatrix::finishRemoval( Dot n ) const
+{
+	if (n == 0)
+		return;
+
+	mNumRemoved += n;
+	setLength( mPairs.size() - mNumRemoved );
+
+	if (mPairs.size() == (size_t)mNumRemoved)
+	{
+		mRowFrom = mRowTo = mColFrom = mColTo = NO_POS;
+		return;
+	}
+
+	// shrink boundaries. Empty rows and columns are skipped only once.
+	while (mIndex[mRowFrom] == NODOT) ++mRowFrom;
+	while (mIndex[mRowTo - 1] == NODOT) --mRowTo;
+	while (mColumnCounts[mColFrom] == 0) ++mColFrom;
+	while (mColumnCounts[mColTo - 1] == 0) --mColTo;
+
+	// compact, once most dots have been removed. The cost is 
+	// linear in the number of removed dots.
+	if (2 * mNumRemoved > (Dot)mPairs.size())
+	{
+		removeTombstones();
+		mColumnDots.clear();
+		mColumnStarts.clear();
+		mColumnCounts.clear();
+		buildIndex();
+	}
+}
+
+//--------------------------------------------------------------------------------------------------------------
+void ImplAlignmentMatrix::removeRowRegion( Position from, Position to )
+{
+	debug_func_cerr(5);
+
+	if (!hasRowOrder())
+	{
+		ImplAlignment::removeRowRegion( from, to );
+		return;
+	}
+
+	if (mChangedLength) calculateLength();
+	if (getLength() == 0)
+		return;
+
+	from = std::max( from, mRowFrom );
+	to = std::min( to, mRowTo );
+	if (from >= to)
+		return;
+
+	if (mColumnCounts.empty())
+		buildColumnIndex();
+
+	const Dot ndots = mPairs.size();
+	Dot nremoved = 0;
+
+	for (Position row = from; row < to; ++row)
+	{
+		Dot dot = mIndex[row];
+		if (dot == NODOT)
+			continue;
+		for (; dot < ndots && mPairs[dot].mRow == row; ++dot)
+		{
+			ResiduePair & p = mPairs[dot];
+			if (p.mCol == NO_POS)
+				continue;
+			--mColumnCounts[p.mCol];
+			p.mCol = NO_POS;
+			++nremoved;
+		}
+		mIndex[row] = NODOT;
+	}
+
+	finishRemoval( nremoved );
+}
+
+//--------------------------------------------------------------------------------------------------------------
+void ImplAlignmentMatrix::removeColRegion( Position from, Position to )
+{
+	debug_func_cerr(5);
+
+	if (!hasRowOrder())
+	{
+		ImplAlignment::removeColRegion( from, to );
+		return;
+	}
+
+	if (mChangedLength) calculateLength();
+	if (getLength() == 0)
+		return;
+
+	from = std::max( from, mColFrom );
+	to = std::min( to, mColTo );
+	if (from >= to)
+		return;
+
+	if (mColumnCounts.empty())
+		buildColumnIndex();
+
+	Dot nremoved = 0;
+
+	for (Position col = from; col < to; ++col)
+	{
+		if (mColumnCounts[col] == 0)
+			continue;
+		for (Dot x = mColumnStarts[col]; x < mColumnStarts[col+1]; ++x)
+		{
+			const Dot dot = mColumnDots[x];
+			if (mPairs[dot].mCol == NO_POS)
+				continue;
+			removeDot( dot );
+			++nremoved;
+		}
+	}
+
+	finishRemoval( nremoved );
+}
+
 } // namespace alignlib
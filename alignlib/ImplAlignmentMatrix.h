@@ -108,6 +108,7 @@ class ImplAlignmentMatrix : public ImplAlignment
 				   Position index, 
 				   Position max_index ) :
 	mPairs( pairs ), mCurrentIndex(index), mMaximumIndex( max_index) {
+	  skipRemovedForward();
 	};
 	
 	ImplAlignmentMatrix_Iterator( const ImplAlignmentMatrix_Iterator & src ) : 
@@ -133,10 +134,24 @@ class ImplAlignmentMatrix : public ImplAlignment
 	}
       
 	/** advance one position, until you find an aligned pair */
-	virtual void next() { mCurrentIndex++; if (mCurrentIndex > mMaximumIndex) mCurrentIndex = mMaximumIndex; }
+	virtual void next() { mCurrentIndex++; skipRemovedForward(); if (mCurrentIndex > mMaximumIndex) mCurrentIndex = mMaximumIndex; }
 	
 	/** step back one position, until you find an aligned pair */
-	virtual void previous() { mCurrentIndex--; if (mCurrentIndex < -1) mCurrentIndex = -1; }
+	virtual void previous() { mCurrentIndex--; skipRemovedBackward(); if (mCurrentIndex < -1) mCurrentIndex = -1; }
+	
+    private:
+	/** skip over removed dots */
+	void skipRemovedForward() 
+	{ 
+		while (mCurrentIndex >= 0 && mCurrentIndex < mMaximumIndex && mPairs[mCurrentIndex].mCol == NO_POS)
+			++mCurrentIndex;
+	}
+
+	void skipRemovedBackward() 
+	{ 
+		while (mCurrentIndex >= 0 && mCurrentIndex < mMaximumIndex && mPairs[mCurrentIndex].mCol == NO_POS)
+			--mCurrentIndex;
+	}
 	
     private:
 	const PAIRVECTOR & mPairs;
@@ -163,12 +178,31 @@ class ImplAlignmentMatrix : public ImplAlignment
     /** adds a pair of residue to the alignment */
     virtual void addPair( const ResiduePair & new_pair ); 
 
+    /** reserve space for n residue pairs */
+    virtual void reserve( Position n );
+
+    /** adds n residue pairs to the alignment */
+    virtual void addPairs(
+    		const ResiduePair * pairs,
+    		Position n,
+    		bool already_sorted = false );
+
     /** removes a pair of residues from the alignment */
     virtual void removePair( const ResiduePair & old_pair );
 
     /** retrieves a pair of residues from the alignment */
     virtual ResiduePair getPair( const ResiduePair & p) const;
 
+    /** remove all dots in rows from to to. 
+     
+     	If the dots are sorted by row, the dots are removed in place: they are 
+     	marked as removed and the row index is patched for the affected rows only.
+     */
+    virtual void removeRowRegion( Position from, Position to );
+
+    /** remove all dots in columns from to to. See @ref removeRowRegion. */
+    virtual void removeColRegion( Position from, Position to );
+
     /** clear the current alignemnt */
     virtual void clear();
 
@@ -180,6 +214,9 @@ class ImplAlignmentMatrix : public ImplAlignment
     /** sort Dots by row and col */
     virtual void sortDots() const = 0;
 
+    /** true, if sortDots sorts by row and then by column. The default is false. */
+    virtual bool hasRowOrder() const;
+
     /** calculate alignment length */
     virtual void calculateLength() const;
 
@@ -206,8 +243,40 @@ class ImplAlignmentMatrix : public ImplAlignment
     /** index of pairs for each row */
     mutable Dot * mIndex;
 
+    /** true, if mPairs is sorted by row and then by column without duplicates.
+     * Sorting can then be skipped in @ref calculateLength.
+     */
+    mutable bool mSortedByRow;
+
 	/** update boundaries in case alignment length has changed */
 	virtual void updateBoundaries() const;
+
+    /** build an index of dots by column for in-place removal of regions */
+    void buildColumnIndex() const;
+
+    /** mark dot as removed and patch the row index */
+    void removeDot( Dot dot ) const;
+
+    /** update length and boundaries after n dots have been removed in place */
+    void finishRemoval( Dot n ) const;
+
+    /** delete all dots marked as removed from mPairs */
+    void removeTombstones() const;
+
+    /** number of dots in mPairs that have been marked as removed. Removed 
+     * dots keep their row, but their column is set to NO_POS.
+     */
+    mutable Dot mNumRemoved;
+
+    /** dots sorted by column. Dots in column c are in
+     * mColumnDots[mColumnStarts[c]..mColumnStarts[c+1]]. The index is built 
+     * on first removal of a region and is discarded, once dots move in mPairs.
+     */
+    mutable std::vector<Dot> mColumnDots;
+    mutable std::vector<Dot> mColumnStarts;
+
+    /** number of dots, that have not been removed, in each column */
+    mutable std::vector<Position> mColumnCounts;
     
  private:
     /* allocated size of size */
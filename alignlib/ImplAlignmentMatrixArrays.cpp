@@ -0,0 +1,331 @@
+/*
+  alignlib - a library for aligning protein sequences
+
+  $Id$
+
+  Copyright (C) 2026 Andreas Heger
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+*/
+
+
+#include <iostream>
+#include <algorithm>
+#include <limits>
+#include <cassert>
+#include "alignlib_fwd.h"
+#include "alignlib_interfaces.h"
+#include "AlignlibDebug.h"
+#include "ImplAlignmentMatrixArrays.h"
+#include "AlignmentIterator.h"
+#include "AlignlibException.h"
+
+using namespace std;
+
+namespace alignlib
+{
+
+#define NODOT -1
+
+//------------------------------factory functions -----------------------------
+HAlignment makeAlignmentMatrixArrays()
+{
+	debug_func_cerr(5);
+
+	return HAlignment( new ImplAlignmentMatrixArrays() );
+}
+
+//------------------------------------< constructors and destructors >-----
+ImplAlignmentMatrixArrays::ImplAlignmentMatrixArrays() :
+	ImplAlignment(),
+	mSortedByRow(true)
+{
+	debug_func_cerr(5);
+}
+
+ImplAlignmentMatrixArrays::ImplAlignmentMatrixArrays( const ImplAlignmentMatrixArrays & src ) :
+	ImplAlignment( src ),
+	mRows( src.mRows ),
+	mCols( src.mCols ),
+	mScores( src.mScores ),
+	mIndex( src.mIndex ),
+	mSortedByRow( src.mSortedByRow )
+{
+	debug_func_cerr(5);
+}
+
+ImplAlignmentMatrixArrays::~ImplAlignmentMatrixArrays()
+{
+	debug_func_cerr(5);
+}
+
+//------------------------------------------------------------------------------------------------------------
+HAlignment ImplAlignmentMatrixArrays::getNew() const
+{
+	return HAlignment( new ImplAlignmentMatrixArrays() );
+}
+
+HAlignment ImplAlignmentMatrixArrays::getClone() const
+{
+	return HAlignment( new ImplAlignmentMatrixArrays( *this ) );
+}
+
+//-----------------------------------------------------------------------------------------------------------
+AlignmentIterator ImplAlignmentMatrixArrays::begin() const
+{
+	if (mChangedLength) calculateLength();
+	return AlignmentIterator( new ImplAlignmentMatrixArrays_Iterator( *this, 0 ) );
+}
+
+AlignmentIterator ImplAlignmentMatrixArrays::end() const
+{
+	if (mChangedLength) calculateLength();
+	return AlignmentIterator( new ImplAlignmentMatrixArrays_Iterator( *this, mRows.size() ) );
+}
+
+//----------------> accessors <------------------------------------------------------------------------------
+ResiduePair ImplAlignmentMatrixArrays::front() const
+{
+	if (mChangedLength) calculateLength();
+	return (mRows.size() > 0) ?
+			ResiduePair( mRows.front(), mCols.front(), mScores.front() ) :
+			ResiduePair(NO_POS,NO_POS,0);
+}
+
+ResiduePair ImplAlignmentMatrixArrays::back() const
+{
+	if (mChangedLength) calculateLength();
+	return (mRows.size() > 0) ?
+			ResiduePair( mRows.back(), mCols.back(), mScores.back() ) :
+			ResiduePair(NO_POS,NO_POS,0);
+}
+
+//-------------------------------------------------------------------------------------------------------------
+void ImplAlignmentMatrixArrays::addPair( const ResiduePair & pair )
+{
+	ImplAlignment::addPair( pair );
+
+	if (!mRows.empty() &&
+			(mRows.back() > pair.mRow || (mRows.back() == pair.mRow && mCols.back() >= pair.mCol)))
+		mSortedByRow = false;
+
+	mRows.push_back( pair.mRow );
+	mCols.push_back( pair.mCol );
+	mScores.push_back( pair.mScore );
+}
+
+//-------------------------------------------------------------------------------------------------------------
+void ImplAlignmentMatrixArrays::reserve( Position n )
+{
+	mRows.reserve( n );
+	mCols.reserve( n );
+	mScores.reserve( n );
+}
+
+//-------------------------------------------------------------------------------------------------------------
+void ImplAlignmentMatrixArrays::addPairs(
+		const ResiduePair * pairs,
+		Position n,
+		bool already_sorted )
+{
+	debug_func_cerr( 5 );
+	if (n <= 0)
+		return;
+
+	if (!already_sorted || (!mRows.empty() &&
+			(mRows.back() > pairs[0].mRow || (mRows.back() == pairs[0].mRow && mCols.back() >= pairs[0].mCol))))
+		mSortedByRow = false;
+
+	const size_t size = mRows.size();
+	mRows.resize( size + n );
+	mCols.resize( size + n );
+	mScores.resize( size + n );
+
+	Position row_from = pairs[0].mRow, row_to = pairs[0].mRow;
+	Position col_from = pairs[0].mCol, col_to = pairs[0].mCol;
+	for (Position x = 0; x < n; ++x)
+	{
+		const Position row = pairs[x].mRow;
+		const Position col = pairs[x].mCol;
+		if (row < row_from) row_from = row;
+		if (row > row_to) row_to = row;
+		if (col < col_from) col_from = col;
+		if (col > col_to) col_to = col;
+		mRows[size + x] = row;
+		mCols[size + x] = col;
+		mScores[size + x] = pairs[x].mScore;
+	}
+
+	if (mRowFrom == NO_POS)
+	{
+		mRowFrom = row_from;
+		mColFrom = col_from;
+		mRowTo = row_to + 1;
+		mColTo = col_to + 1;
+	}
+	else
+	{
+		mRowFrom = std::min( mRowFrom, row_from );
+		mColFrom = std::min( mColFrom, col_from );
+		mRowTo = std::max( mRowTo, row_to + 1 );
+		mColTo = std::max( mColTo, col_to + 1 );
+	}
+	setChangedLength();
+}
+
+//-------------------------------------------------------------------------------------------------------------
+/** retrieves a pair of residues from the alignment */
+ResiduePair ImplAlignmentMatrixArrays::getPair( const ResiduePair & p) const
+{
+	/** generic implementation - returns any pair of row */
+	for (size_t x = 0; x < mRows.size(); ++x)
+		if (mRows[x] == p.mRow)
+			return ResiduePair( mRows[x], mCols[x], mScores[x] );
+
+	return ResiduePair();
+}
+
+//-------------------------------------------------------------------------------------------------------------
+void ImplAlignmentMatrixArrays::removePair( const ResiduePair & p )
+{
+	debug_func_cerr(5);
+
+	// keep order of remaining dots
+	size_t y = 0;
+	for (size_t x = 0; x < mRows.size(); ++x)
+	{
+		if (mRows[x] == p.mRow && mCols[x] == p.mCol)
+			continue;
+		mRows[y] = mRows[x];
+		mCols[y] = mCols[x];
+		mScores[y] = mScores[x];
+		++y;
+	}
+	mRows.resize( y );
+	mCols.resize( y );
+	mScores.resize( y );
+
+	updateBoundaries();
+	setChangedLength();
+}
+
+//--------------> mapping functions <----------------------------------------------------------------------------
+Position ImplAlignmentMatrixArrays::mapRowToCol( Position pos, SearchType search ) const
+{
+	if (mChangedLength) calculateLength();
+	Position index;
+	if (pos >= mRowFrom && pos < mRowTo)
+		if ( (index = mIndex[pos]) != NO_POS )
+			return mCols[index];
+
+	return NO_POS;
+}
+
+//--------------------------------------------------------------------------------------------------------
+void ImplAlignmentMatrixArrays::clear()
+{
+	debug_func_cerr(5);
+
+	ImplAlignment::clear();
+
+	mRows.clear();
+	mCols.clear();
+	mScores.clear();
+	mIndex.clear();
+	mSortedByRow = true;
+}
+
+//-----------------------------------------------------------------------------------------------------------
+void ImplAlignmentMatrixArrays::updateBoundaries() const
+{
+	mRowFrom = mRowTo = mColFrom = mColTo = NO_POS;
+
+	// ignore empty alignments
+	if (mRows.empty())
+		return;
+
+	mRowFrom = *std::min_element( mRows.begin(), mRows.end() );
+	mRowTo = *std::max_element( mRows.begin(), mRows.end() ) + 1;
+	mColFrom = *std::min_element( mCols.begin(), mCols.end() );
+	mColTo = *std::max_element( mCols.begin(), mCols.end() ) + 1;
+}
+
+//------------------------------------> sorting subroutines <-----------------------------------------------
+/** compare dots by row and then by column */
+struct SortPredicateArrays
+{
+	SortPredicateArrays( const std::vector<Position> & rows, const std::vector<Position> & cols ) :
+		mRows(rows), mCols(cols) {};
+	bool operator()( Dot lhs, Dot rhs ) const
+	{
+		if (mRows[lhs] == mRows[rhs])
+			return mCols[lhs] < mCols[rhs];
+		return mRows[lhs] < mRows[rhs];
+	}
+	const std::vector<Position> & mRows;
+	const std::vector<Position> & mCols;
+};
+
+//--------------------------------------------------------------------------------------------------------------
+void ImplAlignmentMatrixArrays::calculateLength() const
+{
+	debug_func_cerr(5);
+
+	mChangedLength = false;
+	setNumGaps(0);
+
+	if (!mSortedByRow)
+	{
+		// 1. sort dots via a permutation and eliminate duplicates
+		std::vector<Dot> order( mRows.size() );
+		for (size_t x = 0; x < order.size(); ++x)
+			order[x] = x;
+		std::sort( order.begin(), order.end(), SortPredicateArrays( mRows, mCols ) );
+
+		std::vector<Position> rows, cols;
+		std::vector<Score> scores;
+		rows.reserve( order.size() );
+		cols.reserve( order.size() );
+		scores.reserve( order.size() );
+
+		for (size_t x = 0; x < order.size(); ++x)
+		{
+			const Dot dot = order[x];
+			if (!rows.empty() && rows.back() == mRows[dot] && cols.back() == mCols[dot])
+				continue;
+			rows.push_back( mRows[dot] );
+			cols.push_back( mCols[dot] );
+			scores.push_back( mScores[dot] );
+		}
+		mRows.swap( rows );
+		mCols.swap( cols );
+		mScores.swap( scores );
+		mSortedByRow = true;
+	}
+
+	setLength( mRows.size() );
+	updateBoundaries();
+
+	// 2. build index for quick access by row
+	mIndex.clear();
+	if (mRows.empty())
+		return;
+
+	mIndex.assign( mRowTo, NODOT );
+	for (Position x = mRows.size() - 1; x >= 0; --x)
+		mIndex[mRows[x]] = x;
+}
+
+} // namespace alignlib
@@ -0,0 +1,199 @@
+/*
+  alignlib - a library for aligning protein sequences
+
+  $Id$
+
+  Copyright (C) 2026 Andreas Heger
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+*/
+
+#if HAVE_CONFIG_H
+#include <config.h>
+#endif
+
+#ifndef IMPL_ALIGNATA_MATRIX_ARRAYS_H
+#define IMPL_ALIGNATA_MATRIX_ARRAYS_H 1
+
+#include <iosfwd>
+#include <vector>
+#include "alignlib_fwd.h"
+#include "ImplAlignment.h"
+
+namespace alignlib
+{
+
+/** @brief dotplot with dots sorted by row and then col, kept in separate arrays.
+
+    This is the same as @ref ImplAlignmentMatrixRow, but rows, columns and
+    scores of dots are stored in three separate arrays instead of a list
+    of @ref ResiduePair. Algorithms that look only at rows and columns
+    of dots, for example @ref ImplAlignatorDots, read half the memory.
+
+    As there are no @ref ResiduePair objects in memory, the iterator
+    returns a copy of the current pair. As for @ref ImplAlignmentBlocks,
+    two iterators compare equal only at the end.
+
+    @author Andreas Heger
+    @version $Id$
+*/
+class ImplAlignmentMatrixArrays : public ImplAlignment
+{
+
+    friend class ImplAlignatorDots;
+
+ public:
+
+    //------------------> constructors / destructors <---------------------------------------------------------
+    /** constructor */
+    ImplAlignmentMatrixArrays();
+
+    /** copy constructor */
+    ImplAlignmentMatrixArrays( const ImplAlignmentMatrixArrays &src );
+
+    /** destructor */
+    virtual ~ImplAlignmentMatrixArrays();
+
+    //------------------------------------------------------------------------------------------------------------
+    virtual HAlignment getNew() const;
+
+    /** return an identical copy */
+    virtual HAlignment getClone() const;
+
+    //------------------------------------------------------------------------------------------------------------
+
+    class ImplAlignmentMatrixArrays_Iterator : public Alignment::Iterator
+    {
+    public:
+
+      ImplAlignmentMatrixArrays_Iterator( const ImplAlignmentMatrixArrays & matrix,
+    		  Position index ) :
+    	  mMatrix( matrix ), mCurrentIndex( index ) { setPair(); };
+
+      ImplAlignmentMatrixArrays_Iterator( const ImplAlignmentMatrixArrays_Iterator & src ) :
+    	  mMatrix( src.mMatrix ), mCurrentIndex( src.mCurrentIndex ), mPair( src.mPair ) {};
+
+      virtual ~ImplAlignmentMatrixArrays_Iterator() {};
+
+      virtual Iterator * getClone() const {return new ImplAlignmentMatrixArrays_Iterator( *this );}
+
+      /** dereference operator */
+      virtual const ResiduePair & getReference() const { return mPair; }
+
+      /** for indirection */
+      virtual const ResiduePair * getPointer() const
+      {
+    	  if (mCurrentIndex >= 0 && mCurrentIndex < (Position)mMatrix.mRows.size())
+    		  return &mPair;
+    	  else
+    		  return NULL;
+      }
+
+      /** advance one position */
+      virtual void next()
+      {
+    	  if (mCurrentIndex < (Position)mMatrix.mRows.size()) ++mCurrentIndex;
+    	  setPair();
+      }
+
+      /** step back one position */
+      virtual void previous()
+      {
+    	  if (mCurrentIndex >= 0) --mCurrentIndex;
+    	  setPair();
+      }
+
+    private:
+      /** copy the current dot */
+      void setPair()
+      {
+    	  if (mCurrentIndex >= 0 && mCurrentIndex < (Position)mMatrix.mRows.size())
+    		  mPair = ResiduePair( mMatrix.mRows[mCurrentIndex],
+    				  mMatrix.mCols[mCurrentIndex],
+    				  mMatrix.mScores[mCurrentIndex] );
+      }
+
+      const ImplAlignmentMatrixArrays & mMatrix;
+      Position mCurrentIndex;
+      ResiduePair mPair;
+    };
+
+    /** return const iterator */
+    virtual AlignmentIterator begin() const;
+
+    /** return const iterator */
+    virtual AlignmentIterator end() const;
+
+    //----------------> accessors <------------------------------------------------------------------------------
+
+    /** returns the first aligned pair */
+    virtual ResiduePair front() const;
+
+    /** returns the last aligned pair */
+    virtual ResiduePair back() const;
+
+    /** adds a pair of residue to the alignment */
+    virtual void addPair( const ResiduePair & new_pair );
+
+    /** reserve space for n residue pairs */
+    virtual void reserve( Position n );
+
+    /** adds n residue pairs to the alignment */
+    virtual void addPairs(
+    		const ResiduePair * pairs,
+    		Position n,
+    		bool already_sorted = false );
+
+    /** removes a pair of residues from the alignment */
+    virtual void removePair( const ResiduePair & old_pair );
+
+    /** retrieves a pair of residues from the alignment */
+    virtual ResiduePair getPair( const ResiduePair & p) const;
+
+    /** maps a residue from row to column. The smallest column is returned. */
+    virtual Position mapRowToCol( Position pos, SearchType search = NO_SEARCH ) const;
+
+    /** clear the current alignemnt */
+    virtual void clear();
+
+ protected:
+
+    /** sort dots, remove duplicates and build the index */
+    virtual void calculateLength() const;
+
+	/** update boundaries in case alignment length has changed */
+	virtual void updateBoundaries() const;
+
+    /** rows of dots, mutable, because they get sorted in-situ */
+    mutable std::vector<Position> mRows;
+
+    /** columns of dots */
+    mutable std::vector<Position> mCols;
+
+    /** scores of dots */
+    mutable std::vector<Score> mScores;
+
+    /** index of first dot for each row */
+    mutable std::vector<Dot> mIndex;
+
+    /** true, if dots are sorted by row and then by column without duplicates */
+    mutable bool mSortedByRow;
+};
+
+typedef boost::shared_ptr<ImplAlignmentMatrixArrays> HImplAlignmentMatrixArrays;
+
+}
+
+#endif /* IMPL_ALIGNATA_MATRIX_ARRAYS_H */
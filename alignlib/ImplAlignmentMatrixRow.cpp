@@ -119,6 +119,11 @@ void ImplAlignmentMatrixRow::sortDots() const
   
 }
 
+bool ImplAlignmentMatrixRow::hasRowOrder() const
+{
+  return true;
+}
+
 
 //--------------------------------------------------------------------------------------------------------------
 // build the index
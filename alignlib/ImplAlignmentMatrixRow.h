@@ -75,6 +75,9 @@ class ImplAlignmentMatrixRow : public ImplAlignmentMatrix
     /** sort Dots by row and col */
     virtual void sortDots() const;
 
+    /** dots are sorted by row and col */
+    virtual bool hasRowOrder() const;
+
     
 };
 
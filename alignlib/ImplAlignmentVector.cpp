@@ -119,6 +119,50 @@ void ImplAlignmentVector::addPair( const ResiduePair & new_pair )
 	mPairs[new_row] = new_pair;
 }
 
+//--------------------------------------------------------------------------------------------------------------
+void ImplAlignmentVector::addPairs(
+		const ResiduePair * pairs,
+		Position n,
+		bool already_sorted )
+{
+	debug_func_cerr( 5 );
+	if (n <= 0)
+		return;
+
+	// pairs sorted by row end in the last row
+	Position max_row = pairs[n-1].mRow;
+	if (!already_sorted)
+		for (Position x = 0; x < n - 1; ++x)
+			max_row = std::max( max_row, pairs[x].mRow );
+
+	if (mPairs.size() < (size_t)max_row + 1)
+		mPairs.resize( max_row + 1, ResiduePair() );
+
+	for (Position x = 0; x < n; ++x)
+	{
+		const ResiduePair & pair = pairs[x];
+		assert( pair.mRow >= 0);
+		assert( pair.mCol >= 0);
+
+		if (mRowFrom == NO_POS)
+		{
+			mRowFrom = pair.mRow;
+			mColFrom = pair.mCol;
+			mRowTo = pair.mRow + 1;
+			mColTo = pair.mCol + 1;
+		}
+		else
+		{
+			if (pair.mRow < mRowFrom) mRowFrom = pair.mRow;
+			if (pair.mRow >= mRowTo) mRowTo = pair.mRow + 1;
+			if (pair.mCol < mColFrom) mColFrom = pair.mCol;
+			if (pair.mCol >= mColTo) mColTo = pair.mCol + 1;
+		}
+		mPairs[pair.mRow] = pair;
+	}
+	setChangedLength();
+}
+
 //--------------------------------------------------------------------------------------------------------------
 void ImplAlignmentVector::moveAlignment( Position row_offset, Position col_offset)
 {
@@ -178,6 +178,14 @@ public:
 	/** adds a pair of residue to the alignment */
 	virtual void addPair( const ResiduePair & pair );
 
+	/** adds n residue pairs to the alignment.
+	 *
+	 * The container is resized only once. */
+	virtual void addPairs(
+			const ResiduePair * pairs,
+			Position n,
+			bool already_sorted = false );
+
 	/** removes a pair of residues from the alignment */
 	virtual void removePair( const ResiduePair & old_pair );
 
@@ -19,6 +19,8 @@
 #include "AlignlibDebug.h"
 #include "AlignlibException.h"
 #include "DistanceMatrix.h"
+#include "EncodedMultipleAlignment.h"
+#include "HelpersMultipleAlignment.h"
 
 using namespace std;
 
@@ -50,10 +52,60 @@ void ImplDistor::calculateMatrix(
     if (matrix->getWidth() != width)
 	throw AlignlibException( "Multiple alignment and matrix have different size in ImplDistor::operator()");
 
-    for (i = 0; i < width - 1; i++)
+    calculateMatrix( matrix, makeEncodedMultipleAlignment( multali, getToolkit()->getEncoder() ) );
+}
+
+//--------------------------------------------------------------------------------------------------------------------------------
+void ImplDistor::calculateMatrix(
+		HDistanceMatrix & matrix,
+		const HEncodedMultipleAlignment & multali) const
+{
+	debug_func_cerr(5);
+
+    DistanceMatrixSize i, j;
+
+    DistanceMatrixSize width = multali->getNumSequences();
+
+    if (matrix->getWidth() != width)
+	throw AlignlibException( "Multiple alignment and matrix have different size in ImplDistor::operator()");
+
+    Position identities, aligned;
+    for (i = 0; i + 1 < width; i++)
       for (j = i + 1; j < width; j++)
-	(*matrix)(i, j) = calculateDistance( (*multali)[i], (*multali)[j] );
+      {
+    	  multali->compareRows( i, j, identities, aligned );
+    	  (*matrix)(i, j) = calculateDistanceFromIdentities( identities, aligned );
+      }
+}
+
+//--------------------------------------------------------------------------------------------------------------------------------
+DistanceMatrixValue ImplDistor::calculateDistance(
+		const std::string & s_row_1,
+		const std::string & s_row_2) const
+{
+	debug_func_cerr(5);
+
+	const HEncoder & encoder = getToolkit()->getEncoder();
+	const Residue width = encoder->getAlphabetSize();
+
+	Position identities = 0;
+	Position aligned = 0;
+
+	for (size_t i = 0; i < s_row_1.length(); i++)
+	{
+		Residue a = encoder->encode( s_row_1[i] );
+		Residue b = encoder->encode( s_row_2[i] );
+		if (a < width && b < width)
+		{
+			aligned++;
+			if (a == b)
+				identities++;
+		}
+	}
+
+	debug_cerr( 3, "Comparison between " << s_row_1 << " and " << s_row_2 << ": non_gaps=" << aligned << " identitities=" << identities );
 
+	return calculateDistanceFromIdentities( identities, aligned );
 }
 
 
@@ -52,14 +52,32 @@ class ImplDistor : public Distor, public ImplAlignlibBase
     		HDistanceMatrix & dest,
     		const HMultipleAlignment & mali ) const ;
 
-    /** Calculate distance between two rows from multiple alignment */
+    /** calculate a distance matrix from an encoded multiple alignment */
+    virtual void calculateMatrix(
+    		HDistanceMatrix & dest,
+    		const HEncodedMultipleAlignment & mali ) const ;
+
+    /** Calculate distance between two rows from multiple alignment.
+     *
+     * The rows are encoded and compared in the same way as in
+     * @ref calculateMatrix.
+     */
     virtual DistanceMatrixValue calculateDistance(
     		const std::string & s_row_1,
-    		const std::string & s_row_2) const = 0;
+    		const std::string & s_row_2) const;
 
 
  protected:
 
+    /** calculate distance from the number of identical and aligned positions
+     *
+     * @param identities number of aligned positions with identical residues.
+     * @param aligned number of positions without a gap in either sequence.
+     */
+    virtual DistanceMatrixValue calculateDistanceFromIdentities(
+    		Position identities,
+    		Position aligned ) const = 0;
+
     /** length of multiple alignment */
     mutable int mLength;
 
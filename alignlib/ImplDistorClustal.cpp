@@ -109,25 +109,10 @@ DistanceMatrixValue ImplDistorClustal::getMaximumPossibleDistance() const
 }
 
 //--------------------------------------------------------------------------------------------------------------------------------
-DistanceMatrixValue ImplDistorClustal::calculateDistance( const std::string & s_row_1, const std::string & s_row_2) const
+DistanceMatrixValue ImplDistorClustal::calculateDistanceFromIdentities(
+		Position identities,
+		Position n_nongaps ) const
 {
-
-	debug_func_cerr( 5 );
-
-  unsigned char gap_char  = getToolkit()->getEncoder()->getGapChar();
-
-  unsigned int i;
-  DistanceMatrixSize identities = 0;
-  DistanceMatrixSize n_nongaps = 0;		// normalize over non-gap-positions
-
-  for (i = 0; i < s_row_1.length(); i++) {
-    if ((s_row_1[i] != gap_char) && (s_row_2[i] != gap_char)) {
-      n_nongaps ++;
-      if (s_row_1[i] == s_row_2[i])
-	identities++;
-    }
-  }
-
   double pdiff;
   if (n_nongaps > 0)
     pdiff = 1.0 - (double)identities / (double)n_nongaps;
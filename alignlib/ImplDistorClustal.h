@@ -59,7 +59,11 @@ class ImplDistorClustal : public ImplDistor {
     virtual DistanceMatrixValue getMaximumPossibleDistance() const;
 
     /** Calculate distance between two rows from multiple alignment */
-    virtual DistanceMatrixValue calculateDistance( const std::string & s_row_1, const std::string & s_row_2) const ;
+ protected:
+    /** Calculate distance from the number of identical and aligned positions */
+    virtual DistanceMatrixValue calculateDistanceFromIdentities(
+    		Position identities,
+    		Position aligned ) const;
 
 };
 
@@ -74,6 +74,30 @@ void ImplDistorDummy::calculateMatrix( HDistanceMatrix & matrix,
 
 }
 
+//--------------------------------------------------------------------------------------------------------------------------------
+void ImplDistorDummy::calculateMatrix( HDistanceMatrix & matrix,
+		const HEncodedMultipleAlignment & multali) const
+{
+	debug_func_cerr( 5 );
+
+    DistanceMatrixSize i, j;
+    DistanceMatrixSize width = mMatrix->getWidth();
+
+    matrix->setWidth( width );
+
+    for (i = 0; i < width - 1; i++)
+    	for (j = i + 1; j < width; j++)
+    		(*matrix)(i, j) = (*mMatrix)(i, j);
+}
+
+//--------------------------------------------------------------------------------------------------------------------------------
+DistanceMatrixValue ImplDistorDummy::calculateDistanceFromIdentities(
+		Position identities,
+		Position aligned ) const
+{
+	return 0;
+}
+
 //--------------------------------------------------------------------------------------------------------------------------------
 DistanceMatrixValue ImplDistorDummy::calculateDistance( const std::string & s_row_1, const std::string & s_row_2) const
 {
@@ -58,9 +58,19 @@ class ImplDistorDummy : public ImplDistor
     virtual void calculateMatrix( HDistanceMatrix & dest,
     		const alignlib::HMultipleAlignment mali ) const ;
 
+    /** copy the distance matrix, the multiple alignment is ignored */
+    virtual void calculateMatrix( HDistanceMatrix & dest,
+    		const HEncodedMultipleAlignment & mali ) const ;
+
     /** Calculate distance between two rows from multiple alignment */
     virtual DistanceMatrixValue calculateDistance( const std::string & s_row_1, const std::string & s_row_2) const;
 
+ protected:
+    /** Calculate distance from the number of identical and aligned positions */
+    virtual DistanceMatrixValue calculateDistanceFromIdentities(
+    		Position identities,
+    		Position aligned ) const;
+
  private:
     /** the matrix for the source. I do not own it. */
     const HDistanceMatrix mMatrix;
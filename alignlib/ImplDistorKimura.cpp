@@ -60,30 +60,10 @@ DistanceMatrixValue ImplDistorKimura::getMaximumPossibleDistance() const
 }
 
 //--------------------------------------------------------------------------------------------------------------------------------
-DistanceMatrixValue ImplDistorKimura::calculateDistance(
-		const std::string & s_row_1,
-		const std::string & s_row_2) const
+DistanceMatrixValue ImplDistorKimura::calculateDistanceFromIdentities(
+		Position identities,
+		Position n_nongaps ) const
 {
-
-	debug_func_cerr(5);
-	unsigned int i;
-	unsigned int identities = 0;		// number of identities
-	unsigned int n_nongaps = 0;		// normalize over non-gap-positions
-
-	unsigned char gap_char = getToolkit()->getEncoder()->getGapChar();
-
-	for (i = 0; i < s_row_1.length(); i++)
-	{
-		if ((s_row_1[i] != gap_char) && (s_row_2[i] != gap_char))
-		{
-			n_nongaps ++;
-			if (s_row_1[i] == s_row_2[i])
-				identities++;
-		}
-	}
-
-	debug_cerr( 3, "Comparison between " << s_row_1 << " and " << s_row_2 << ": non_gaps=" << n_nongaps << " identitities=" << identities );
-
 	double pdiff;
 	if (n_nongaps > 0)
 		pdiff = 1.0 - (double)identities / (double)n_nongaps;
@@ -58,10 +58,11 @@ class ImplDistorKimura : public ImplDistor
     /** return the maximum distance obtainable between two sequences */
     virtual DistanceMatrixValue getMaximumPossibleDistance() const;
 
-    /** Calculate distance between two rows from multiple alignment */
-    virtual DistanceMatrixValue calculateDistance(
-    		const std::string & s_row_1,
-    		const std::string & s_row_2) const ;
+ protected:
+    /** Calculate distance from the number of identical and aligned positions */
+    virtual DistanceMatrixValue calculateDistanceFromIdentities(
+    		Position identities,
+    		Position aligned ) const;
 
 };
 
@@ -22,6 +22,8 @@
 
 
 #include <iostream>
+#include <algorithm>
+#include <math.h>
 #include "alignlib_fwd.h"
 #include "alignlib_interfaces.h"
 #include "alignlib_fwd.h"
@@ -43,6 +45,7 @@
 #include "HelpersAlignator.h"
 
 #include "HelpersToolkit.h"
+#include "Iterator2D.h"
 
 #include "ImplFragmentorIterative.h"
 
@@ -110,55 +113,293 @@ ImplFragmentorIterative::ImplFragmentorIterative(
 				const HAlignandum & row,
 				const HAlignandum & col )
 		{
-			// TODO: check for copy or reference
-			HAlignment original_dots = mDots;
-			// true, if mDots contains a copy of orignal alignata object.
-			// Make sure, you do not delete it.
-			bool is_copy = false;
+			debug_func_cerr(5);
+
+			// restrict dots to region to be aligned and sort them by row
+			HIterator2D iterator( getToolkit()->getIterator2D()->getNew( row, col ) );
+			HAlignment dots( makeAlignmentMatrixRow() );
+			copyAlignment( dots, mDots,
+					iterator->row_front(), iterator->row_back() + 1,
+					iterator->col_front(), iterator->col_back() + 1);
+
+			setupDots( dots );
+
+			// score all dots once
+			const Dot ndots = mRows.size();
+			for (Dot dot = 0; dot < ndots; ++dot)
+			{
+				scoreDot( dot );
+				linkDot( dot );
+			}
+
+			std::vector<Dot> dirty;
+			std::vector<ResiduePair> pairs;
 
 			while ( 1 )
 			{
-				HAlignator dottor(makeAlignatorPrebuilt( mDots ));
-				HAlignator alignator(makeAlignatorDots( dottor, mGop, mGep ));
+				// get the best dot that has not been removed. For ties, the
+				// first dot is used as in ImplAlignatorDots.
+				while (!mBestDots.empty())
+				{
+					const Dot dot = -mBestDots.top().second;
+					if (mAlive[dot] && mScores[dot] == mBestDots.top().first)
+						break;
+					mBestDots.pop();
+				}
 
-				HAlignment result = sample->getNew();
-				alignator->align( result, row, col );
+				if (mBestDots.empty())
+					break;
+
+				const Dot best_dot = -mBestDots.top().second;
 
-#ifdef DEBUG
-				if (AlignlibDebug::mVerbosity >= 5)
+				// trace back as ImplAlignatorDots::traceBack
+				pairs.clear();
+				Position jleft = row->getLength();
+				for (Dot dot = best_dot; dot >= 0; dot = mTrace[dot])
 				{
-					std::cerr << "starting alignment: " << *mDots << std::endl;
-					std::cerr << "result: " << *result << endl;
+					if (mRows[dot] > jleft) break;
+					jleft = mRows[dot];
+					pairs.push_back( ResiduePair( mRows[dot], mCols[dot], mDotScores[dot] ) );
 				}
-#endif
+				std::reverse( pairs.begin(), pairs.end() );
+
+				HAlignment result = sample->getNew();
+				result->addPairs( &pairs[0], pairs.size(), true );
+				result->setScore( round( mScores[best_dot] ) );
+
+				debug_cerr( 5, "result: " << *result );
+
+				if (result->getScore() < mMinScore)
+					break;
+
+				mFragments->push_back( result );
 
-				if (result->getScore() >= mMinScore)
+				// delete dots in rows and columns of region from dot-plot and
+				// re-score dots that traced back through them.
+				removeRegion( result->getRowFrom(), result->getRowTo(),
+						result->getColFrom(), result->getColTo(),
+						dirty );
+
+				for (size_t x = 0; x < dirty.size(); ++x)
 				{
-					mFragments->push_back( result );
+					const Dot dot = dirty[x];
+					unlinkDot( dot );
+					scoreDot( dot );
+					linkDot( dot );
+				}
+			}
+
+			while (!mBestDots.empty())
+				mBestDots.pop();
+		}
+
+		//------------------------------------------------------------------------------------------------
+		void ImplFragmentorIterative::setupDots( const HAlignment & dots )
+		{
+			debug_func_cerr(5);
 
-					// delete dots from dot-plot. Delete all dots in region
-					HAlignment copy = makeAlignmentMatrixUnsorted();
+			const Dot ndots = dots->getLength();
 
-					copyAlignmentWithoutRegion( copy,
-							mDots,
-							result->getRowFrom(),
-							result->getRowTo(),
-							result->getColFrom(),
-							result->getColTo());
+			mRows.resize( ndots );
+			mCols.resize( ndots );
+			mDotScores.resize( ndots );
 
-					// substitute new copy instead of old copy
-					mDots = copy;
-					is_copy = true;
+			AlignmentIterator it( dots->begin() ), it_end( dots->end() );
+			for (Dot dot = 0; it != it_end; ++it, ++dot)
+			{
+				mRows[dot] = (*it).mRow;
+				mCols[dot] = (*it).mCol;
+				mDotScores[dot] = (*it).mScore;
+			}
+
+			mRowFrom = dots->getRowFrom();
+			mColFrom = dots->getColFrom();
 
-				} else
+			// index dots by row and column. Dots are sorted by row.
+			mRowStarts.assign( std::max( 0, dots->getRowTo() - mRowFrom ) + 1, 0 );
+			mColumnStarts.assign( std::max( 0, dots->getColTo() - mColFrom ) + 1, 0 );
+
+			for (Dot dot = 0; dot < ndots; ++dot)
+			{
+				++mRowStarts[mRows[dot] - mRowFrom + 1];
+				++mColumnStarts[mCols[dot] - mColFrom + 1];
+			}
+			for (size_t x = 1; x < mRowStarts.size(); ++x)
+				mRowStarts[x] += mRowStarts[x-1];
+			for (size_t x = 1; x < mColumnStarts.size(); ++x)
+				mColumnStarts[x] += mColumnStarts[x-1];
+
+			mColumnDots.resize( ndots );
+			std::vector<Dot> fill( mColumnStarts );
+			for (Dot dot = 0; dot < ndots; ++dot)
+				mColumnDots[fill[mCols[dot] - mColFrom]++] = dot;
+
+			mScores.assign( ndots, 0 );
+			mTrace.assign( ndots, NO_POS );
+			mAlive.assign( ndots, 1 );
+			mFirstChild.assign( ndots, NO_POS );
+			mNextChild.assign( ndots, NO_POS );
+			mPreviousChild.assign( ndots, NO_POS );
+		}
+
+		//------------------------------------------------------------------------------------------------
+		/* This is the recursion in ImplAlignatorDots::performAlignment. For dots
+		 * with the same score, the trace goes to the dot in the largest column and
+		 * then the largest row, which is the last dot ImplAlignatorDots sees.
+		 */
+		void ImplFragmentorIterative::scoreDot( Dot dot )
+		{
+			const Position row = mRows[dot];
+			const Position col = mCols[dot];
+
+			Dot best_dot = NO_POS;
+			Score best_score = 0;
+
+			for (Dot x = 0; x < mRowStarts[row - mRowFrom]; )
+			{
+				const Position search_row = mRows[x];
+				const Dot row_end = mRowStarts[search_row - mRowFrom + 1];
+
+				for (; x < row_end && mCols[x] < col; ++x)
 				{
-					break;
+					if (!mAlive[x] || mScores[x] <= 0)
+						continue;
+
+					Score gap_cost = 0;
+					Position d;
+					if ((d = (row - search_row)) > 1)
+						gap_cost += mGop + d * mGep;
+					if ((d = (col - mCols[x])) > 1)
+						gap_cost += mGop + d * mGep;
+
+					const Score search_score = mScores[x] + gap_cost;
+
+					if (best_dot == NO_POS)
+					{
+						if (search_score < 0) continue;
+					}
+					else if (search_score < best_score ||
+							(search_score == best_score &&
+									(mCols[x] < mCols[best_dot] ||
+									(mCols[x] == mCols[best_dot] && search_row < mRows[best_dot]))))
+						continue;
+
+					best_score = search_score;
+					best_dot = x;
 				}
+				x = row_end;
+			}
 
+			if (best_dot == NO_POS)
+				best_score = mDotScores[dot];
+			else
+				best_score += mDotScores[dot];
+
+			// traces with score < 0 are skipped
+			if (best_score < 0)
+			{
+				mScores[dot] = 0;
+				mTrace[dot] = NO_POS;
+				return;
 			}
 
+			mScores[dot] = best_score;
+			mTrace[dot] = best_dot;
+
+			if (best_score > 0)
+				mBestDots.push( std::make_pair( best_score, -dot ) );
+		}
+
+		//------------------------------------------------------------------------------------------------
+		void ImplFragmentorIterative::linkDot( Dot dot )
+		{
+			const Dot parent = mTrace[dot];
+			if (parent == NO_POS)
+				return;
+
+			mPreviousChild[dot] = NO_POS;
+			mNextChild[dot] = mFirstChild[parent];
+			if (mFirstChild[parent] != NO_POS)
+				mPreviousChild[mFirstChild[parent]] = dot;
+			mFirstChild[parent] = dot;
 		}
 
+		void ImplFragmentorIterative::unlinkDot( Dot dot )
+		{
+			const Dot parent = mTrace[dot];
+			if (parent == NO_POS)
+				return;
+
+			if (mPreviousChild[dot] != NO_POS)
+				mNextChild[mPreviousChild[dot]] = mNextChild[dot];
+			else
+				mFirstChild[parent] = mNextChild[dot];
+
+			if (mNextChild[dot] != NO_POS)
+				mPreviousChild[mNextChild[dot]] = mPreviousChild[dot];
+
+			mNextChild[dot] = mPreviousChild[dot] = NO_POS;
+		}
+
+		//------------------------------------------------------------------------------------------------
+		/* Removing dots can only lower scores. Dots whose trace does not pass
+		 * through a removed dot keep their score and trace, so only the other
+		 * dots need to be re-scored. They are returned sorted by row, so that 
+		 * they can be re-scored in order.
+		 */
+		void ImplFragmentorIterative::removeRegion(
+				Position row_from, Position row_to,
+				Position col_from, Position col_to,
+				std::vector<Dot> & dirty )
+		{
+			debug_func_cerr(5);
+
+			std::vector<Dot> removed;
+
+			row_from = std::max( row_from, mRowFrom );
+			row_to = std::min( row_to, mRowFrom + (Position)mRowStarts.size() - 1 );
+			for (Position r = row_from; r < row_to; ++r)
+				for (Dot dot = mRowStarts[r - mRowFrom]; dot < mRowStarts[r - mRowFrom + 1]; ++dot)
+					if (mAlive[dot])
+					{
+						mAlive[dot] = 0;
+						removed.push_back( dot );
+					}
+
+			col_from = std::max( col_from, mColFrom );
+			col_to = std::min( col_to, mColFrom + (Position)mColumnStarts.size() - 1 );
+			for (Position c = col_from; c < col_to; ++c)
+				for (Dot x = mColumnStarts[c - mColFrom]; x < mColumnStarts[c - mColFrom + 1]; ++x)
+				{
+					const Dot dot = mColumnDots[x];
+					if (mAlive[dot])
+					{
+						mAlive[dot] = 0;
+						removed.push_back( dot );
+					}
+				}
+
+			for (size_t x = 0; x < removed.size(); ++x)
+				unlinkDot( removed[x] );
+
+			// collect dots tracing back to removed dots
+			dirty.clear();
+			while (!removed.empty())
+			{
+				const Dot parent = removed.back();
+				removed.pop_back();
+				for (Dot dot = mFirstChild[parent]; dot != NO_POS; dot = mNextChild[dot])
+				{
+					dirty.push_back( dot );
+					removed.push_back( dot );
+				}
+			}
+
+			std::sort( dirty.begin(), dirty.end() );
+
+			debug_cerr( 5, "removed region " << row_from << "-" << row_to << ":" << col_from << "-" << col_to
+					<< " dots to re-score=" << dirty.size() );
+		}
 
 } // namespace alignlib
 
@@ -28,6 +28,8 @@
 #ifndef IMPL_FRAGMENTOR_ITERATIVE_H
 #define IMPL_FRAGMENTOR_ITERATIVE_H 1
 
+#include <vector>
+#include <queue>
 #include "alignlib_fwd.h"
 #include "ImplFragmentor.h"
 #include "Alignment.h"
@@ -37,6 +39,15 @@ namespace alignlib
 /**
    @short build fragments by iteratively aligning in a dotplot.
 
+   The dotplot is aligned as by @ref ImplAlignatorDots. After a
+   fragment has been found, its rows and columns are removed from
+   the dotplot and the next fragment is searched for.
+
+   Alignment scores of dots are kept between iterations. Only
+   dots whose trace passed through a removed dot are re-scored, all
+   other dots keep their score and trace. The fragments are the
+   same as when re-aligning the full dotplot in each iteration.
+
    @author Andreas Heger
    @version $Id: ImplFragmentorIterative.h,v 1.3 2004/03/19 18:23:41 aheger Exp $
 */
@@ -79,6 +90,49 @@ class ImplFragmentorIterative : public ImplFragmentor
     		const HAlignment & sample,
     		const HAlignandum & row,
     		const HAlignandum & col );
+
+    /** copy dots into the work arrays */
+    void setupDots( const HAlignment & dots );
+
+    /** compute score and trace of a dot from the remaining dots in previous rows */
+    void scoreDot( Dot dot );
+
+    /** remove dots in rows and columns of a fragment. Returns the dots to re-score. */
+    void removeRegion(
+    		Position row_from, Position row_to,
+    		Position col_from, Position col_to,
+    		std::vector<Dot> & dirty );
+
+    /** add dot to/remove dot from list of dots tracing back to its predecessor */
+    void linkDot( Dot dot );
+    void unlinkDot( Dot dot );
+
+    /** rows, columns and scores of dots, sorted by row and then column */
+    std::vector<Position> mRows;
+    std::vector<Position> mCols;
+    std::vector<Score> mDotScores;
+
+    /** first dot in each row and dots in each column, from mRowFrom and mColFrom */
+    std::vector<Dot> mRowStarts;
+    std::vector<Dot> mColumnStarts;
+    std::vector<Dot> mColumnDots;
+    Position mRowFrom;
+    Position mColFrom;
+
+    /** alignment score and trace for each dot */
+    std::vector<Score> mScores;
+    std::vector<Dot> mTrace;
+
+    /** true, if dot has not been removed */
+    std::vector<char> mAlive;
+
+    /** doubly linked lists of dots that trace back to the same dot */
+    std::vector<Dot> mFirstChild;
+    std::vector<Dot> mNextChild;
+    std::vector<Dot> mPreviousChild;
+
+    /** dots by score. Entries are checked against mScores when removed. */
+    std::priority_queue< std::pair<Score, Dot> > mBestDots;
 };
 
 }
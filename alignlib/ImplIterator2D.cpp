@@ -23,6 +23,7 @@
 
 #include <iostream>
 #include <iomanip>
+#include <algorithm>
 #include "alignlib_fwd.h"
 #include "alignlib_interfaces.h"
 #include "alignlib_fwd.h"
@@ -111,4 +112,12 @@ ImplIterator2D::ImplIterator2D(
 			return col_back(row) - col_front(row) + 1;
 		}
 
+		size_t ImplIterator2D::getNumCells() const
+		{
+			size_t cells = 0;
+			for (Position row = row_front(); row <= row_back(); ++row)
+				cells += std::max( 0, col_size( row ) );
+			return cells;
+		}
+
 } // namespace alignlib
@@ -70,6 +70,9 @@ namespace alignlib
       virtual Position row_size( Position col = NO_POS) const;
       virtual Position col_size( Position row = NO_POS) const;
 
+      /** return the number of cells within the iterator */
+      virtual size_t getNumCells() const;
+
     protected:
       Position mRowFrom;
       Position mRowTo;
@@ -0,0 +1,181 @@
+/*
+  alignlib - a library for aligning protein sequences
+
+  $Id$
+
+  Copyright (C) 2026 Andreas Heger
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+ */
+
+
+#include <iostream>
+#include <iomanip>
+#include <algorithm>
+#include <assert.h>
+#include "alignlib_fwd.h"
+#include "alignlib_interfaces.h"
+#include "AlignlibDebug.h"
+#include "Alignandum.h"
+#include "ImplIterator2DXDrop.h"
+
+using namespace std;
+
+namespace alignlib
+{
+
+/** factory function for creating an iterator that adapts
+    to the alignment path.
+
+    Cells scoring more than xdrop below the best score
+    are not extended.
+ */
+HIterator2D makeIterator2DXDrop( const HAlignandum & row,
+		const HAlignandum & col,
+		const Score xdrop )
+{
+	return HIterator2D( new ImplIterator2DXDrop( row, col, xdrop ) );
+}
+
+HIterator2D makeIterator2DXDrop( const Score xdrop )
+{
+	return HIterator2D( new ImplIterator2DXDrop( xdrop ) );
+}
+
+//--------------------------------------------------------------------------------------
+ImplIterator2DXDrop::ImplIterator2DXDrop( Score xdrop ) :
+	ImplIterator2D(),
+	mXDrop( xdrop ),
+	mNumCells( 0 )
+	{
+	debug_func_cerr(5);
+	assert( mXDrop >= 0 );
+	}
+
+//--------------------------------------------------------------------------------------
+ImplIterator2DXDrop::ImplIterator2DXDrop( const HAlignandum & row,
+		const HAlignandum & col,
+		Score xdrop ) :
+			ImplIterator2D( row, col ),
+			mXDrop( xdrop ),
+			mNumCells( 0 )
+			{
+	debug_func_cerr(5);
+	assert( mXDrop >= 0 );
+	resetRanges( row, col );
+			}
+
+//--------------------------------------------------------------------------------------
+ImplIterator2DXDrop::~ImplIterator2DXDrop ()
+{
+	debug_func_cerr(5);
+}
+
+//--------------------------------------------------------------------------------------
+ImplIterator2DXDrop::ImplIterator2DXDrop(const ImplIterator2DXDrop & src) :
+	ImplIterator2D( src ),
+	mXDrop( src.mXDrop ),
+	mFirst( src.mFirst ), mLast( src.mLast ),
+	mNumCells( src.mNumCells )
+	{
+	debug_func_cerr(5);
+	}
+
+IMPLEMENT_CLONE( HIterator2D, ImplIterator2DXDrop );
+
+//--------------------------------------------------------------------------------------
+void ImplIterator2DXDrop::resetRanges(
+		const HAlignandum & row,
+		const HAlignandum & col )
+{
+	debug_func_cerr(5);
+
+	ImplIterator2D::resetRanges( row, col );
+
+	Position nrows = std::max( 0, mRowTo - mRowFrom );
+	mFirst.assign( nrows, mColFrom );
+	mLast.assign( nrows, mColTo - 1 );
+	mNumCells = (size_t)nrows * std::max( 0, mColTo - mColFrom );
+}
+
+//--------------------------------------------------------------------------------------
+HIterator2D ImplIterator2DXDrop::getNew( const HAlignandum & row, const HAlignandum & col ) const
+{
+	ImplIterator2DXDrop * iterator = new ImplIterator2DXDrop( mXDrop );
+	iterator->resetRanges( row, col );
+	return HIterator2D( iterator );
+}
+
+//--------------------------------------------------------------------------------------
+Position ImplIterator2DXDrop::row_front ( Position col ) const
+{
+	return mRowFrom;
+}
+
+Position ImplIterator2DXDrop::row_back  ( Position col ) const
+{
+	return mRowTo - 1;
+}
+
+Position ImplIterator2DXDrop::col_front ( Position row ) const
+{
+	if (row == NO_POS)
+		return mColFrom;
+	else
+		return mFirst[row - mRowFrom];
+}
+
+Position ImplIterator2DXDrop::col_back  ( Position row ) const
+{
+	if (row == NO_POS)
+		return mColTo - 1;
+	else
+		return mLast[row - mRowFrom];
+}
+
+//--------------------------------------------------------------------------------------
+size_t ImplIterator2DXDrop::getNumCells() const
+{
+	return mNumCells;
+}
+
+//--------------------------------------------------------------------------------------
+Score ImplIterator2DXDrop::getXDrop() const
+{
+	return mXDrop;
+}
+
+//--------------------------------------------------------------------------------------
+void ImplIterator2DXDrop::setColRange( Position row, Position first, Position last )
+{
+	if (row < mRowFrom || row >= mRowTo)
+		return;
+
+	assert( first >= mColFrom && last < mColTo );
+	Position x = row - mRowFrom;
+	mNumCells -= std::max( 0, mLast[x] - mFirst[x] + 1 );
+	mFirst[x] = first;
+	mLast[x] = last;
+	mNumCells += std::max( 0, last - first + 1 );
+}
+
+//--------------------------------------------------------------------------------------
+void ImplIterator2DXDrop::clearRows( Position row )
+{
+	for (; row < mRowTo; ++row)
+		setColRange( row, mColTo, mColTo - 1 );
+}
+
+} // namespace alignlib
@@ -0,0 +1,116 @@
+/*
+  alignlib - a library for aligning protein sequences
+
+  $Id$
+
+  Copyright (C) 2026 Andreas Heger
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+*/
+
+
+#if HAVE_CONFIG_H
+#include <config.h>
+#endif
+
+#ifndef ITERATOR2DXDROP_H
+#define ITERATOR2DXDROP_H 1
+
+#include <vector>
+#include "alignlib_fwd.h"
+#include "ImplIterator2D.h"
+
+namespace alignlib
+{
+
+  /** @brief iterator whose band follows the alignment path.
+
+      The iterator initially covers the full matrix. While computing
+      a local alignment, @ref ImplAlignatorDPFull narrows the columns of each
+      row: a row stops at the first cell beyond the reach of the previous row
+      that scores more than xdrop below the best score seen so far, and the
+      next row starts at the first cell within xdrop of the best score.
+
+      @ref getNumCells returns the number of cells within the ranges of
+      this iterator. For an iterator used in an alignment, this is the number
+      of cells computed. Each iterator obtained by @ref getNew has its own
+      count, so that a prototype can be shared between threads. The count
+      of the last alignment of an alignator is returned by
+      @ref getNumCells( const HAlignator & ).
+   */
+  class ImplIterator2DXDrop: public ImplIterator2D
+    {
+    public:
+
+      /** constructor */
+      ImplIterator2DXDrop( const Score xdrop = 0 );
+
+      ImplIterator2DXDrop( const HAlignandum & row,
+			    const HAlignandum & col,
+			    const Score xdrop = 0 );
+
+      /** destructor */
+      virtual ~ImplIterator2DXDrop ();
+
+      /** copy constructor */
+      ImplIterator2DXDrop( const ImplIterator2DXDrop & src);
+
+      DEFINE_CLONE( HIterator2D );
+
+      /** reset ranges of iterator for new row and col objects
+       */
+      virtual void resetRanges( const HAlignandum & row,
+				const HAlignandum & col );
+
+      /** return a new iterator of same type initializes with for row and col
+       */
+      virtual HIterator2D getNew(
+    		  const HAlignandum & row,
+    		  const HAlignandum & col ) const;
+
+      /** return first/last residues in rows/columns */
+      virtual Position row_front ( Position col = NO_POS) const;
+      virtual Position row_back  ( Position col = NO_POS) const;
+      virtual Position col_front ( Position row = NO_POS) const;
+      virtual Position col_back  ( Position row = NO_POS) const;
+
+      /** return the number of cells within the ranges */
+      virtual size_t getNumCells() const;
+
+      /** return the X-drop threshold */
+      Score getXDrop() const;
+
+      /** restrict row to the columns from first to last (inclusive). */
+      void setColRange( Position row, Position first, Position last );
+
+      /** remove all columns in rows from row onwards. */
+      void clearRows( Position row );
+
+    private:
+      /** threshold below best score, at which cells are dropped */
+      Score mXDrop;
+
+      /** first column in each row */
+      std::vector<Position> mFirst;
+
+      /** last column in each row */
+      std::vector<Position> mLast;
+
+      /** number of cells within the ranges */
+      size_t mNumCells;
+    };
+}
+
+#endif /* ITERATOR2DXDROP_H */
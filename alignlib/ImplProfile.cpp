@@ -25,6 +25,8 @@
 #include <iomanip>
 #include <stdio.h>
 #include <limits>
+#include <algorithm>
+#include <vector>
 #include "alignlib_fwd.h"
 #include "alignlib_interfaces.h"
 #include "AlignlibDebug.h"
@@ -45,6 +47,14 @@
 #include "HelpersWeightor.h"
 #include "HelpersToolkit.h"
 #include "MultAlignment.h"
+#include "AlignlibThreads.h"
+#include "EncodedMultipleAlignment.h"
+
+#ifdef HAVE_BOOST_THREAD
+#include <boost/thread/thread.hpp>
+#include <boost/thread/mutex.hpp>
+#include <boost/ref.hpp>
+#endif
 
 /** default objects */
 
@@ -92,6 +102,14 @@ HAlignandum makeProfile(
 	return HAlignandum( new ImplProfile( mali ) );
 }
 
+//------------------------------------------------------------------------------------------
+/** create a default profile from an encoded multiple alignment */
+HAlignandum makeProfile(
+		const HEncodedMultipleAlignment & mali )
+{
+	return HAlignandum( new ImplProfile( mali ) );
+}
+
 //---------------------------------------------------------------
 HAlignandum makeProfile(
 		const HAlignandum & seqa,
@@ -126,6 +144,129 @@ HAlignandum makeProfile(
 }
 
 
+/** queue of objects shared between the threads of prepareProfiles.
+ *
+ * Long objects are handed out first.
+ */
+class PrepareQueue
+{
+public:
+	PrepareQueue( const AlignandumVector & profiles ) :
+		mNext( 0 )
+	{
+		std::vector< std::pair<Position, size_t> > lengths( profiles.size() );
+		for (size_t x = 0; x < profiles.size(); ++x)
+			lengths[x] = std::make_pair( -profiles[x]->getFullLength(), x );
+		std::sort( lengths.begin(), lengths.end() );
+
+		mOrder.resize( profiles.size() );
+		for (size_t x = 0; x < lengths.size(); ++x)
+			mOrder[x] = lengths[x].second;
+	}
+
+	/** get index of next object. Returns false if the queue is empty. */
+	bool next( size_t & index )
+	{
+#ifdef HAVE_BOOST_THREAD
+		boost::mutex::scoped_lock lock( mMutex );
+#endif
+		if (mNext == mOrder.size())
+			return false;
+		index = mOrder[mNext++];
+		return true;
+	}
+
+private:
+	std::vector<size_t> mOrder;
+	size_t mNext;
+#ifdef HAVE_BOOST_THREAD
+	boost::mutex mMutex;
+#endif
+};
+
+/** a thread of prepareProfiles */
+class PrepareWorker
+{
+public:
+	PrepareWorker( const AlignandumVector & profiles, PrepareQueue & queue ) :
+		mProfiles( &profiles ), mQueue( &queue ), mFailed( false )
+		{}
+
+	void operator()()
+	{
+		// exceptions can not pass thread boundaries, they are re-thrown
+		// by the main thread.
+		try
+		{
+			size_t index;
+			while (mQueue->next( index ))
+				(*mProfiles)[index]->prepare();
+		}
+		catch (AlignlibException & e)
+		{
+			mFailed = true;
+			mMessage = e.what();
+		}
+	}
+
+	const AlignandumVector * mProfiles;
+	PrepareQueue * mQueue;
+	bool mFailed;
+	std::string mMessage;
+};
+
+//---------------------------------------------------------------
+void prepareProfile(
+		const HAlignandum & profile,
+		unsigned int num_threads )
+{
+	debug_func_cerr(5);
+
+	boost::shared_ptr<ImplProfile> p( boost::dynamic_pointer_cast<ImplProfile, Alignandum>( profile ) );
+	if (p)
+		p->prepareParallel( num_threads );
+	else
+		profile->prepare();
+}
+
+//---------------------------------------------------------------
+void prepareProfiles(
+		const AlignandumVector & profiles,
+		unsigned int num_threads )
+{
+	debug_func_cerr(5);
+
+	num_threads = getNumThreads( num_threads );
+
+	// with fewer objects than threads, split each object into blocks of columns
+	if (profiles.size() < num_threads)
+	{
+		for (size_t x = 0; x < profiles.size(); ++x)
+			prepareProfile( profiles[x], num_threads );
+		return;
+	}
+
+	PrepareQueue queue( profiles );
+
+	std::vector<PrepareWorker> workers( num_threads, PrepareWorker( profiles, queue ) );
+
+	if (num_threads == 1)
+		workers[0]();
+#ifdef HAVE_BOOST_THREAD
+	else
+	{
+		boost::thread_group threads;
+		for (unsigned int t = 0; t < num_threads; ++t)
+			threads.create_thread( boost::ref( workers[t] ) );
+		threads.join_all();
+	}
+#endif
+
+	for (unsigned int t = 0; t < num_threads; ++t)
+		if (workers[t].mFailed)
+			throw AlignlibException( workers[t].mMessage );
+}
+
 //---------------------------------------> constructors and destructors <--------------------------------------
 // The constructor is potentially empty, so that this object can be read from file.
 ImplProfile::ImplProfile() :
@@ -163,6 +304,18 @@ ImplProfile::ImplProfile( const HMultipleAlignment & src ) :
 	fillCounts( src );
 }
 
+ImplProfile::ImplProfile( const HEncodedMultipleAlignment & src ) :
+		ImplAlignandum(),
+		mWeightedCountMatrix(NULL),
+		mFrequencyMatrix(NULL),
+		mScoreMatrix(NULL),
+		mProfileWidth(0)
+{
+	debug_func_cerr(5);
+	resize( src->getLength() );
+	fillCounts( src );
+}
+
 //---------------------------------------------------------------------------------------------------------------
 ImplProfile::ImplProfile(const ImplProfile & src ) : ImplAlignandum( src ),
 	mWeightedCountMatrix(NULL),
@@ -252,6 +405,17 @@ void ImplProfile::fillCounts( const HMultipleAlignment &  src )
 	setPrepared( false );
 }
 
+//---------------------------------------------------------------------------------------------------------------
+void ImplProfile::fillCounts( const HEncodedMultipleAlignment & src )
+{
+	debug_func_cerr(5);
+
+	resize( src->getLength() );
+	getToolkit()->getWeightor()->fillCounts( *mWeightedCountMatrix, src );
+
+	setPrepared( false );
+}
+
 //---------------------------------------------------------------------------------------------------------------
 template< class T>
 Matrix<T> * ImplProfile::allocateSegment( Matrix<T> * data ) const
@@ -388,6 +552,124 @@ void ImplProfile::prepare() const
 	setPrepared( true );
 }
 
+//--------------------------------------------------------------------------------------
+/** a thread of ImplProfile::prepareParallel, working on the rows from to to
+ * of the matrices of a profile */
+class PrepareColumnsWorker
+{
+public:
+	PrepareColumnsWorker(
+			const HRegularizor & regularizor,
+			const HLogOddor & logoddor,
+			const HEncoder & encoder,
+			WeightedCountMatrix * counts,
+			FrequencyMatrix * frequencies,
+			ScoreMatrix * scores,
+			Position from, Position to ) :
+		mRegularizor( regularizor ), mLogOddor( logoddor ), mEncoder( encoder ),
+		mCounts( counts ), mFrequencies( frequencies ), mScores( scores ),
+		mFrom( from ), mTo( to ), mFailed( false )
+		{}
+
+	void operator()()
+	{
+		try
+		{
+			const Position length = mTo - mFrom;
+			const Position width = mFrequencies->getNumCols();
+
+			// the matrices share the rows of the profile's matrices
+			FrequencyMatrix frequencies( mFrequencies->getRow( mFrom ), length, width );
+			if (mRegularizor)
+			{
+				WeightedCountMatrix counts( mCounts->getRow( mFrom ), length, width );
+				mRegularizor->fillFrequencies( frequencies, counts, mEncoder );
+			}
+			if (mLogOddor)
+			{
+				ScoreMatrix scores( mScores->getRow( mFrom ), length, width );
+				mLogOddor->fillProfile( scores, frequencies, mEncoder );
+			}
+		}
+		catch (AlignlibException & e)
+		{
+			mFailed = true;
+			mMessage = e.what();
+		}
+	}
+
+	HRegularizor mRegularizor;
+	HLogOddor mLogOddor;
+	HEncoder mEncoder;
+	WeightedCountMatrix * mCounts;
+	FrequencyMatrix * mFrequencies;
+	ScoreMatrix * mScores;
+	Position mFrom;
+	Position mTo;
+	bool mFailed;
+	std::string mMessage;
+};
+
+void ImplProfile::prepareParallel( unsigned int num_threads ) const
+{
+	debug_func_cerr(5);
+
+	num_threads = std::min( (Position)getNumThreads( num_threads ), getFullLength() );
+
+	if (num_threads <= 1 || (mFrequencyMatrix != NULL && mScoreMatrix != NULL))
+	{
+		prepare();
+		return;
+	}
+
+	const HEncoder & encoder = getToolkit()->getEncoder();
+	HRegularizor regularizor;
+	HLogOddor logoddor;
+
+	if (mFrequencyMatrix == NULL)
+	{
+		allocateFrequencies();
+		regularizor = getToolkit()->getRegularizor();
+		if (!regularizor->isColumnIndependent())
+		{
+			regularizor->fillFrequencies( *mFrequencyMatrix, *mWeightedCountMatrix, encoder );
+			regularizor.reset();
+		}
+	}
+
+	if (mScoreMatrix == NULL)
+	{
+		allocateScores();
+		logoddor = getToolkit()->getLogOddor();
+	}
+
+	const Position length = getFullLength();
+	std::vector<PrepareColumnsWorker> workers;
+	workers.reserve( num_threads );
+	for (unsigned int t = 0; t < num_threads; ++t)
+		workers.push_back( PrepareColumnsWorker(
+				regularizor, logoddor, encoder,
+				mWeightedCountMatrix, mFrequencyMatrix, mScoreMatrix,
+				length * t / num_threads, length * (t + 1) / num_threads ) );
+
+#ifdef HAVE_BOOST_THREAD
+	boost::thread_group threads;
+	for (unsigned int t = 0; t < num_threads; ++t)
+		threads.create_thread( boost::ref( workers[t] ) );
+	threads.join_all();
+#endif
+
+	for (unsigned int t = 0; t < num_threads; ++t)
+		if (workers[t].mFailed)
+		{
+			// do not keep partially filled matrices
+			release();
+			throw AlignlibException( workers[t].mMessage );
+		}
+
+	setPrepared( true );
+}
+
 //--------------------------------------------------------------------------------------
 void ImplProfile::release() const
 {
@@ -414,6 +696,7 @@ void ImplProfile::swap( const Position & x, const Position & y )
 		mFrequencyMatrix->swapRows( x, y );
 	if (mWeightedCountMatrix != NULL)
 		mWeightedCountMatrix->swapRows( x, y );
+	clearCache();
 }
 
 //--------------------------------------------------------------------------------------
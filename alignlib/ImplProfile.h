@@ -101,6 +101,8 @@ public:
 
 	ImplProfile( const HMultipleAlignment & src );
 
+	ImplProfile( const HEncodedMultipleAlignment & src );
+
 	ImplProfile( const Position & length );
 
 	/** copy constructor */
@@ -120,6 +122,17 @@ public:
 	will also calculate the profile */
 	virtual void prepare() const;
 
+	/** prepare the profile with num_threads threads.
+	 *
+	 * The columns are split into one block per thread. Each thread
+	 * computes frequencies and scores for its block. If the regularizor
+	 * needs to see all columns (see @ref Regularizor::isColumnIndependent),
+	 * frequencies are computed before the threads are started.
+	 *
+	 * The result is the same as for @ref prepare.
+	 */
+	void prepareParallel( unsigned int num_threads ) const;
+
 	/** discard cache, if cacheable type. In this implementation of profiles, this will
      delete the frequencies and profile-types. Only the counts are stored, so that the
      profile can be reconstituted. */
@@ -236,6 +249,9 @@ protected:
 	/** fill count matrix */
 	virtual void fillCounts( const HMultipleAlignment & src );
 
+	/** fill count matrix from an encoded multiple alignment */
+	virtual void fillCounts( const HEncodedMultipleAlignment & src );
+
 	/** save state of object into stream
 	 */
 	virtual void __save( std::ostream & output, MagicNumberType type = MNNoType ) const;
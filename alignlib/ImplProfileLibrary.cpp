@@ -0,0 +1,303 @@
+/*
+  alignlib - a library for aligning protein sequences
+
+  $Id$
+
+  Copyright (C) 2026 Andreas Heger
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+*/
+
+#include <iostream>
+#include <fstream>
+#include <cstring>
+#include <vector>
+#include <string>
+
+#include <sys/types.h>
+#include <sys/stat.h>
+#include <sys/mman.h>
+#include <fcntl.h>
+#include <unistd.h>
+
+#include "alignlib_fwd.h"
+#include "alignlib_interfaces.h"
+#include "AlignlibDebug.h"
+#include "AlignlibException.h"
+#include "HelpersToolkit.h"
+#include "HelpersProfileLibrary.h"
+#include "ImplProfileLibrary.h"
+#include "ImplProfileMapped.h"
+
+using namespace std;
+
+namespace alignlib
+{
+
+/** identifies profile library files */
+static const char PROFILE_LIBRARY_MAGIC[8] = { 'A', 'L', 'P', 'R', 'O', 'L', 'I', 'B' };
+
+/** version of library format */
+#define PROFILE_LIBRARY_VERSION 2
+
+/** value of mByteOrder in native byte order */
+#define PROFILE_LIBRARY_BYTE_ORDER 0x01020304
+
+/** matrices are aligned to this number of bytes */
+#define PROFILE_LIBRARY_ALIGNMENT 64
+
+/** round offset up to next aligned position */
+static inline unsigned long long alignOffset( unsigned long long offset )
+{
+	return (offset + PROFILE_LIBRARY_ALIGNMENT - 1) / PROFILE_LIBRARY_ALIGNMENT * PROFILE_LIBRARY_ALIGNMENT;
+}
+
+//------------------------------------------------------------------------------------
+HProfileLibrary openProfileLibrary( const std::string & filename )
+{
+	return HProfileLibrary( new ImplProfileLibrary( filename ) );
+}
+
+//------------------------------------------------------------------------------------
+/** write data and pad with zeros to next aligned position */
+static void writeAligned( std::ostream & output, const void * data, size_t size )
+{
+	static const char padding[PROFILE_LIBRARY_ALIGNMENT] = { 0 };
+	if (size > 0)
+		output.write( (const char*)data, size );
+	output.write( padding, alignOffset( size ) - size );
+}
+
+//------------------------------------------------------------------------------------
+void writeProfileLibrary(
+		const std::string & filename,
+		const AlignandumVector & profiles )
+{
+	debug_func_cerr(5);
+
+	const Residue width = getDefaultToolkit()->getEncoder()->getAlphabetSize();
+	const size_t nprofiles = profiles.size();
+
+	// profiles are laid out from the lengths alone, so that
+	// the file can be written in a single pass.
+	std::vector<ProfileLibraryEntry> entries( nprofiles );
+
+	unsigned long long offset = alignOffset( sizeof(ProfileLibraryHeader) );
+	const unsigned long long table_offset = offset;
+	offset = alignOffset( offset + sizeof(ProfileLibraryEntry) * nprofiles );
+
+	for (size_t x = 0; x < nprofiles; ++x)
+	{
+		const HAlignandum & profile = profiles[x];
+		if (!boost::dynamic_pointer_cast<ImplProfile, Alignandum>( profile ))
+			THROW( "object " + toString( x ) + " is not a profile" );
+
+		ProfileLibraryEntry & entry = entries[x];
+		memset( &entry, 0, sizeof(ProfileLibraryEntry) );
+		entry.mLength = profile->getFullLength();
+		entry.mFrom = profile->getFrom();
+		entry.mTo = profile->getTo();
+
+		entry.mCountsOffset = offset;
+		offset += alignOffset( sizeof(WeightedCount) * entry.mLength * width );
+		entry.mFrequenciesOffset = offset;
+		offset += alignOffset( sizeof(Frequency) * entry.mLength * width );
+		entry.mScoresOffset = offset;
+		offset += alignOffset( sizeof(Score) * entry.mLength * width );
+		entry.mMaskOffset = offset;
+		offset += alignOffset( entry.mLength );
+	}
+
+	ProfileLibraryHeader header;
+	memset( &header, 0, sizeof(ProfileLibraryHeader) );
+	memcpy( header.mMagic, PROFILE_LIBRARY_MAGIC, sizeof(header.mMagic) );
+	header.mVersion = PROFILE_LIBRARY_VERSION;
+	header.mByteOrder = PROFILE_LIBRARY_BYTE_ORDER;
+	header.mHeaderSize = sizeof(ProfileLibraryHeader);
+	header.mEntrySize = sizeof(ProfileLibraryEntry);
+	header.mProfileWidth = width;
+	header.mSizeWeightedCount = sizeof(WeightedCount);
+	header.mSizeFrequency = sizeof(Frequency);
+	header.mSizeScore = sizeof(Score);
+	header.mNumProfiles = nprofiles;
+	header.mTableOffset = table_offset;
+	header.mFileSize = offset;
+
+	std::ofstream output( filename.c_str(), std::ios::binary );
+	if (!output)
+		THROW( "could not open " + filename + " for writing" );
+
+	writeAligned( output, &header, sizeof(ProfileLibraryHeader) );
+	writeAligned( output, nprofiles > 0 ? &entries[0] : NULL, sizeof(ProfileLibraryEntry) * nprofiles );
+
+	for (size_t x = 0; x < nprofiles; ++x)
+	{
+		const HImplProfile profile( boost::dynamic_pointer_cast<ImplProfile, Alignandum>( profiles[x] ) );
+		if (profile->exportWeightedCountMatrix()->getNumCols() != width)
+			THROW( "width of profile " + toString( x ) + " does not match alphabet" );
+
+		const bool was_prepared = profile->isPrepared();
+		profile->prepare();
+
+		const size_t size = entries[x].mLength * width;
+		writeAligned( output, profile->exportWeightedCountMatrix()->getData(), sizeof(WeightedCount) * size );
+		writeAligned( output, profile->exportFrequencyMatrix()->getData(), sizeof(Frequency) * size );
+		writeAligned( output, profile->exportScoreMatrix()->getData(), sizeof(Score) * size );
+
+		std::vector<unsigned char> mask( entries[x].mLength, 0 );
+		for (Position c = 0; c < entries[x].mLength; ++c)
+			mask[c] = profile->isMasked( c );
+		writeAligned( output, mask.empty() ? NULL : &mask[0], mask.size() );
+
+		if (!was_prepared)
+			profile->release();
+	}
+
+	if (output.fail())
+		THROW( "error while writing " + filename );
+}
+
+//------------------------------------------------------------------------------------
+MappedFile::MappedFile( const std::string & filename ) :
+	mData( NULL ), mSize( 0 )
+{
+	int fd = open( filename.c_str(), O_RDONLY );
+	if (fd < 0)
+		THROW( "could not open " + filename );
+
+	struct stat info;
+	if (fstat( fd, &info ) < 0)
+	{
+		close( fd );
+		THROW( "could not stat " + filename );
+	}
+
+	mSize = info.st_size;
+	if (mSize > 0)
+	{
+		// mapped privately, so that writing to a matrix does
+		// not fault or change the file
+		void * data = mmap( NULL, mSize, PROT_READ | PROT_WRITE, MAP_PRIVATE, fd, 0 );
+		if (data == MAP_FAILED)
+		{
+			close( fd );
+			THROW( "could not map " + filename );
+		}
+		mData = (const char*)data;
+	}
+	close( fd );
+}
+
+MappedFile::~MappedFile()
+{
+	if (mData != NULL)
+		munmap( (void*)mData, mSize );
+}
+
+//------------------------------------------------------------------------------------
+ImplProfileLibrary::ImplProfileLibrary() :
+	ProfileLibrary(), ImplAlignlibBase(),
+	mHeader( NULL ), mEntries( NULL )
+{
+}
+
+ImplProfileLibrary::ImplProfileLibrary( const std::string & filename ) :
+	ProfileLibrary(), ImplAlignlibBase(),
+	mFile( new MappedFile( filename ) ),
+	mHeader( NULL ), mEntries( NULL )
+{
+	debug_func_cerr(5);
+
+	if (mFile->getSize() < sizeof(ProfileLibraryHeader))
+		THROW( filename + " is not a profile library" );
+
+	mHeader = (const ProfileLibraryHeader*)mFile->getData();
+
+	if (memcmp( mHeader->mMagic, PROFILE_LIBRARY_MAGIC, sizeof(mHeader->mMagic) ) != 0)
+		THROW( filename + " is not a profile library" );
+	if (mHeader->mByteOrder != PROFILE_LIBRARY_BYTE_ORDER)
+		THROW( filename + " has been written on an architecture with different byte order" );
+	if (mHeader->mVersion != PROFILE_LIBRARY_VERSION)
+		THROW( filename + " has unknown version " + toString( mHeader->mVersion ) );
+	if (mHeader->mHeaderSize != sizeof(ProfileLibraryHeader) ||
+			mHeader->mEntrySize != sizeof(ProfileLibraryEntry) ||
+			mHeader->mSizeWeightedCount != sizeof(WeightedCount) ||
+			mHeader->mSizeFrequency != sizeof(Frequency) ||
+			mHeader->mSizeScore != sizeof(Score))
+		THROW( filename + " has been written with different types" );
+	if (mHeader->mFileSize != mFile->getSize() ||
+			mHeader->mTableOffset + mHeader->mNumProfiles * sizeof(ProfileLibraryEntry) > mFile->getSize())
+		THROW( filename + " is truncated" );
+	if (mHeader->mProfileWidth != (unsigned int)getDefaultToolkit()->getEncoder()->getAlphabetSize())
+		THROW( filename + " has been written with a different alphabet" );
+
+	mEntries = (const ProfileLibraryEntry*)(mFile->getData() + mHeader->mTableOffset);
+}
+
+ImplProfileLibrary::~ImplProfileLibrary ()
+{
+}
+
+ImplProfileLibrary::ImplProfileLibrary( const ImplProfileLibrary & src ) :
+	ProfileLibrary( src ), ImplAlignlibBase( src ),
+	mFile( src.mFile ),
+	mHeader( src.mHeader ),
+	mEntries( src.mEntries )
+{
+}
+
+IMPLEMENT_CLONE( HProfileLibrary, ImplProfileLibrary );
+
+//------------------------------------------------------------------------------------
+size_t ImplProfileLibrary::getNumProfiles() const
+{
+	return (mHeader != NULL) ? mHeader->mNumProfiles : 0;
+}
+
+//------------------------------------------------------------------------------------
+const ProfileLibraryEntry & ImplProfileLibrary::getEntry( size_t index ) const
+{
+	if (index >= getNumProfiles())
+		THROW( "profile index " + toString( index ) + " out of range" );
+	return mEntries[index];
+}
+
+//------------------------------------------------------------------------------------
+Position ImplProfileLibrary::getProfileLength( size_t index ) const
+{
+	return getEntry( index ).mLength;
+}
+
+//------------------------------------------------------------------------------------
+HAlignandum ImplProfileLibrary::getProfile( size_t index ) const
+{
+	const ProfileLibraryEntry & entry = getEntry( index );
+	const unsigned long long size = (unsigned long long)entry.mLength * mHeader->mProfileWidth;
+
+	if (entry.mLength < 0 ||
+			entry.mCountsOffset % PROFILE_LIBRARY_ALIGNMENT != 0 ||
+			entry.mFrequenciesOffset % PROFILE_LIBRARY_ALIGNMENT != 0 ||
+			entry.mScoresOffset % PROFILE_LIBRARY_ALIGNMENT != 0 ||
+			entry.mMaskOffset % PROFILE_LIBRARY_ALIGNMENT != 0 ||
+			entry.mCountsOffset + size * sizeof(WeightedCount) > mFile->getSize() ||
+			entry.mFrequenciesOffset + size * sizeof(Frequency) > mFile->getSize() ||
+			entry.mScoresOffset + size * sizeof(Score) > mFile->getSize() ||
+			entry.mMaskOffset + entry.mLength > mFile->getSize())
+		THROW( "corrupt entry for profile " + toString( index ) );
+
+	return HAlignandum( new ImplProfileMapped( mFile, entry, mHeader->mProfileWidth ) );
+}
+
+} // namespace alignlib
@@ -0,0 +1,171 @@
+/*
+  alignlib - a library for aligning protein sequences
+
+  $Id$
+
+  Copyright (C) 2026 Andreas Heger
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+*/
+
+#if HAVE_CONFIG_H
+#include <config.h>
+#endif
+
+#ifndef IMPL_PROFILE_LIBRARY_H
+#define IMPL_PROFILE_LIBRARY_H 1
+
+#include <string>
+#include "alignlib_fwd.h"
+#include "ProfileLibrary.h"
+#include "ImplAlignlibBase.h"
+
+namespace alignlib
+{
+
+/** header of a profile library file.
+ *
+ * All fields are in native byte order. mByteOrder
+ * is used to detect files from other architectures.
+ */
+struct ProfileLibraryHeader
+{
+	char mMagic[8];
+	unsigned int mVersion;
+	unsigned int mByteOrder;
+	unsigned int mHeaderSize;
+	unsigned int mEntrySize;
+	unsigned int mProfileWidth;
+	unsigned int mSizeWeightedCount;
+	unsigned int mSizeFrequency;
+	unsigned int mSizeScore;
+	unsigned long long mNumProfiles;
+	unsigned long long mTableOffset;
+	unsigned long long mFileSize;
+};
+
+/** entry in the offset table of a profile library file */
+struct ProfileLibraryEntry
+{
+	/** offset of counts, frequencies and scores from start of file */
+	unsigned long long mCountsOffset;
+	unsigned long long mFrequenciesOffset;
+	unsigned long long mScoresOffset;
+	/** offset of mask, one byte per column */
+	unsigned long long mMaskOffset;
+	/** length of profile */
+	int mLength;
+	/** segment used in profile */
+	int mFrom;
+	int mTo;
+	int mReserved;
+};
+
+/** a file mapped into memory.
+ *
+ * The file is mapped copy-on-write: writing to the mapped data
+ * changes only the copy in this process, not the file.
+ *
+ * The mapping is released, when the last profile or
+ * library using it is deleted.
+ */
+class MappedFile
+{
+ public:
+	/** map file into memory */
+	MappedFile( const std::string & filename );
+
+	/** unmap file */
+	~MappedFile();
+
+	/** return start of file in memory */
+	const char * getData() const { return mData; }
+
+	/** return size of file */
+	size_t getSize() const { return mSize; }
+
+ private:
+	/** mappings can not be copied */
+	MappedFile( const MappedFile & );
+	MappedFile & operator=( const MappedFile & );
+
+	const char * mData;
+	size_t mSize;
+};
+
+typedef boost::shared_ptr<MappedFile> HMappedFile;
+
+/**
+   @short library of profiles in a memory-mapped file.
+
+   The file is laid out as:
+
+   header | offset table | counts, frequencies, scores and mask of each profile
+
+   Each matrix starts at a 64-byte boundary. The mask contains one byte
+   for each column, which is 1 for masked columns. Opening a library only
+   checks the header. Profiles returned by @ref getProfile use the
+   mapped matrices directly.
+
+   @author Andreas Heger
+   @version $Id$
+*/
+class ImplProfileLibrary : public ProfileLibrary, public ImplAlignlibBase
+{
+  /* class member functions-------------------------------------------------------------- */
+ public:
+    /* constructors and desctructors------------------------------------------------------- */
+
+    /** empty constructor */
+    ImplProfileLibrary();
+
+    /** open library in file */
+    ImplProfileLibrary( const std::string & filename );
+
+    /** destructor */
+    virtual ~ImplProfileLibrary ();
+
+    /** copy constructor. The copy shares the mapped file. */
+    ImplProfileLibrary( const ImplProfileLibrary & src);
+
+    DEFINE_CLONE( HProfileLibrary );
+
+    /** return the number of profiles in the library */
+    virtual size_t getNumProfiles() const;
+
+    /** return the length of a profile without creating it */
+    virtual Position getProfileLength( size_t index ) const;
+
+    /** return a profile */
+    virtual HAlignandum getProfile( size_t index ) const;
+
+ protected:
+
+    /** return entry in offset table */
+    const ProfileLibraryEntry & getEntry( size_t index ) const;
+
+    /** the mapped file */
+    HMappedFile mFile;
+
+    /** header in mapped file */
+    const ProfileLibraryHeader * mHeader;
+
+    /** offset table in mapped file */
+    const ProfileLibraryEntry * mEntries;
+};
+
+}
+
+#endif /* IMPL_PROFILE_LIBRARY_H */
@@ -0,0 +1,154 @@
+/*
+  alignlib - a library for aligning protein sequences
+
+  $Id$
+
+  Copyright (C) 2026 Andreas Heger
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+*/
+
+#include <iostream>
+#include "alignlib_fwd.h"
+#include "alignlib_interfaces.h"
+#include "AlignlibDebug.h"
+#include "AlignlibException.h"
+#include "ImplProfileMapped.h"
+
+using namespace std;
+
+namespace alignlib
+{
+
+//---------------------------------------> constructors and destructors <--------------------------------------
+ImplProfileMapped::ImplProfileMapped() :
+		ImplProfile()
+{
+	debug_func_cerr(5);
+}
+
+ImplProfileMapped::ImplProfileMapped(
+		const HMappedFile & file,
+		const ProfileLibraryEntry & entry,
+		Residue width ) :
+		ImplProfile(),
+		mFile( file ),
+		mEntry( entry )
+{
+	debug_func_cerr(5);
+
+	mProfileWidth = width;
+	ImplAlignandum::resize( entry.mLength );
+	useSegment( entry.mFrom, entry.mTo );
+
+	const char * mask = mFile->getData() + entry.mMaskOffset;
+	for (Position c = 0; c < entry.mLength; ++c)
+		mMasked[c] = mask[c] != 0;
+
+	mapMatrices();
+}
+
+// the copy shares the mapped matrices instead of copying them as ImplProfile does
+ImplProfileMapped::ImplProfileMapped( const ImplProfileMapped & src ) :
+		ImplProfile(),
+		mFile( src.mFile ),
+		mEntry( src.mEntry )
+{
+	debug_func_cerr(5);
+
+	mProfileWidth = src.mProfileWidth;
+	ImplAlignandum::resize( src.getFullLength() );
+	useSegment( src.getFrom(), src.getTo() );
+	mStorageType = src.mStorageType;
+	mMasked = src.mMasked;
+	mapMatrices();
+}
+
+ImplProfileMapped::~ImplProfileMapped()
+{
+	debug_func_cerr(5);
+}
+
+IMPLEMENT_CLONE( HAlignandum, ImplProfileMapped );
+
+//--------------------------------------------------------------------------------------
+void ImplProfileMapped::mapMatrices()
+{
+	// the file is mapped copy-on-write, changes to the matrices are
+	// private to this process
+	char * data = const_cast<char*>( mFile->getData() );
+
+	const Position length = getFullLength();
+
+	mWeightedCountMatrix = new WeightedCountMatrix(
+			(WeightedCount*)(data + mEntry.mCountsOffset), length, mProfileWidth );
+	mFrequencyMatrix = new FrequencyMatrix(
+			(Frequency*)(data + mEntry.mFrequenciesOffset), length, mProfileWidth );
+	mScoreMatrix = new ScoreMatrix(
+			(Score*)(data + mEntry.mScoresOffset), length, mProfileWidth );
+
+	setPrepared( true );
+}
+
+//--------------------------------------------------------------------------------------
+void ImplProfileMapped::prepare() const
+{
+}
+
+//--------------------------------------------------------------------------------------
+void ImplProfileMapped::release() const
+{
+}
+
+//--------------------------------------------------------------------------------------
+void ImplProfileMapped::swap( const Position & x, const Position & y )
+{
+	THROW( "profiles in a library are read-only" );
+}
+
+//--------------------------------------------------------------------------------------
+void ImplProfileMapped::mask( const Position & from, const Position & to )
+{
+	THROW( "profiles in a library are read-only" );
+}
+
+//--------------------------------------------------------------------------------------
+void ImplProfileMapped::mask( const Position & column )
+{
+	THROW( "profiles in a library are read-only" );
+}
+
+//--------------------------------------------------------------------------------------
+void ImplProfileMapped::load( std::istream & input )
+{
+	THROW( "profiles in a library are read-only" );
+}
+
+//--------------------------------------------------------------------------------------
+void ImplProfileMapped::add(
+		const HAlignandum & source,
+		const HAlignment & map_source2dest,
+		bool is_reverse )
+{
+	THROW( "profiles in a library are read-only" );
+}
+
+//--------------------------------------------------------------------------------------
+void ImplProfileMapped::resize( Position length )
+{
+	THROW( "profiles in a library are read-only" );
+}
+
+} // namespace alignlib
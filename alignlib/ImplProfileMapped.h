@@ -0,0 +1,115 @@
+/*
+  alignlib - a library for aligning protein sequences
+
+  $Id$
+
+  Copyright (C) 2026 Andreas Heger
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+*/
+
+#if HAVE_CONFIG_H
+#include <config.h>
+#endif
+
+#ifndef IMPL_PROFILE_MAPPED_H
+#define IMPL_PROFILE_MAPPED_H 1
+
+#include <iosfwd>
+#include "alignlib_fwd.h"
+#include "ImplProfile.h"
+#include "ImplProfileLibrary.h"
+
+namespace alignlib
+{
+
+/**
+    @short read-only profile with matrices in a memory-mapped file.
+
+    Counts, frequencies and scores point into a @ref MappedFile
+    and are not copied. The profile is always prepared. Functions
+    that modify a profile throw an @ref AlignlibException.
+
+    The matrices returned by the export functions can be written to,
+    but the changes are seen by all profiles sharing the mapped file
+    and are not saved.
+
+    @author Andreas Heger
+    @version $Id$
+ */
+class ImplProfileMapped : public ImplProfile
+{
+public:
+	/* constructors and desctructors------------------------------------------------------- */
+
+	/** constructor */
+	ImplProfileMapped();
+
+	/** constructor
+	 *
+	 * @param file	mapped file containing the matrices.
+	 * @param entry	location of profile in file.
+	 * @param width	width of profile columns.
+	 */
+	ImplProfileMapped(
+			const HMappedFile & file,
+			const ProfileLibraryEntry & entry,
+			Residue width );
+
+	/** copy constructor. The copy shares the mapped matrices. */
+	ImplProfileMapped( const ImplProfileMapped &);
+
+	/** destructor */
+	virtual ~ImplProfileMapped();
+
+    DEFINE_CLONE( HAlignandum );
+
+	/** the profile is always prepared */
+	virtual void prepare() const;
+
+	/** the mapped matrices are kept */
+	virtual void release() const;
+
+	/* the following functions throw an AlignlibException */
+	virtual void swap( const Position & x, const Position & y );
+
+	virtual void mask( const Position & from, const Position & to );
+
+	virtual void mask( const Position & pos);
+
+	virtual void load( std::istream & input ) ;
+
+	virtual void add(
+			const HAlignandum & src,
+			const HAlignment & map_src2dest,
+			const bool reverse_mapping = false );
+
+	virtual void resize( Position length );
+
+protected:
+
+	/** wrap matrices in mapped file */
+	void mapMatrices();
+
+	/** the mapped file */
+	HMappedFile mFile;
+
+	/** location of profile in mapped file */
+	ProfileLibraryEntry mEntry;
+};
+
+}
+
+#endif /* IMPL_PROFILE_MAPPED_H */
@@ -57,6 +57,12 @@ ImplRegularizor::ImplRegularizor (const ImplRegularizor & src )
 
 IMPLEMENT_CLONE( HRegularizor, ImplRegularizor );
 
+//-------------------------------------------------------------------------------------------------------
+bool ImplRegularizor::isColumnIndependent() const
+{
+	return true;
+}
+
 //-------------------------------------------------------------------------------------------------------
 double ImplRegularizor::calculateDiversity( const WeightedCountMatrix & counts ) const
 {
@@ -65,6 +65,9 @@ class ImplRegularizor : public Regularizor, public ImplAlignlibBase
     		const WeightedCountMatrix & counts,
     		const HEncoder & encoder) const;
 
+    /** columns are regularized independently */
+    virtual bool isColumnIndependent() const;
+
  protected:
 	 /** return alignment diversity (average number of different characters)
 	  * */
@@ -21,6 +21,7 @@
  */
 
 #include <math.h>
+#include <string.h>
 #include <iostream>
 
 #include "alignlib_fwd.h"
@@ -79,6 +80,36 @@ static double a[NCOMPONENTS][ALPHABET_SIZE] =
 static double precomputed_lgamma_wa_j[NCOMPONENTS];	/* lgamma( wa_j), index is [j] */
 static double precomputed_sum_lgamma_a_j[NCOMPONENTS];	/* sum_i(lgamma(a_ji)), index is [j] */
 
+//--------------------------------------------------------------------------------------------------------------------------
+static const DirichletMixture * buildDirichletMixture()
+{
+	DirichletMixture * mixture = new DirichletMixture();
+
+	memcpy( mixture->mAlphabet, ALPHABET, sizeof(ALPHABET) );
+
+	for (int j = 0; j < NCOMPONENTS; j++)
+	{
+		mixture->mQ[j] = q[j];
+		mixture->mWa[j] = 0;
+		for (int i = 0; i < ALPHABET_SIZE; i++)
+		{
+			mixture->mA[j][i] = a[j][i];
+			mixture->mLGammaA[j][i] = lgamma( a[j][i] );
+			mixture->mWa[j] += a[j][i];
+		}
+		mixture->mLGammaWa[j] = lgamma( mixture->mWa[j] );
+	}
+
+	return mixture;
+}
+
+HDirichletMixture getDirichletMixture()
+{
+	// initialization of local statics is thread-safe
+	static const HDirichletMixture mixture( buildDirichletMixture() );
+	return mixture;
+}
+
 IMPLEMENT_CLONE( HRegularizor, ImplRegularizorDirichlet );
 
 //---------------------------------------------------------< constructors and destructors >--------------------------------------
@@ -41,6 +41,38 @@ namespace alignlib
     typedef double TYPE_A_COLUMN[ALPHABET_SIZE];
     typedef double TYPE_BETA_DIFFERENCES[NCOMPONENTS];
 
+  /** The 9-component Dirichlet-mixture by Kimmen Sjoerlander together
+      with the quantities derived from it.
+
+      The tables are computed once and never changed afterwards, so that
+      a single copy can be shared between regularizors and threads.
+  */
+struct DirichletMixture
+{
+	/** residues in the order of the mixture components */
+	char mAlphabet[ALPHABET_SIZE+1];
+
+	/** the mixture coefficients q_j */
+	double mQ[NCOMPONENTS];
+
+	/** the mixture components a_ji */
+	double mA[NCOMPONENTS][ALPHABET_SIZE];
+
+	/** |a_j| = sum_i a_ji */
+	double mWa[NCOMPONENTS];
+
+	/** lgamma(a_ji) */
+	double mLGammaA[NCOMPONENTS][ALPHABET_SIZE];
+
+	/** lgamma(|a_j|) */
+	double mLGammaWa[NCOMPONENTS];
+};
+
+typedef boost::shared_ptr<const DirichletMixture> HDirichletMixture;
+
+/** return the Dirichlet-mixture. The tables are built on the first call. */
+HDirichletMixture getDirichletMixture();
+
   /** Implementation of a class that regularizes count columns based
       on the 9-component Dirichlet-mixture by Kimmen Sjoerlander. This
       profile is only defined for the 20 amino acid residues.
@@ -22,7 +22,7 @@
 
 #include <math.h>
 #include <iostream>
-#include <map>
+#include <algorithm>
 
 #include "alignlib_fwd.h"
 #include "alignlib_interfaces.h"
@@ -30,6 +30,10 @@
 #include "Regularizor.h"
 #include "ImplRegularizorDirichletHash.h"
 
+#ifdef HAVE_BOOST_THREAD
+#include <boost/thread/tss.hpp>
+#endif
+
 #ifdef DEBUG
 static int total_hits = 0;
 static int total_lookups = 0;
@@ -49,8 +53,46 @@ namespace alignlib
 
 #define SCALE_FACTOR 10000
 
-typedef std::map< int, double > TYPE_HASH_GAMMA;
-static TYPE_HASH_GAMMA gamma_hash;
+/** a direct-mapped cache of lgamma values.
+ *
+ * A key is the argument of lgamma scaled by SCALE_FACTOR. The cached
+ * values depend only on the key, so that the results do not depend
+ * on the order of lookups.
+ */
+struct TYPE_HASH_GAMMA
+{
+	enum { BITS = 14, SIZE = 1 << BITS };
+
+	TYPE_HASH_GAMMA() { std::fill( mKeys, mKeys + SIZE, -1 ); }
+
+	/** return slot of key */
+	static unsigned int getSlot( int key )
+	{
+		return ((unsigned int)key * 2654435761U) >> (32 - BITS);
+	}
+
+	int mKeys[SIZE];
+	double mValues[SIZE];
+};
+
+/** the hash is kept for each thread */
+#ifdef HAVE_BOOST_THREAD
+static boost::thread_specific_ptr<TYPE_HASH_GAMMA> gamma_hashes;
+
+static TYPE_HASH_GAMMA & getGammaHash()
+{
+	if (gamma_hashes.get() == NULL)
+		gamma_hashes.reset( new TYPE_HASH_GAMMA() );
+	return *gamma_hashes;
+}
+#else
+static TYPE_HASH_GAMMA global_gamma_hash;
+
+static TYPE_HASH_GAMMA & getGammaHash()
+{
+	return global_gamma_hash;
+}
+#endif
 
 //---------------------------------------------------------< constructors and destructors >--------------------------------------
 ImplRegularizorDirichletHash::ImplRegularizorDirichletHash ( WeightedCount fade_cutoff ) : ImplRegularizorDirichlet( fade_cutoff ) {
@@ -75,26 +117,28 @@ ImplRegularizorDirichletHash::ImplRegularizorDirichletHash (const ImplRegularizo
 /** This function encapsulates that part of the algorithm, that needs to access the lgamma-function. It
     has been externalized, so that it can be overloaded to implement different speed-ups.
 
-    This function uses the lgamma-function directly.
+    The value is computed for the middle of the interval of width 1/SCALE_FACTOR
+    that x falls into.
 */
-inline double LookUp( double x ) {
+inline double LookUp( TYPE_HASH_GAMMA & gamma_hash, double x ) {
 
   int key = (int)(x * SCALE_FACTOR);
-
-  TYPE_HASH_GAMMA::iterator it;
+  unsigned int slot = TYPE_HASH_GAMMA::getSlot( key );
 
 #ifdef DEBUG
   total_lookups++;
 #endif
 
-  if ( (it = gamma_hash.find( key )) != gamma_hash.end())
-{
-  debug_func_cerr(5);
-
-    return (*it).second;
+  if (gamma_hash.mKeys[slot] == key)
+  {
+#ifdef DEBUG
+    total_hits++;
+#endif
+    return gamma_hash.mValues[slot];
   }  else {
-    double value = lgamma( x );
-    gamma_hash[key] = value;
+    double value = lgamma( (key + 0.5) / SCALE_FACTOR );
+    gamma_hash.mKeys[slot] = key;
+    gamma_hash.mValues[slot] = value;
     return value;
   }
 }
@@ -104,20 +148,21 @@ inline double LookUp( double x ) {
 // LBeta        = log prod_i(Gamma(xi)) / gamma( |x| )
 //      = sum_i lgamma(xi) - lgamma( |x| )
 
-inline static double lBeta ( const double * vector, const double length ) {
+inline static double lBeta ( TYPE_HASH_GAMMA & gamma_hash, const double * vector, const double length ) {
   double result = 0;
   int i;
   for (i = 0; i < ALPHABET_SIZE; i++)
-    result += LookUp( vector[i] );
+    result += LookUp( gamma_hash, vector[i] );
 
-  return (result - LookUp( length ));
+  return (result - LookUp( gamma_hash, length ));
 }
 
 //-------------------------------------------------------------------------------------------------------
 // calculate the logarithm of the beta-function for sum of two vectors. In Kimmens script |x| is
 // defined as sum_xi, so |x| + |y| = | x + y | !!
 // the first vector is an int
-inline static double lBetaSum ( const WeightedCount * vector1,
+inline static double lBetaSum ( TYPE_HASH_GAMMA & gamma_hash,
+			 const WeightedCount * vector1,
 			 const WeightedCount length1,
 			 const double *vector2,
 			 const WeightedCount length2) {
@@ -125,16 +170,17 @@ inline static double lBetaSum ( const WeightedCount * vector1,
     int i;
 
     for (i = 0; i < ALPHABET_SIZE; i++)
-	result += LookUp( vector1[i] + vector2[i]);
+	result += LookUp( gamma_hash, vector1[i] + vector2[i]);
 
-    return (result - LookUp( length1 + length2 ));
+    return (result - LookUp( gamma_hash, length1 + length2 ));
 }
 
 //-------------------------------------------------------------------------------------------------------
 /** This function encapsulates that part of the algorithm, that needs to access the lgamma-function. It
     has been externalized, so that it can be overloaded to implement different speed-ups.
 
-    This function uses the lgamma-function directly.
+    The hash is kept between columns and profiles. Columns can be
+    regularized in any order and in several threads.
 */
 double ImplRegularizorDirichletHash::calculateBetaDifferences(
 		TYPE_BETA_DIFFERENCES beta_differences,
@@ -144,10 +190,11 @@ double ImplRegularizorDirichletHash::calculateBetaDifferences(
 
   double max_log_difference = 0;
   int j;
+  TYPE_HASH_GAMMA & gamma_hash = getGammaHash();
 
   for (j = 0; j < NCOMPONENTS; j++) {
 
-    double difference = lBetaSum( n, ntotal, mA[j], mWa[j] ) - lBeta( mA[j], mWa[j] );
+    double difference = lBetaSum( gamma_hash, n, ntotal, mA[j], mWa[j] ) - lBeta( gamma_hash, mA[j], mWa[j] );
     beta_differences[j] = difference;
 
     if (fabs(max_log_difference) < fabs(difference))
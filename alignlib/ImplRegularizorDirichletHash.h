@@ -63,7 +63,8 @@ class ImplRegularizorDirichletHash : public ImplRegularizorDirichlet {
 
 	It returns the maximum difference.
 
-	The implemention here hashes the calls to the lgamma-function
+	The implemention here hashes the calls to the lgamma-function. Each thread
+	keeps its own hash.
     */
     virtual double calculateBetaDifferences(  TYPE_BETA_DIFFERENCES beta_differences,
     		const WeightedCount * n,
@@ -0,0 +1,406 @@
+/*
+  alignlib - a library for aligning protein sequences
+
+  $Id$
+
+  Copyright (C) 2026 Andreas Heger
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+*/
+
+#include <math.h>
+#include <iostream>
+
+#include "alignlib_fwd.h"
+#include "alignlib_interfaces.h"
+#include "AlignlibDebug.h"
+#include "AlignlibException.h"
+#include "AlignlibSimd.h"
+#include "Regularizor.h"
+#include "ImplRegularizorDirichletVectorized.h"
+#include "Matrix.h"
+
+using namespace std;
+
+namespace alignlib
+{
+
+#define NO_FADE_CUTOFF 1000000
+
+/** number of columns that are processed together */
+#define BLOCK_SIZE 8
+
+/** maximum number of lgamma evaluations per column: one for each residue
+ * and component and one for each component */
+#define NARGUMENTS (NCOMPONENTS * (ALPHABET_SIZE + 1))
+
+/** lgamma is evaluated for a multiple of this number of arguments */
+#define NPADDING 8
+
+/** factory functions */
+HRegularizor makeRegularizorDirichletVectorized( WeightedCount fade_cutoff )
+{
+	return HRegularizor( new ImplRegularizorDirichletVectorized( fade_cutoff ) );
+}
+
+IMPLEMENT_CLONE( HRegularizor, ImplRegularizorDirichletVectorized );
+
+//---------------------------------------------------------< constructors and destructors >--------------------------------------
+ImplRegularizorDirichletVectorized::ImplRegularizorDirichletVectorized ( const WeightedCount & fade_cutoff ) :
+	mFadeCutoff ( fade_cutoff ),
+	mMixture( getDirichletMixture() )
+{
+	debug_func_cerr(5);
+
+	if (mFadeCutoff <= 0)
+		mFadeCutoff = NO_FADE_CUTOFF;
+}
+
+//--------------------------------------------------------------------------------------------------------------------------------
+ImplRegularizorDirichletVectorized::~ImplRegularizorDirichletVectorized ()
+{
+	debug_func_cerr(5);
+}
+
+//-------------------------------------------------------------------------------------------------------------------------------
+ImplRegularizorDirichletVectorized::ImplRegularizorDirichletVectorized (const ImplRegularizorDirichletVectorized & src ) :
+	ImplRegularizor( src ),
+	mFadeCutoff( src.mFadeCutoff ),
+	mMixture( src.mMixture )
+{
+}
+
+//-------------------------------------------------------------------------------------------------------
+// Approximation of lgamma(x) for x > 0.
+//
+// The argument is shifted by 8 using the recurrence
+//     lgamma(x) = lgamma(x+8) - log( x (x+1) ... (x+7) )
+// and lgamma(x+8) is computed with Stirling's series up to z^-11.
+// The absolute error is below 1e-13.
+
+#define HALF_LOG_2PI 0.91893853320467274178
+#define STIRLING1 (1.0/12.0)
+#define STIRLING2 (-1.0/360.0)
+#define STIRLING3 (1.0/1260.0)
+#define STIRLING4 (-1.0/1680.0)
+#define STIRLING5 (1.0/1188.0)
+#define STIRLING6 (-691.0/360360.0)
+
+#ifdef ALIGNLIB_HAVE_SIMD
+
+typedef SimdDouble::Vector VDouble;
+
+/** split positive, normal numbers into a mantissa in [sqrt(1/2), sqrt(2)) and an exponent */
+static inline VDouble splitVector( const VDouble & v, VDouble & exponent )
+{
+	VDouble mantissa = SimdDouble::frexp( v, exponent );
+	const VDouble mask = SimdDouble::cmpgt( mantissa, SimdDouble::set1( M_SQRT2 ) );
+	exponent = SimdDouble::select( mask, SimdDouble::add( exponent, SimdDouble::set1( 1.0 ) ), exponent );
+	return SimdDouble::select( mask, SimdDouble::mul( mantissa, SimdDouble::set1( 0.5 ) ), mantissa );
+}
+
+/** log(m) = 2 atanh(s) for s = (m-1)/(m+1) and |s| < 0.172.
+ *
+ * The polynomial is evaluated with Estrin's scheme to keep the chain of
+ * dependent instructions short.
+ */
+static inline VDouble atanhVector( const VDouble & s )
+{
+	const VDouble s2 = SimdDouble::mul( s, s );
+	const VDouble s4 = SimdDouble::mul( s2, s2 );
+	const VDouble s8 = SimdDouble::mul( s4, s4 );
+
+#define MADD(a,b,c) SimdDouble::add( SimdDouble::mul( a, b ), c )
+	const VDouble p01 = MADD( s2, SimdDouble::set1( 1.0/3.0 ), SimdDouble::set1( 1.0 ) );
+	const VDouble p23 = MADD( s2, SimdDouble::set1( 1.0/7.0 ), SimdDouble::set1( 1.0/5.0 ) );
+	const VDouble p45 = MADD( s2, SimdDouble::set1( 1.0/11.0 ), SimdDouble::set1( 1.0/9.0 ) );
+	const VDouble p67 = MADD( s2, SimdDouble::set1( 1.0/15.0 ), SimdDouble::set1( 1.0/13.0 ) );
+	const VDouble p03 = MADD( s4, p23, p01 );
+	const VDouble p47 = MADD( s4, p67, p45 );
+	const VDouble p08 = MADD( s8, MADD( s8, SimdDouble::set1( 1.0/17.0 ), p47 ), p03 );
+#undef MADD
+
+	return SimdDouble::mul( SimdDouble::add( s, s ), p08 );
+}
+
+static inline VDouble lgammaVector( const VDouble & x )
+{
+	const VDouble one = SimdDouble::set1( 1.0 );
+
+	// x (x+1) ... (x+7) = u (u+6) (u+10) (u+12) with u = x (x+7)
+	const VDouble z = SimdDouble::add( x, SimdDouble::set1( 8.0 ) );
+	const VDouble u = SimdDouble::mul( x, SimdDouble::sub( z, one ) );
+	const VDouble product = SimdDouble::mul(
+			SimdDouble::mul( u, SimdDouble::add( u, SimdDouble::set1( 12.0 ) ) ),
+			SimdDouble::mul( SimdDouble::add( u, SimdDouble::set1( 6.0 ) ),
+					SimdDouble::add( u, SimdDouble::set1( 10.0 ) ) ) );
+
+	VDouble exponent_z, exponent_p;
+	const VDouble mantissa_z = splitVector( z, exponent_z );
+	const VDouble mantissa_p = splitVector( product, exponent_p );
+
+	// compute 1/z, (m_z-1)/(m_z+1) and (m_p-1)/(m_p+1) with a single division
+	const VDouble plus_z = SimdDouble::add( mantissa_z, one );
+	const VDouble plus_p = SimdDouble::add( mantissa_p, one );
+	const VDouble plus_zp = SimdDouble::mul( plus_z, plus_p );
+	const VDouble inverse = SimdDouble::div( one, SimdDouble::mul( plus_zp, z ) );
+	const VDouble r = SimdDouble::mul( plus_zp, inverse );
+	const VDouble inverse_zp = SimdDouble::mul( z, inverse );
+	const VDouble s_z = SimdDouble::mul( SimdDouble::mul( SimdDouble::sub( mantissa_z, one ), plus_p ), inverse_zp );
+	const VDouble s_p = SimdDouble::mul( SimdDouble::mul( SimdDouble::sub( mantissa_p, one ), plus_z ), inverse_zp );
+
+	const VDouble log_2 = SimdDouble::set1( M_LN2 );
+	const VDouble log_z = SimdDouble::add( SimdDouble::mul( exponent_z, log_2 ), atanhVector( s_z ) );
+	const VDouble log_p = SimdDouble::add( SimdDouble::mul( exponent_p, log_2 ), atanhVector( s_p ) );
+
+	const VDouble r2 = SimdDouble::mul( r, r );
+	const VDouble r4 = SimdDouble::mul( r2, r2 );
+	const VDouble s12 = SimdDouble::add( SimdDouble::mul( r2, SimdDouble::set1( STIRLING2 ) ), SimdDouble::set1( STIRLING1 ) );
+	const VDouble s34 = SimdDouble::add( SimdDouble::mul( r2, SimdDouble::set1( STIRLING4 ) ), SimdDouble::set1( STIRLING3 ) );
+	const VDouble s56 = SimdDouble::add( SimdDouble::mul( r2, SimdDouble::set1( STIRLING6 ) ), SimdDouble::set1( STIRLING5 ) );
+	const VDouble series = SimdDouble::mul( r,
+			SimdDouble::add( s12, SimdDouble::mul( r4, SimdDouble::add( s34, SimdDouble::mul( r4, s56 ) ) ) ) );
+
+	// (z - 1/2) log(z) - z + log(2 pi)/2 + series - log(product)
+	const VDouble a = SimdDouble::mul( SimdDouble::sub( z, SimdDouble::set1( 0.5 ) ), log_z );
+	const VDouble b = SimdDouble::sub( SimdDouble::add( SimdDouble::set1( HALF_LOG_2PI ), series ), z );
+	return SimdDouble::add( a, SimdDouble::sub( b, log_p ) );
+}
+
+#endif
+
+static inline double lgammaScalar( double x )
+{
+	double z = x;
+	double product = x;
+	for (int i = 1; i < 8; ++i)
+	{
+		z += 1.0;
+		product *= z;
+	}
+	z += 1.0;
+
+	const double r = 1.0 / z;
+	const double r2 = r * r;
+	const double series = r * (STIRLING1 + r2 * (STIRLING2 + r2 * (STIRLING3 +
+			r2 * (STIRLING4 + r2 * (STIRLING5 + r2 * STIRLING6)))));
+
+	return (z - 0.5) * log( z ) - z + HALF_LOG_2PI + series - log( product );
+}
+
+/** replace n positive values by their log-gamma. n is a multiple of @ref NPADDING */
+static void lgammaArray( double * values, size_t n )
+{
+#ifdef ALIGNLIB_HAVE_SIMD
+	// two independent vectors per iteration to hide latencies
+	for (size_t x = 0; x < n; x += 2 * SimdDouble::LANES)
+	{
+		const VDouble a = lgammaVector( SimdDouble::loadu( values + x ) );
+		const VDouble b = lgammaVector( SimdDouble::loadu( values + x + SimdDouble::LANES ) );
+		SimdDouble::storeu( values + x, a );
+		SimdDouble::storeu( values + x + SimdDouble::LANES, b );
+	}
+#else
+	for (size_t x = 0; x < n; ++x)
+		values[x] = lgammaScalar( values[x] );
+#endif
+}
+
+//-------------------------------------------------------------------------------------------------------
+/** a block of columns that are regularized together */
+struct DirichletBlock
+{
+	DirichletBlock() : mSize( 0 ) {}
+
+	/** number of columns in block */
+	int mSize;
+
+	/** column indices */
+	Position mColumns[BLOCK_SIZE];
+
+	/** counts of each column */
+	const WeightedCount * mCounts[BLOCK_SIZE];
+
+	/** total counts of each column */
+	WeightedCount mTotals[BLOCK_SIZE];
+
+	/** number of residues with counts in each column */
+	int mNumObserved[BLOCK_SIZE];
+
+	/** residues with counts in each column */
+	int mObserved[BLOCK_SIZE][ALPHABET_SIZE];
+
+	/** arguments to and results of lgamma for all columns */
+	double mArguments[BLOCK_SIZE * NARGUMENTS + NPADDING];
+};
+
+/** fill frequencies for all columns in a block. See ImplRegularizorDirichlet::fillColumn
+ *
+ * The beta differences are
+ *
+ * sum_i [lgamma(n_i + a_ji) - lgamma(a_ji)] - [lgamma(ntotal + |a_j|) - lgamma(|a_j|)]
+ *
+ * Residues without counts do not contribute, thus lgamma is only
+ * computed for the observed residues.
+ */
+static void fillBlock(
+		DirichletBlock & block,
+		const DirichletMixture & mixture,
+		const Residue * map,
+		FrequencyMatrix & frequencies )
+{
+	// collect arguments of lgamma for all columns
+	int offsets[BLOCK_SIZE];
+	int size = 0;
+	for (int c = 0; c < block.mSize; ++c)
+	{
+		const WeightedCount * n = block.mCounts[c];
+		const int * observed = block.mObserved[c];
+		const int nobserved = block.mNumObserved[c];
+
+		offsets[c] = size;
+		for (int j = 0; j < NCOMPONENTS; ++j)
+		{
+			for (int k = 0; k < nobserved; ++k)
+				block.mArguments[size++] = n[map[observed[k]]] + mixture.mA[j][observed[k]];
+			block.mArguments[size++] = block.mTotals[c] + mixture.mWa[j];
+		}
+	}
+	while (size % NPADDING != 0)
+		block.mArguments[size++] = 1.0;
+
+	lgammaArray( block.mArguments, size );
+
+	for (int c = 0; c < block.mSize; ++c)
+	{
+		const WeightedCount * n = block.mCounts[c];
+		const WeightedCount ntotal = block.mTotals[c];
+		const int * observed = block.mObserved[c];
+		const int nobserved = block.mNumObserved[c];
+		const double * lgammas = block.mArguments + offsets[c];
+
+		// beta differences; scaled by the difference with the largest magnitude
+		// so that the ratios can be represented as double
+		TYPE_BETA_DIFFERENCES beta_differences;
+		double max_log_difference = 0;
+		for (int j = 0; j < NCOMPONENTS; ++j)
+		{
+			double difference = 0;
+			for (int k = 0; k < nobserved; ++k)
+				difference += lgammas[k] - mixture.mLGammaA[j][observed[k]];
+			difference -= lgammas[nobserved] - mixture.mLGammaWa[j];
+			lgammas += nobserved + 1;
+
+			beta_differences[j] = difference;
+			if (fabs(max_log_difference) < fabs(difference))
+				max_log_difference = difference;
+		}
+
+		// Xi = sum_j w_j (a_ji + n_i) = sum_j w_j a_ji + n_i sum_j w_j
+		double weights[NCOMPONENTS];
+		double total_weight = 0;
+		for (int j = 0; j < NCOMPONENTS; ++j)
+		{
+			weights[j] = mixture.mQ[j] * exp( beta_differences[j] - max_log_difference ) /
+				(mixture.mWa[j] + ntotal);
+			total_weight += weights[j];
+		}
+
+		double Xi[ALPHABET_SIZE];
+		for (int i = 0; i < ALPHABET_SIZE; ++i)
+			Xi[i] = 0;
+		for (int j = 0; j < NCOMPONENTS; ++j)
+			for (int i = 0; i < ALPHABET_SIZE; ++i)
+				Xi[i] += weights[j] * mixture.mA[j][i];
+
+		double xtotal = 0;
+		for (int i = 0; i < ALPHABET_SIZE; ++i)
+		{
+			Xi[i] += n[map[i]] * total_weight;
+			xtotal += Xi[i];
+		}
+
+		if (xtotal > 0)
+		{
+			Frequency * column = frequencies.getRow( block.mColumns[c] );
+			for (int i = 0; i < ALPHABET_SIZE; ++i)
+				column[map[i]] = (Frequency)(Xi[i] / xtotal);
+		}
+	}
+
+	block.mSize = 0;
+}
+
+//-------------------------------------------------------------------------------------------------------
+void ImplRegularizorDirichletVectorized::fillFrequencies(
+		FrequencyMatrix & frequencies,
+		const WeightedCountMatrix & counts,
+		const HEncoder & encoder ) const
+{
+	debug_func_cerr(5);
+
+	const Position width = counts.getNumCols();
+	const Position length = counts.getNumRows();
+
+	// map residues of the mixture to columns in the profile
+	Residue map[ALPHABET_SIZE];
+	for (int i = 0; i < ALPHABET_SIZE; ++i)
+	{
+		map[i] = encoder->encode( mMixture->mAlphabet[i] );
+		if (map[i] >= width)
+			THROW( "residue " + std::string( 1, mMixture->mAlphabet[i] ) + " is not part of the profile" );
+	}
+
+	DirichletBlock block;
+
+	for (Position column = 0; column < length; ++column)
+	{
+		const WeightedCount * n = counts.getRow( column );
+
+		WeightedCount ntotal = 0;
+		for (Position i = 0; i < width; ++i)
+			ntotal += n[i];
+
+		// columns without observations are left unchanged
+		if (ntotal == 0)
+			continue;
+
+		if (ntotal < mFadeCutoff)
+		{
+			block.mColumns[block.mSize] = column;
+			block.mCounts[block.mSize] = n;
+			block.mTotals[block.mSize] = ntotal;
+			int nobserved = 0;
+			for (int i = 0; i < ALPHABET_SIZE; ++i)
+				if (n[map[i]] != 0)
+					block.mObserved[block.mSize][nobserved++] = i;
+			block.mNumObserved[block.mSize] = nobserved;
+			if (++block.mSize == BLOCK_SIZE)
+				fillBlock( block, *mMixture, map, frequencies );
+		}
+		else
+		{
+			// calculate raw frequencies
+			Frequency * col = frequencies.getRow( column );
+			for (Position i = 0; i < width; ++i)
+				col[i] = (Frequency)(n[i] / ntotal);
+		}
+	}
+
+	if (block.mSize > 0)
+		fillBlock( block, *mMixture, map, frequencies );
+}
+
+} // namespace alignlib
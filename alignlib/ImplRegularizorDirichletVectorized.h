@@ -0,0 +1,86 @@
+/*
+  alignlib - a library for aligning protein sequences
+
+  $Id$
+
+  Copyright (C) 2026 Andreas Heger
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+*/
+
+
+#if HAVE_CONFIG_H
+#include <config.h>
+#endif
+
+#ifndef IMPL_REGULARIZOR_DIRICHLET_VECTORIZED_H
+#define IMPL_REGULARIZOR_DIRICHLET_VECTORIZED_H 1
+
+#include "alignlib_fwd.h"
+#include "ImplRegularizor.h"
+#include "ImplRegularizorDirichlet.h"
+
+namespace alignlib
+{
+
+  /** Regularizor using the 9-component Dirichlet-mixture by Kimmen Sjoerlander.
+
+      The results are the same as for @ref ImplRegularizorDirichlet up to
+      rounding, but the implementation is faster and can be used
+      from several threads at the same time:
+
+      The mixture tables are shared and immutable (see @ref DirichletMixture).
+      Columns are processed in blocks. The log-gamma function is
+      evaluated for all components and residues of all columns in a
+      block in one go by an approximation that uses vector instructions.
+
+      @author Andreas Heger
+      @version $Id$
+      @short regularizor using a Dirichlet-mixture
+  */
+
+class ImplRegularizorDirichletVectorized : public ImplRegularizor
+{
+ public:
+    // constructors and desctructors
+
+    /** default constructor */
+    ImplRegularizorDirichletVectorized  ( const WeightedCount & fade_cutoff = -1 );
+
+    /** copy constructor */
+    ImplRegularizorDirichletVectorized  (const ImplRegularizorDirichletVectorized &);
+
+    /** destructor */
+    virtual ~ImplRegularizorDirichletVectorized ();
+
+    DEFINE_CLONE( HRegularizor );
+
+    /** copy the counts into the frequencies and regularize them by doing so. */
+    virtual void fillFrequencies( FrequencyMatrix & frequencies,
+				  				  const WeightedCountMatrix & counts,
+				  				  const HEncoder & encoder) const;
+
+ private:
+
+    /** the cutoff used for fading out the Dirichlet-mixture */
+	WeightedCount mFadeCutoff;
+
+	/** the mixture tables */
+	HDirichletMixture mMixture;
+};
+
+}
+
+#endif /* IMPL_REGULARIZOR_DIRICHLET_VECTORIZED_H */
@@ -117,6 +117,12 @@ ImplRegularizorTatusov::ImplRegularizorTatusov (const ImplRegularizorTatusov & s
 {
 }
 
+//-------------------------------------------------------------------------------------------------------
+bool ImplRegularizorTatusov::isColumnIndependent() const
+{
+	return false;
+}
+
 //-------------------------------------------------------------------------------------------------------
 /**
  *  */
@@ -73,6 +73,9 @@ class ImplRegularizorTatusov : public ImplRegularizor
 				  				  const WeightedCountMatrix & counts,
 				  				  const HEncoder & encoder ) const;
 
+    /** the pseudocounts depend on the diversity of all columns */
+    virtual bool isColumnIndependent() const;
+
  protected:
 
 	 /** substitution matrix */
@@ -81,6 +81,11 @@ HScorer ImplScorer::getNew(
 
 IMPLEMENT_CLONE( HScorer, ImplScorer );
 
+bool ImplScorer::setCol( const HAlignandum & col )
+{
+	return false;
+}
+
 Score ImplScorer::getScore( const Position & row, const Position & col) const
 {
 	throw AlignlibException( "asked from a score from the default scorer ");
@@ -59,6 +59,11 @@ namespace alignlib
     		  const HAlignandum & row,
     		  const HAlignandum & col) const;
 
+      /** initialize this scorer for a new col. The default
+       * implementation returns false.
+       */
+      virtual bool setCol( const HAlignandum & col );
+
       virtual Score getScore(
     		  const Position & row,
     		  const Position & col ) const;
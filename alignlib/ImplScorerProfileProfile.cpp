@@ -111,6 +111,22 @@ namespace alignlib
 	  return HScorer( new ImplScorerProfileProfile( s1, s2 ) );
   }
 
+  //--------------------------------------------------------------------------------------
+  bool ImplScorerProfileProfile::setCol( const HAlignandum & col )
+  {
+	  debug_func_cerr( 5 );
+	  const HImplProfile s2 = boost::dynamic_pointer_cast<ImplProfile, Alignandum>(col);
+	  if (!s2)
+		  return false;
+
+	  if ( mProfileWidth != s2->getToolkit()->getEncoder()->getAlphabetSize() )
+		  throw AlignlibException( "ImplScorerProfileProfile.cpp: alphabet size different in row and col");
+
+	  mColProfile     = s2->exportScoreMatrix();
+	  mColFrequencies = s2->exportFrequencyMatrix();
+	  return true;
+  }
+
   /** return score of matching row to col
    */
   Score ImplScorerProfileProfile::getScore(
@@ -62,6 +62,9 @@ namespace alignlib
     		  const HAlignandum & row,
     		  const HAlignandum & col) const;
 
+      /** initialize this scorer for a new col */
+      virtual bool setCol( const HAlignandum & col );
+
       virtual Score getScore(
     		  const Position & row,
     		  const Position & col ) const;
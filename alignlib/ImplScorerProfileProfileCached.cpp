@@ -0,0 +1,190 @@
+/*
+  alignlib - a library for aligning protein sequences
+
+  $Id$
+
+  Copyright (C) 2026 Andreas Heger
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+*/
+
+#include <iostream>
+#include <iomanip>
+#include <algorithm>
+#include "AlignlibException.h"
+#include "AlignlibDebug.h"
+#include "Alignandum.h"
+#include "HelpersScorer.h"
+#include "ImplProfile.h"
+#include "ImplScorerProfileProfileCached.h"
+#include "AlignlibSimd.h"
+
+using namespace std;
+
+namespace alignlib
+{
+
+  /** return prototype for scorers using a score cache for profile/profile alignment
+   */
+  HScorer makeScorerProfileProfileCached()
+  {
+	  return HScorer( new ImplScorerProfileProfileCached() );
+  }
+
+  //--------------------------------------------------------------------------------------
+  ImplScorerProfileProfileCached::ImplScorerProfileProfileCached() :
+	  ImplScorerProfileProfile(),
+	  mRowFrom(0), mNumRows(0), mColFrom(0), mNumCols(0)
+	  {}
+
+  //--------------------------------------------------------------------------------------
+  ImplScorerProfileProfileCached::ImplScorerProfileProfileCached(
+		  const HProfile & row,
+		  const HProfile & col ) :
+    ImplScorerProfileProfile( row, col ),
+    mRowFrom( row->getFrom() ), mNumRows( row->getTo() - row->getFrom() ),
+    mColFrom( col->getFrom() ), mNumCols( col->getTo() - col->getFrom() )
+  {
+	  debug_func_cerr( 5 );
+	  fillCache();
+  }
+
+  //--------------------------------------------------------------------------------------
+  ImplScorerProfileProfileCached::~ImplScorerProfileProfileCached ()
+  {
+  }
+
+  //--------------------------------------------------------------------------------------
+  ImplScorerProfileProfileCached::ImplScorerProfileProfileCached(const ImplScorerProfileProfileCached & src) :
+    ImplScorerProfileProfile(src),
+    mRowFrom( src.mRowFrom ), mNumRows( src.mNumRows ),
+    mColFrom( src.mColFrom ), mNumCols( src.mNumCols ),
+    mScores( src.mScores )
+  {
+  }
+
+  IMPLEMENT_CLONE( HScorer, ImplScorerProfileProfileCached );
+
+  //--------------------------------------------------------------------------------------
+  HScorer ImplScorerProfileProfileCached::getNew(
+		  const HAlignandum & row,
+		  const HAlignandum & col) const
+  {
+	  debug_func_cerr( 5 );
+	  const HProfile s1 = boost::dynamic_pointer_cast<Profile, Alignandum>(row);
+	  const HProfile s2 = boost::dynamic_pointer_cast<Profile, Alignandum>(col);
+
+	  if (s1 && s2 &&
+			  (size_t)(s1->getTo() - s1->getFrom()) * (size_t)(s2->getTo() - s2->getFrom()) <= MAX_CACHE_SIZE)
+		  return HScorer( new ImplScorerProfileProfileCached( s1, s2 ) );
+	  else
+		  return makeScorer( row, col );
+  }
+
+  //--------------------------------------------------------------------------------------
+  bool ImplScorerProfileProfileCached::setCol( const HAlignandum & col )
+  {
+	  debug_func_cerr( 5 );
+
+	  // the buffer for the scores is kept
+	  if ((size_t)mNumRows * (size_t)(col->getTo() - col->getFrom()) > MAX_CACHE_SIZE)
+		  return false;
+
+	  if (!ImplScorerProfileProfile::setCol( col ))
+		  return false;
+
+	  mColFrom = col->getFrom();
+	  mNumCols = col->getTo() - col->getFrom();
+	  fillCache();
+	  return true;
+  }
+
+  //--------------------------------------------------------------------------------------
+  void ImplScorerProfileProfileCached::fillCache()
+  {
+	  debug_func_cerr( 5 );
+
+	  const size_t num_cols = mNumCols;
+	  const size_t size = (size_t)mNumRows * num_cols;
+	  if (size > MAX_CACHE_SIZE)
+		  THROW( "score cache too large for profiles of length " + toString( mNumRows ) +
+				  " and " + toString( mNumCols ) );
+
+	  mScores.resize( size );
+	  if (mScores.empty()) return;
+
+	  // transpose the column profile, so that the inner
+	  // loop runs over consecutive columns
+	  std::vector<Score> profile_col( mProfileWidth * num_cols );
+	  std::vector<Frequency> frequency_col( mProfileWidth * num_cols );
+
+	  for (Position j = 0; j < mNumCols; ++j)
+	  {
+		  const Score * p = mColProfile->getRow( mColFrom + j );
+		  const Frequency * f = mColFrequencies->getRow( mColFrom + j );
+		  for (int k = 0; k < mProfileWidth; ++k)
+		  {
+			  profile_col[k * num_cols + j] = p[k];
+			  frequency_col[k * num_cols + j] = f[k];
+		  }
+	  }
+
+	  // process columns in blocks so that the transposed
+	  // column profile stays in the cache for all rows.
+	  // The order of the summation is the same as in
+	  // ImplScorerProfileProfile::getScore(), thus the scores are identical.
+	  const Position block_size = 256;
+
+	  for (Position block_from = 0; block_from < mNumCols; block_from += block_size)
+	  {
+		  const Position block_to = std::min( block_from + block_size, mNumCols );
+
+		  for (Position i = 0; i < mNumRows; ++i)
+		  {
+			  const Score * profile_row = mRowProfile->getRow( mRowFrom + i );
+			  const Frequency * frequency_row = mRowFrequencies->getRow( mRowFrom + i );
+			  Score * scores = &mScores[ i * num_cols ];
+
+			  for (Position j = block_from; j < block_to; ++j)
+				  scores[j] = 0;
+
+			  for (int k = 0; k < mProfileWidth; ++k)
+			  {
+				  const Score pr = profile_row[k];
+				  const Frequency fr = frequency_row[k];
+				  const Score * pc = &profile_col[k * num_cols];
+				  const Frequency * fc = &frequency_col[k * num_cols];
+
+				  Position j = block_from;
+#ifdef ALIGNLIB_HAVE_SIMD
+				  const SimdDouble::Vector vpr = SimdDouble::set1( pr );
+				  const SimdDouble::Vector vfr = SimdDouble::set1( fr );
+				  for (; j + SimdDouble::LANES <= block_to; j += SimdDouble::LANES)
+				  {
+					  SimdDouble::Vector v = SimdDouble::add(
+							  SimdDouble::mul( vpr, SimdDouble::loadu( fc + j ) ),
+							  SimdDouble::mul( SimdDouble::loadu( pc + j ), vfr ) );
+					  SimdDouble::storeu( scores + j,
+							  SimdDouble::add( SimdDouble::loadu( scores + j ), v ) );
+				  }
+#endif
+				  for (; j < block_to; ++j)
+					  scores[j] += pr * fc[j] + pc[j] * fr;
+			  }
+		  }
+	  }
+  }
+
+}
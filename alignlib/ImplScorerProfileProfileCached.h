@@ -0,0 +1,119 @@
+/*
+  alignlib - a library for aligning protein sequences
+
+  $Id$
+
+  Copyright (C) 2026 Andreas Heger
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+*/
+
+
+#if HAVE_CONFIG_H
+#include <config.h>
+#endif
+
+#ifndef IMPL_SCORER_PROFILE_PROFILE_CACHED_H
+#define IMPL_SCORER_PROFILE_PROFILE_CACHED_H 1
+
+#include <vector>
+#include "alignlib_fwd.h"
+#include "ImplScorerProfileProfile.h"
+
+namespace alignlib
+{
+
+  /** score profile against profile using a precomputed score matrix.
+
+  	  The scores for all pairs of positions in the active segments
+  	  of row and col are computed when the object is created. The
+  	  computation is a blocked matrix product of the profiles and the
+  	  frequencies, which the compiler can vectorize.
+
+  	  The scores are identical to those of @ref ImplScorerProfileProfile.
+
+  	  If row and col are not both profiles or if the score matrix
+  	  would exceed MAX_CACHE_SIZE entries, getNew() returns the default
+  	  scorer. Thus this object can be used as a prototype in a
+  	  @ref Toolkit.
+   */
+  class ImplScorerProfileProfileCached : public ImplScorerProfileProfile
+  {
+    public:
+
+      /** empty constructor */
+      ImplScorerProfileProfileCached();
+
+      /**  constructor */
+      ImplScorerProfileProfileCached(
+    		  const HProfile & row,
+       		  const HProfile & col);
+
+      /** destructor */
+      virtual ~ImplScorerProfileProfileCached ();
+
+      /** copy constructor */
+      ImplScorerProfileProfileCached( const ImplScorerProfileProfileCached & src);
+
+      DEFINE_CLONE( HScorer );
+
+      /** return a new scorer of same type initialized with row and col
+       */
+      virtual HScorer getNew(
+    		  const HAlignandum & row,
+    		  const HAlignandum & col) const;
+
+      /** initialize this scorer for a new col */
+      virtual bool setCol( const HAlignandum & col );
+
+      /** return score of matching row to col */
+      virtual Score getScore(
+    		  const Position & row,
+    		  const Position & col ) const
+      {
+    	  assert( row >= mRowFrom && row < mRowFrom + mNumRows );
+    	  assert( col >= mColFrom && col < mColFrom + mNumCols );
+    	  return mScores[ (size_t)(row - mRowFrom) * (size_t)mNumCols + (size_t)(col - mColFrom) ];
+      }
+
+      /** maximum number of scores in the cache. For larger pairs
+       * of profiles, getNew() returns a scorer without cache. */
+      static const size_t MAX_CACHE_SIZE = (size_t)1 << 26;
+
+  protected:
+
+      /** compute the scores for all pairs of positions */
+      void fillCache();
+
+      /** first row in cache */
+      Position mRowFrom;
+
+      /** number of rows in cache */
+      Position mNumRows;
+
+      /** first column in cache */
+      Position mColFrom;
+
+      /** number of columns in cache */
+      Position mNumCols;
+
+      /** the cached scores */
+      std::vector<Score> mScores;
+  };
+
+}
+
+
+#endif /* IMPL_SCORER_PROFILE_PROFILE_CACHED_H */
@@ -100,6 +100,20 @@ namespace alignlib
 	  return HScorer( new ImplScorerProfileSequence( s1, s2 ) ) ;
   }
 
+  //--------------------------------------------------------------------------------------
+  bool ImplScorerProfileSequence::setCol( const HAlignandum & col )
+  {
+	  const HImplSequence s2 = boost::dynamic_pointer_cast<ImplSequence, Alignandum>(col);
+	  if (!s2)
+		  return false;
+
+	  if ( mProfileWidth != s2->getToolkit()->getEncoder()->getAlphabetSize() )
+		  throw AlignlibException( "ImplScorerProfileSequence.cpp: alphabet size different in row and col");
+
+	  mColSequence = s2->getSequence();
+	  return true;
+  }
+
   /** return score of matching row to col
    */
   Score ImplScorerProfileSequence::getScore(
@@ -58,6 +58,9 @@ namespace alignlib
        */
       virtual HScorer getNew( const HAlignandum & row, const HAlignandum & col) const;
 
+      /** initialize this scorer for a new col */
+      virtual bool setCol( const HAlignandum & col );
+
       virtual Score getScore(
     		  const Position & row,
     		  const Position & col ) const;
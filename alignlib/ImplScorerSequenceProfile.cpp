@@ -110,6 +110,22 @@ namespace alignlib
 	  return HScorer( new ImplScorerSequenceProfile( s1, s2 ) );
   }
 
+  //--------------------------------------------------------------------------------------
+  bool ImplScorerSequenceProfile::setCol( const HAlignandum & col )
+  {
+	  debug_func_cerr( 5 );
+
+	  const HImplProfile s2 = boost::dynamic_pointer_cast<ImplProfile, Alignandum>(col);
+	  if (!s2)
+		  return false;
+
+	  if ( mProfileWidth != s2->getToolkit()->getEncoder()->getAlphabetSize() )
+		  throw AlignlibException( "ImplScorerSequenceProfile.cpp: alphabet size different in row and col");
+
+	  mColProfile = s2->exportScoreMatrix();
+	  return true;
+  }
+
   /** return score of matching row to col
    */
   Score ImplScorerSequenceProfile::getScore( const Position & row, const Position & col ) const
@@ -113,6 +113,22 @@ namespace alignlib
 	  return HScorer( new ImplScorerSequenceSequence( s1, s2, mSubstitutionMatrix ) );
   }
 
+  //--------------------------------------------------------------------------------------
+  bool ImplScorerSequenceSequence::setCol( const HAlignandum & col )
+  {
+	  debug_func_cerr( 5 );
+
+	  const HImplSequence s2(boost::dynamic_pointer_cast< ImplSequence, Alignandum>(col));
+	  if (!s2)
+		  return false;
+
+	  if ( mSubstitutionMatrix->getNumCols() < col->getToolkit()->getEncoder()->getAlphabetSize() )
+		  throw AlignlibException( "ImplScorerSequenceSequence.cpp: alphabet size in substitution matrix too small for col");
+
+	  mColSequence = s2->getSequence();
+	  return true;
+  }
+
   /** return score of matching row to col
    */
   Score ImplScorerSequenceSequence::getScore(
@@ -124,6 +140,11 @@ namespace alignlib
     return mSubstitutionMatrix->getValue((*mRowSequence)[row],(*mColSequence)[col]);
   }
 
+  const HSubstitutionMatrix & ImplScorerSequenceSequence::getSubstitutionMatrix() const
+  {
+	  return mSubstitutionMatrix;
+  }
+
 }
 
 
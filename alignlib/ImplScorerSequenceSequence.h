@@ -63,10 +63,16 @@ namespace alignlib
     		  const HAlignandum & row,
     		  const HAlignandum & col) const;
 
+      /** initialize this scorer for a new col */
+      virtual bool setCol( const HAlignandum & col );
+
       virtual Score getScore(
     		  const Position & row,
     		  const Position & col ) const;
 
+      /** return the substitution matrix used for scoring */
+      virtual const HSubstitutionMatrix & getSubstitutionMatrix() const;
+
   protected:
       /** pointer to member data of row/col : AlignandumSequence */
       const ResidueVector * mRowSequence;
@@ -141,6 +141,7 @@ void ImplSequence::swap( const Position & x, const Position & y )
 	assert( y >= 0);
 	assert( y < getFullLength() );
 	std::swap( mSequence[x], mSequence[y] );
+	clearCache();
 }
 
 //--------------------------------------------------------------------------------------
@@ -0,0 +1,445 @@
+/*
+  alignlib - a library for aligning protein sequences
+
+  $Id$
+
+  Copyright (C) 2026 Andreas Heger
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+*/
+
+
+#include <iostream>
+#include <iomanip>
+#include <algorithm>
+#include <limits>
+#include <numeric>
+#include <vector>
+#include <string>
+
+#include "alignlib_fwd.h"
+#include "alignlib_interfaces.h"
+#include "AlignlibDebug.h"
+#include "AlignlibException.h"
+#include "HelpersAlignment.h"
+#include "HelpersSequenceIndex.h"
+#include "ImplSequenceIndex.h"
+
+using namespace std;
+
+namespace alignlib
+{
+
+/** seeds are looked up directly, if they are encoded with at most this number of bits */
+#define MAX_DIRECT_BITS 20
+
+//------------------------------------------------------------------------------------
+HSequenceIndex makeSequenceIndex(
+		const AlignandumVector & sequences,
+		int ktuple )
+{
+	if (ktuple < 1)
+		THROW( "invalid tuple size " + toString( ktuple ) );
+	return HSequenceIndex( new ImplSequenceIndex( sequences, std::string( ktuple, '1' ) ) );
+}
+
+//------------------------------------------------------------------------------------
+HSequenceIndex makeSequenceIndex(
+		const AlignandumVector & sequences,
+		const std::string & seed )
+{
+	return HSequenceIndex( new ImplSequenceIndex( sequences, seed ) );
+}
+
+//------------------------------------------------------------------------------------
+HSequenceIndex loadSequenceIndex( std::istream & input )
+{
+	MagicNumberType magic_number;
+
+	input.read( (char*)&magic_number, sizeof(MagicNumberType) );
+
+	if (input.fail() || magic_number != MNImplSequenceIndex)
+		throw AlignlibException( "unknown object found in stream" );
+
+	ImplSequenceIndex * result = new ImplSequenceIndex();
+	HSequenceIndex index( result );
+	result->load( input );
+	return index;
+}
+
+//------------------------------------------------------------------------------------
+/** write a vector to stream */
+template<class T>
+void writeVector( std::ostream & output, const std::vector<T> & data )
+{
+	size_t size = data.size();
+	output.write( (char*)&size, sizeof(size_t) );
+	if (size > 0)
+		output.write( (char*)&data[0], sizeof(T) * size );
+}
+
+/** read a vector from stream */
+template<class T>
+void readVector( std::istream & input, std::vector<T> & data )
+{
+	size_t size = 0;
+	input.read( (char*)&size, sizeof(size_t) );
+	if (input.fail())
+		throw AlignlibException( "incomplete SequenceIndex object in stream.");
+	data.resize( size );
+	if (size > 0)
+		input.read( (char*)&data[0], sizeof(T) * size );
+}
+
+//------------------------------------------------------------------------------------
+ImplSequenceIndex::ImplSequenceIndex() :
+	SequenceIndex(), ImplAlignlibBase(), mBits( 0 )
+{
+}
+
+//------------------------------------------------------------------------------------
+ImplSequenceIndex::ImplSequenceIndex(
+		const AlignandumVector & sequences,
+		const std::string & seed ) :
+	SequenceIndex(), ImplAlignlibBase(), mBits( 0 )
+{
+	debug_func_cerr(5);
+
+	setSeed( seed );
+
+	if (sequences.size() > std::numeric_limits<unsigned int>::max())
+		THROW( "too many sequences: " + toString( sequences.size() ) );
+
+	mLengths.resize( sequences.size() );
+	for (size_t x = 0; x < sequences.size(); ++x)
+		mLengths[x] = sequences[x]->getLength();
+
+	std::vector<Residue> residues;
+	std::vector<Key> keys;
+	std::vector<bool> valid;
+
+	// collect seeds present in the collection, if there are
+	// too many possible seeds
+	if (mBits * (int)mSeedOffsets.size() > MAX_DIRECT_BITS)
+	{
+		for (size_t x = 0; x < sequences.size(); ++x)
+		{
+			encode( *sequences[x], residues, keys, valid );
+			for (size_t y = 0; y < keys.size(); ++y)
+				if (valid[y])
+					mKeys.push_back( keys[y] );
+		}
+		std::sort( mKeys.begin(), mKeys.end() );
+		mKeys.erase( std::unique( mKeys.begin(), mKeys.end() ), mKeys.end() );
+		mOffsets.assign( mKeys.size() + 1, 0 );
+	}
+	else
+		mOffsets.assign( ((size_t)1 << (mBits * mSeedOffsets.size())) + 1, 0 );
+
+	// count seeds
+	for (size_t x = 0; x < sequences.size(); ++x)
+	{
+		encode( *sequences[x], residues, keys, valid );
+		for (size_t y = 0; y < keys.size(); ++y)
+			if (valid[y])
+				++mOffsets[getSlot( keys[y] ) + 1];
+	}
+	std::partial_sum( mOffsets.begin(), mOffsets.end(), mOffsets.begin() );
+
+	// fill positions, sorted by sequence and position for each seed
+	mTargets.resize( mOffsets.back() );
+	mPositions.resize( mOffsets.back() );
+	std::vector<size_t> next( mOffsets.begin(), mOffsets.end() - 1 );
+	for (size_t x = 0; x < sequences.size(); ++x)
+	{
+		encode( *sequences[x], residues, keys, valid );
+		for (size_t y = 0; y < keys.size(); ++y)
+			if (valid[y])
+			{
+				size_t & n = next[getSlot( keys[y] )];
+				mTargets[n] = x;
+				mPositions[n] = y;
+				++n;
+			}
+	}
+
+	debug_cerr( 5, "indexed " << mTargets.size() << " seeds in " << sequences.size() << " sequences" );
+}
+
+//------------------------------------------------------------------------------------
+ImplSequenceIndex::~ImplSequenceIndex ()
+{
+	debug_func_cerr(5);
+}
+
+//------------------------------------------------------------------------------------
+ImplSequenceIndex::ImplSequenceIndex(const ImplSequenceIndex & src) :
+	SequenceIndex( src ), ImplAlignlibBase( src ),
+	mSeed( src.mSeed ), mSeedOffsets( src.mSeedOffsets ),
+	mAlphabet( src.mAlphabet ), mBits( src.mBits ),
+	mLengths( src.mLengths ), mKeys( src.mKeys ), mOffsets( src.mOffsets ),
+	mTargets( src.mTargets ), mPositions( src.mPositions )
+{
+	debug_func_cerr(5);
+}
+
+IMPLEMENT_CLONE( HSequenceIndex, ImplSequenceIndex );
+
+//------------------------------------------------------------------------------------
+size_t ImplSequenceIndex::getNumSequences() const
+{
+	return mLengths.size();
+}
+
+//------------------------------------------------------------------------------------
+std::string ImplSequenceIndex::getSeed() const
+{
+	return mSeed;
+}
+
+//------------------------------------------------------------------------------------
+void ImplSequenceIndex::setSeed( const std::string & seed )
+{
+	debug_func_cerr(5);
+
+	if (seed.empty() || seed[0] != '1' || seed[seed.size() - 1] != '1' ||
+			seed.find_first_not_of( "01" ) != std::string::npos)
+		THROW( "invalid seed pattern '" + seed + "'" );
+
+	mSeed = seed;
+	mSeedOffsets.clear();
+	for (size_t x = 0; x < mSeed.size(); ++x)
+		if (mSeed[x] == '1')
+			mSeedOffsets.push_back( x );
+
+	const HEncoder encoder( getToolkit()->getEncoder() );
+	mAlphabet = encoder->getAlphabet();
+
+	mBits = 1;
+	while ( (1 << mBits) < encoder->getAlphabetSize() )
+		++mBits;
+
+	if (mBits * mSeedOffsets.size() > 8 * sizeof(Key))
+		THROW( "seed '" + mSeed + "' is too long for " + toString( mBits ) + " bits per residue" );
+}
+
+//------------------------------------------------------------------------------------
+void ImplSequenceIndex::encode(
+		const Alignandum & src,
+		std::vector<Residue> & residues,
+		std::vector<Key> & keys,
+		std::vector<bool> & valid ) const
+{
+	const HEncoder encoder( getToolkit()->getEncoder() );
+	const Residue mask_code = encoder->getMaskCode();
+	const int alphabet_size = encoder->getAlphabetSize();
+
+	const Position length = src.getLength();
+	residues.resize( length );
+	for (Position x = 0; x < length; ++x)
+		residues[x] = src.asResidue( x );
+
+	const Position span = mSeed.size();
+	const Position nseeds = std::max( 0, length - span + 1 );
+	keys.assign( nseeds, 0 );
+	valid.assign( nseeds, true );
+
+	// masked residues invalidate all seeds covering them
+	for (Position x = 0; x < length; ++x)
+		if (residues[x] == mask_code || residues[x] >= alphabet_size)
+			for (size_t o = 0; o < mSeedOffsets.size(); ++o)
+			{
+				Position start = x - mSeedOffsets[o];
+				if (start >= 0 && start < nseeds)
+					valid[start] = false;
+			}
+
+	for (Position x = 0; x < nseeds; ++x)
+	{
+		Key key = 0;
+		for (size_t o = 0; o < mSeedOffsets.size(); ++o)
+			key = (key << mBits) | residues[x + mSeedOffsets[o]];
+		keys[x] = key;
+	}
+}
+
+//------------------------------------------------------------------------------------
+long ImplSequenceIndex::getSlot( Key key ) const
+{
+	if (mKeys.empty())
+		return (key + 1 < mOffsets.size()) ? (long)key : NO_POS;
+
+	std::vector<Key>::const_iterator it( std::lower_bound( mKeys.begin(), mKeys.end(), key ) );
+	if (it == mKeys.end() || *it != key)
+		return NO_POS;
+	return it - mKeys.begin();
+}
+
+//------------------------------------------------------------------------------------
+SeedCandidates ImplSequenceIndex::search(
+		const HAlignandum & query,
+		unsigned int min_seeds,
+		size_t max_candidates ) const
+{
+	debug_func_cerr(5);
+
+	std::vector<Residue> residues;
+	std::vector<Key> keys;
+	std::vector<bool> valid;
+	encode( *query, residues, keys, valid );
+
+	// collect seeds shared with targets
+	std::vector<Hit> hits;
+	for (Position x = 0; x < (Position)keys.size(); ++x)
+	{
+		if (!valid[x])
+			continue;
+		long slot = getSlot( keys[x] );
+		if (slot == NO_POS)
+			continue;
+		for (size_t y = mOffsets[slot]; y < mOffsets[slot + 1]; ++y)
+		{
+			Hit hit;
+			hit.mTarget = mTargets[y];
+			hit.mDiagonal = (Diagonal)mPositions[y] - x;
+			hit.mRow = x;
+			hits.push_back( hit );
+		}
+	}
+	std::sort( hits.begin(), hits.end() );
+
+	// summarize seeds by target
+	SeedCandidates candidates;
+	std::vector<size_t> first_hit;
+	for (size_t x = 0; x < hits.size(); )
+	{
+		size_t end = x;
+		while (end < hits.size() && hits[end].mTarget == hits[x].mTarget)
+			++end;
+
+		if (end - x >= min_seeds)
+		{
+			SeedCandidate candidate;
+			candidate.mIndex = hits[x].mTarget;
+			candidate.mNumSeeds = end - x;
+			candidate.mDiagonalFrom = hits[x].mDiagonal;
+			candidate.mDiagonalTo = hits[end - 1].mDiagonal;
+
+			size_t best = 0;
+			for (size_t y = x; y < end; )
+			{
+				size_t d = y;
+				while (d < end && hits[d].mDiagonal == hits[y].mDiagonal)
+					++d;
+				if (d - y > best)
+				{
+					best = d - y;
+					candidate.mBestDiagonal = hits[y].mDiagonal;
+				}
+				y = d;
+			}
+			candidates.push_back( candidate );
+			first_hit.push_back( x );
+		}
+		x = end;
+	}
+
+	// sort by number of seeds, stable to keep targets sorted by index
+	std::vector< std::pair<long, size_t> > order( candidates.size() );
+	for (size_t x = 0; x < candidates.size(); ++x)
+		order[x] = std::make_pair( -(long)candidates[x].mNumSeeds, x );
+	std::sort( order.begin(), order.end() );
+	if (max_candidates > 0 && order.size() > max_candidates)
+		order.resize( max_candidates );
+
+	// build residue pairs of seeds
+	const HSubstitutionMatrix matrix( getToolkit()->getSubstitutionMatrix() );
+	SeedCandidates result( order.size() );
+	std::vector<Position> rows;
+	for (size_t x = 0; x < order.size(); ++x)
+	{
+		SeedCandidate & candidate = result[x];
+		candidate = candidates[order[x].second];
+		candidate.mSeeds = makeAlignmentMatrixRow();
+
+		size_t end = first_hit[order[x].second] + candidate.mNumSeeds;
+		for (size_t y = first_hit[order[x].second]; y < end; )
+		{
+			const Diagonal diagonal = hits[y].mDiagonal;
+			rows.clear();
+			for (; y < end && hits[y].mDiagonal == diagonal; ++y)
+				for (size_t o = 0; o < mSeedOffsets.size(); ++o)
+					rows.push_back( hits[y].mRow + mSeedOffsets[o] );
+
+			std::sort( rows.begin(), rows.end() );
+			rows.erase( std::unique( rows.begin(), rows.end() ), rows.end() );
+
+			for (size_t r = 0; r < rows.size(); ++r)
+				candidate.mSeeds->addPair(
+						ResiduePair( rows[r], rows[r] + diagonal,
+								matrix->getValue( residues[rows[r]], residues[rows[r]] ) ) );
+		}
+	}
+
+	debug_cerr( 5, "found " << hits.size() << " seeds in " << candidates.size() << " targets" );
+
+	return result;
+}
+
+//------------------------------------------------------------------------------------
+void ImplSequenceIndex::save( std::ostream & output ) const
+{
+	debug_func_cerr(5);
+
+	MagicNumberType type = MNImplSequenceIndex;
+	output.write( (char*)&type, sizeof(MagicNumberType) );
+
+	writeVector( output, std::vector<char>( mSeed.begin(), mSeed.end() ) );
+	writeVector( output, std::vector<char>( mAlphabet.begin(), mAlphabet.end() ) );
+	output.write( (char*)&mBits, sizeof(int) );
+	writeVector( output, mLengths );
+	writeVector( output, mKeys );
+	writeVector( output, mOffsets );
+	writeVector( output, mTargets );
+	writeVector( output, mPositions );
+}
+
+//------------------------------------------------------------------------------------
+void ImplSequenceIndex::load( std::istream & input )
+{
+	debug_func_cerr(5);
+
+	std::vector<char> seed, alphabet;
+	int bits = 0;
+
+	readVector( input, seed );
+	readVector( input, alphabet );
+	input.read( (char*)&bits, sizeof(int) );
+	readVector( input, mLengths );
+	readVector( input, mKeys );
+	readVector( input, mOffsets );
+	readVector( input, mTargets );
+	readVector( input, mPositions );
+
+	if (input.fail())
+		throw AlignlibException( "incomplete SequenceIndex object in stream.");
+
+	setSeed( std::string( seed.begin(), seed.end() ) );
+
+	if (mAlphabet != std::string( alphabet.begin(), alphabet.end() ) || mBits != bits)
+		THROW( "index was built with a different alphabet: " + std::string( alphabet.begin(), alphabet.end() ) );
+}
+
+} // namespace alignlib
@@ -0,0 +1,159 @@
+/*
+  alignlib - a library for aligning protein sequences
+
+  $Id$
+
+  Copyright (C) 2026 Andreas Heger
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+*/
+
+#if HAVE_CONFIG_H
+#include <config.h>
+#endif
+
+#ifndef IMPL_SEQUENCE_INDEX_H
+#define IMPL_SEQUENCE_INDEX_H 1
+
+#include <vector>
+#include <string>
+#include "alignlib_fwd.h"
+#include "SequenceIndex.h"
+#include "ImplAlignlibBase.h"
+
+namespace alignlib
+{
+
+/**
+   @short inverted index of seeds in a collection of sequences.
+
+   Seeds are encoded from the residue codes of the @ref Encoder
+   of the toolkit, using as many bits per residue as the alphabet
+   needs. Seeds containing masked residues are not indexed.
+
+   Positions of seeds are stored in compressed sparse row layout:
+   offsets for each seed into flat arrays of sequence indices and
+   positions. If the number of possible seeds is small, offsets
+   are kept for all seeds. Otherwise, only seeds present in the
+   collection are kept and looked up by binary search.
+
+   @author Andreas Heger
+   @version $Id$
+*/
+
+class ImplSequenceIndex : public SequenceIndex, public ImplAlignlibBase
+{
+  /* class member functions-------------------------------------------------------------- */
+ public:
+    /* constructors and desctructors------------------------------------------------------- */
+    /** empty constructor */
+    ImplSequenceIndex();
+
+    /** build index of seeds in sequences */
+    ImplSequenceIndex( const AlignandumVector & sequences, const std::string & seed );
+
+    /** destructor */
+    virtual ~ImplSequenceIndex ();
+
+    /** copy constructor */
+    ImplSequenceIndex( const ImplSequenceIndex & src);
+
+    DEFINE_CLONE( HSequenceIndex );
+
+    /** return the number of indexed sequences */
+    virtual size_t getNumSequences() const;
+
+    /** return the seed pattern */
+    virtual std::string getSeed() const;
+
+    /** search the index with a query */
+    virtual SeedCandidates search(
+    		const HAlignandum & query,
+    		unsigned int min_seeds = 1,
+    		size_t max_candidates = 0 ) const;
+
+	/** save index to stream */
+	virtual void save( std::ostream & output ) const;
+
+	/** load index from stream */
+	virtual void load( std::istream & input );
+
+ protected:
+
+    /** type of an encoded seed */
+    typedef unsigned long long Key;
+
+    /** a seed shared between query and target */
+    struct Hit
+    {
+    	unsigned int mTarget;
+    	Diagonal mDiagonal;
+    	Position mRow;
+    	bool operator<( const Hit & other ) const
+    	{
+    		if (mTarget != other.mTarget) return mTarget < other.mTarget;
+    		if (mDiagonal != other.mDiagonal) return mDiagonal < other.mDiagonal;
+    		return mRow < other.mRow;
+    	}
+    };
+
+    /** setup seed pattern and encoding */
+    void setSeed( const std::string & seed );
+
+    /** encode the seeds in src.
+     *
+     * residues are the residues in src.
+     * keys[x] is the seed starting at position x.
+     * valid[x] is false, if the seed can not be encoded.
+     */
+    void encode( const Alignandum & src,
+    		std::vector<Residue> & residues,
+    		std::vector<Key> & keys,
+    		std::vector<bool> & valid ) const;
+
+    /** return index of key in offsets or NO_POS */
+    long getSlot( Key key ) const;
+
+    /** seed pattern */
+    std::string mSeed;
+
+    /** offsets of positions in seed that need to match */
+    std::vector<Position> mSeedOffsets;
+
+    /** alphabet of the encoder used for building the index */
+    std::string mAlphabet;
+
+    /** bits per residue */
+    int mBits;
+
+    /** lengths of indexed sequences */
+    std::vector<Position> mLengths;
+
+    /** seeds present in the collection, empty if seeds are looked up directly */
+    std::vector<Key> mKeys;
+
+    /** offsets into mTargets and mPositions for each seed */
+    std::vector<size_t> mOffsets;
+
+    /** sequence of each seed occurence */
+    std::vector<unsigned int> mTargets;
+
+    /** position of each seed occurence */
+    std::vector<Position> mPositions;
+};
+
+}
+
+#endif /* IMPL_SEQUENCE_INDEX_H */
@@ -21,12 +21,17 @@
 */
 
 #include <iostream>
+#include <algorithm>
+#include <vector>
 #include "alignlib_fwd.h"
 #include "alignlib_interfaces.h"
 #include "alignlib_fwd.h"
 #include "AlignlibException.h"
 #include "AlignlibDebug.h"
+#include "AlignlibThreads.h"
 #include "ImplWeightor.h"
+#include "EncodedMultipleAlignment.h"
+#include "HelpersMultipleAlignment.h"
 
 using namespace std;
 
@@ -34,21 +39,136 @@ namespace alignlib
 {
 
 /** factory functions */
-HWeightor makeWeightor()
+HWeightor makeWeightor( unsigned int num_threads )
 {
-	return HWeightor(new ImplWeightor());
+	return HWeightor(new ImplWeightor( num_threads ));
 }
 
 #define MIN_WEIGHT 0.0001
 
+/** number of interleaved histograms per column */
+#define NHISTOGRAMS 4
+
+//--------------------------------------------------------------------------------------------------------------------------------
+/** accumulate counts for the columns from to to.
+ *
+ * Each column is counted into NHISTOGRAMS histograms that are summed at the end.
+ * Consecutive sequences thus update different histograms and do not have to wait
+ * for each other if they share a residue. The last entry of each histogram
+ * collects gaps.
+ */
+class CountWorker
+{
+public:
+	CountWorker(
+			WeightedCountMatrix & counts,
+			const ResidueMatrix & codes,
+			const SequenceWeights & weights ) :
+		mCounts( &counts ), mCodes( &codes ), mWeights( &weights ), mUnitWeights( true )
+		{
+			for (size_t x = 0; x < weights.size(); ++x)
+				if (weights[x] != 1)
+				{
+					mUnitWeights = false;
+					break;
+				}
+		}
+
+	void operator()( Position from, Position to ) const
+	{
+		if (mUnitWeights)
+			countUnit( from, to );
+		else
+			countWeighted( from, to );
+	}
+
+private:
+
+	/** count residues. If all weights are 1, the counts are exact integers */
+	void countUnit( Position from, Position to ) const
+	{
+		const int nsequences = mCodes->getNumCols();
+		const int width = mCounts->getNumCols();
+		const int stride = width + 1;
+		const int nunrolled = nsequences - nsequences % NHISTOGRAMS;
+
+		std::vector<unsigned int> histograms( NHISTOGRAMS * stride );
+		unsigned int * h0 = &histograms[0];
+		unsigned int * h1 = h0 + stride;
+		unsigned int * h2 = h1 + stride;
+		unsigned int * h3 = h2 + stride;
+
+		for (Position column = from; column < to; ++column)
+		{
+			std::fill( histograms.begin(), histograms.end(), 0 );
+			const Residue * codes = mCodes->getRow( column );
+			int s = 0;
+			for (; s < nunrolled; s += NHISTOGRAMS)
+			{
+				++h0[codes[s]];
+				++h1[codes[s+1]];
+				++h2[codes[s+2]];
+				++h3[codes[s+3]];
+			}
+			for (; s < nsequences; ++s)
+				++h0[codes[s]];
+
+			WeightedCount * row = mCounts->getRow( column );
+			for (int r = 0; r < width; ++r)
+				row[r] += (WeightedCount)(h0[r] + h1[r] + h2[r] + h3[r]);
+		}
+	}
+
+	/** count residues weighted by sequence weights */
+	void countWeighted( Position from, Position to ) const
+	{
+		const int nsequences = mCodes->getNumCols();
+		const int width = mCounts->getNumCols();
+		const int stride = width + 1;
+		const int nunrolled = nsequences - nsequences % NHISTOGRAMS;
+		const SequenceWeight * weights = &(*mWeights)[0];
+
+		std::vector<WeightedCount> histograms( NHISTOGRAMS * stride );
+		WeightedCount * h0 = &histograms[0];
+		WeightedCount * h1 = h0 + stride;
+		WeightedCount * h2 = h1 + stride;
+		WeightedCount * h3 = h2 + stride;
+
+		for (Position column = from; column < to; ++column)
+		{
+			std::fill( histograms.begin(), histograms.end(), 0 );
+			const Residue * codes = mCodes->getRow( column );
+			int s = 0;
+			for (; s < nunrolled; s += NHISTOGRAMS)
+			{
+				h0[codes[s]] += weights[s];
+				h1[codes[s+1]] += weights[s+1];
+				h2[codes[s+2]] += weights[s+2];
+				h3[codes[s+3]] += weights[s+3];
+			}
+			for (; s < nsequences; ++s)
+				h0[codes[s]] += weights[s];
+
+			WeightedCount * row = mCounts->getRow( column );
+			for (int r = 0; r < width; ++r)
+				row[r] += (h0[r] + h1[r]) + (h2[r] + h3[r]);
+		}
+	}
+
+	WeightedCountMatrix * mCounts;
+	const ResidueMatrix * mCodes;
+	const SequenceWeights * mWeights;
+	bool mUnitWeights;
+};
+
 //---------------------------------------------------------< constructors and destructors >--------------------------------------
-ImplWeightor::ImplWeightor() :
-	Weightor()
+ImplWeightor::ImplWeightor( unsigned int num_threads ) :
+	Weightor(), mNumThreads( num_threads )
 {
 }
 
 ImplWeightor::ImplWeightor (const ImplWeightor & src ) :
-	Weightor(src)
+	Weightor(src), mNumThreads( src.mNumThreads )
 	{
 }
 
@@ -103,9 +223,22 @@ void ImplWeightor::fillCounts(
 	if (src->getLength() != dest.getNumRows())
 		throw AlignlibException( "count matrix and multiple alignment have different size.");
 
-	int nsequences = src->getNumSequences();
+	fillCounts( dest, makeEncodedMultipleAlignment( src, translator, mNumThreads ) );
+}
 
-	HSequenceWeights weights( calculateWeights( src, translator) );
+//--------------------------------------------------------------------------------------------------------------------------------
+void ImplWeightor::fillCounts(
+		WeightedCountMatrix & dest,
+		const HEncodedMultipleAlignment & src ) const
+{
+	debug_func_cerr(5);
+
+	if (src->getWidth() != dest.getNumCols())
+		throw AlignlibException( "count matrix and alphabet have different size.");
+	if (src->getLength() != dest.getNumRows())
+		throw AlignlibException( "count matrix and multiple alignment have different size.");
+
+	HSequenceWeights weights( calculateWeights( *src ) );
 
 	debug_cerr_start( 5, "computed the following weights:");
 
@@ -115,33 +248,25 @@ void ImplWeightor::fillCounts(
 	debug_cerr_add( 5, std::endl );
 #endif
 
-	Position mali_length = src->getLength();
-	int mali_width = src->getNumSequences();
-
-	// calculate counts
-	Residue width = translator->getAlphabetSize();
+	accumulateCounts( dest, src->getColumns(), *weights );
+}
 
-	for (int nsequence = 0; nsequence < mali_width; nsequence++)
-	{
-		SequenceWeight weight = (*weights)[nsequence];
-		const std::string & seq = (*src)[nsequence];
-		for (int x = 0; x < mali_length; ++x)
-		{
-			Residue code = translator->encode( seq[x] );
-			// continue for out-of-range characters (gaps)
-			if (code >= width) continue;
+//--------------------------------------------------------------------------------------------------------------------------------
+void ImplWeightor::accumulateCounts(
+		WeightedCountMatrix & counts,
+		const ResidueMatrix & codes,
+		const SequenceWeights & weights ) const
+{
+	debug_func_cerr(5);
 
-			debug_cerr(5, "width=" << (int)width << " char=" << seq[x] << " code=" << (int)code << " weight=" << weight );
-			dest.setValue( x, code, dest.getValue( x, code) + weight );
-		}
-	}
+	runBlocks( codes.getNumRows(), mNumThreads, CountWorker( counts, codes, weights ) );
 }
 
+//--------------------------------------------------------------------------------------------------------------------------------
 HSequenceWeights ImplWeightor::calculateWeights(
-		const HMultipleAlignment & src,
-		const HEncoder & translator ) const
+		const EncodedMultipleAlignment & src ) const
 {
-	int nsequences = src->getNumSequences();
+	int nsequences = src.getNumSequences();
 
 	HSequenceWeights weights(new SequenceWeights(nsequences));
 
@@ -42,6 +42,10 @@ namespace alignlib
     This class provides some helper functions that are needed
     in the derived classes.
 
+    Counts are accumulated column by column from an
+    @ref EncodedMultipleAlignment. Blocks of columns are
+    processed by separate threads.
+
     @author Andreas Heger
     @version $Id: ImplWeightor.h,v 1.3 2004/03/19 18:23:41 aheger Exp $
 */
@@ -50,8 +54,11 @@ class ImplWeightor : public Weightor, public ImplAlignlibBase
  public:
     // constructors and desctructors
 
-    /** default constructor */
-    ImplWeightor();
+    /** default constructor
+     *
+     * @param num_threads number of threads to use. If 0, use one thread per processor.
+     */
+    ImplWeightor( unsigned int num_threads = 1 );
 
     /** copy constructor */
     ImplWeightor(const ImplWeightor &);
@@ -68,6 +75,10 @@ class ImplWeightor : public Weightor, public ImplAlignlibBase
     		const HMultipleAlignment & src,
     		const HEncoder & translator ) const;
 
+    /** fill a counts matrix from an encoded multiple alignment */
+    virtual void fillCounts(
+    		WeightedCountMatrix & counts,
+    		const HEncodedMultipleAlignment & src ) const;
 
  protected:
 
@@ -76,10 +87,23 @@ class ImplWeightor : public Weightor, public ImplAlignlibBase
     		int nsequences,
     		SequenceWeight value = 0) const;
 
+    /** add the weighted residue counts in each column of codes to counts.
+     *
+     * @param counts	@ref WeightedCountMatrix with one row per column of codes.
+     * @param codes		residue codes by column (see @ref EncodedMultipleAlignment::getColumns).
+     * @param weights	weight of each sequence.
+     */
+    void accumulateCounts(
+    		WeightedCountMatrix & counts,
+    		const ResidueMatrix & codes,
+    		const SequenceWeights & weights ) const;
+
     /** calculate weights per sequence */
     virtual HSequenceWeights calculateWeights(
-    		const HMultipleAlignment & src,
-    		const HEncoder & translator ) const;
+    		const EncodedMultipleAlignment & src ) const;
+
+    /** number of threads to use */
+    unsigned int mNumThreads;
 };
 
 
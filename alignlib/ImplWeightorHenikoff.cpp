@@ -21,6 +21,7 @@
  */
 
 #include <iostream>
+#include <vector>
 #include "alignlib_fwd.h"
 #include "alignlib_interfaces.h"
 #include "alignlib_fwd.h"
@@ -31,6 +32,7 @@
 #include "MultipleAlignment.h"
 #include "HelpersEncoder.h"
 #include "Encoder.h"
+#include "EncodedMultipleAlignment.h"
 
 using namespace std;
 
@@ -38,14 +40,18 @@ namespace alignlib
 {
 
 /** factory functions */
-HWeightor makeWeightorHenikoff( const bool rescale )
+HWeightor makeWeightorHenikoff(
+		const bool rescale,
+		unsigned int num_threads )
 {
-	return HWeightor(new ImplWeightorHenikoff( rescale));
+	return HWeightor(new ImplWeightorHenikoff( rescale, num_threads ));
 }
 
 //---------------------------------------------------------< constructors and destructors >--------------------------------------
-ImplWeightorHenikoff::ImplWeightorHenikoff ( const bool rescale )
-: ImplWeightor(), mRescale( rescale )
+ImplWeightorHenikoff::ImplWeightorHenikoff (
+		const bool rescale,
+		unsigned int num_threads )
+: ImplWeightor( num_threads ), mRescale( rescale )
 {
 }
 
@@ -63,70 +69,45 @@ IMPLEMENT_CLONE( HWeightor, ImplWeightorHenikoff );
 
 //--------------------------------------------------------------------------------------------------------------------------------
 HSequenceWeights ImplWeightorHenikoff::calculateWeights(
-			const HMultipleAlignment & src,
-			const HEncoder & translator ) const
+			const EncodedMultipleAlignment & src ) const
 {
 	debug_func_cerr(5);
 
-	//!! TODO: Right now I have to translate twice. This could be improved by making a temporary
-	// copy (at the expense of memory, though)
-
-	int width = translator->getAlphabetSize();
-
-	int nsequences = src->getNumSequences();
-	Position length = src->getLength();
+	int width = src.getWidth();
+	int nsequences = src.getNumSequences();
+	Position length = src.getLength();
 
 	Position column;
-	int i, j;
+	int i;
 
 	//-----------------> calculate counts for each column and amino acid<----------------------
-	WeightedCount * counts = new WeightedCount[length * width];
-
-	for (j = 0; j < length; j++)
-	{
-		WeightedCount * ccolumn = &counts[j * width];
-		for ( i = 0; i < width; i++)
-			ccolumn[i] = 0;
-	}
-	Residue residue;
+	WeightedCountMatrix counts( length, width, 0 );
+	accumulateCounts( counts, src.getColumns(), SequenceWeights( nsequences, 1 ) );
 
-	for (i = 0; i < nsequences; i++)
-	{
-		const std::string & sequence = (*src)[i];
-		for (column = 0; column < length; column++)
-			if ((residue = translator->encode(sequence[column])) < width)
-				counts[column * width + residue]++;
-	}
-
-	//-----------------> calculate types per column <------------------------------------------
-	int * ntypes = new int[length];
+	//---------------> calculate sequence weights <------------------------------------------
+	// each sequence gets 1 / (count of residue * number of residue types) for each
+	// column. Gaps and masked characters (code width) are skipped.
+	HSequenceWeights weights( new SequenceWeights(nsequences, 0) );
+	SequenceWeights & w = *weights;
+	std::vector<SequenceWeight> contribution( width + 1 );
 
 	for (column = 0; column < length; column++)
 	{
-		WeightedCount * ccolumn = &counts[j * width];
-		ntypes[column] = 0;
+		const WeightedCount * ccolumn = counts.getRow( column );
+		int ntypes = 0;
 		for (i = 0; i < width; i++)
 			if (ccolumn[i] > 0)
-				ntypes[column]++;
-	}
-	//---------------> calculate sequence weights <------------------------------------------
-	HSequenceWeights weights( new SequenceWeights(nsequences) );
-	SequenceWeights & w = *weights;
-	for (i = 0; i < nsequences; i++)
-	{
-		w[i] = 0;
-		for (column = 0; column < length; column++)
-		{
-			const std::string & sequence = (*src)[i];			// sum up, but skip gaps and masked characters
-			if ( (residue = translator->encode(sequence[column])) < width)
-				w[i] += (SequenceWeight)(1.0 /
-						((double)counts[column * width + residue] * (double)ntypes[column]));
-		}
-	}
+				ntypes++;
+
+		for (i = 0; i < width; i++)
+			contribution[i] = (ccolumn[i] > 0) ?
+					(SequenceWeight)(1.0 / ((double)ccolumn[i] * (double)ntypes)) : 0;
+		contribution[width] = 0;
 
-	//---------------> clean up------------------------------------------------------------
-	delete [] counts;
-	delete [] ntypes;
+		const Residue * residues = src.getColumn( column );
+		for (i = 0; i < nsequences; i++)
+			w[i] += contribution[residues[i]];
+	}
 
 	//---------------> rescale weights, so that they sum to 1 <---------------------------
 	if (mRescale)
@@ -49,7 +49,9 @@ class ImplWeightorHenikoff : public ImplWeightor
     // constructors and desctructors
 
     /** default constructor */
-    ImplWeightorHenikoff( const bool rescale = false );
+    ImplWeightorHenikoff(
+    		const bool rescale = false,
+    		unsigned int num_threads = 1 );
 
     /** copy constructor */
     ImplWeightorHenikoff(const ImplWeightorHenikoff &);
@@ -64,8 +66,7 @@ class ImplWeightorHenikoff : public ImplWeightor
     /** return a vector of weights for a multiple alignment. The ordering in the result will be the same
 	as in the multiple alignment. Note, that the caller has to delete the weights. */
     virtual HSequenceWeights calculateWeights(
-    		const HMultipleAlignment & src,
-    		const HEncoder & translator ) const;
+    		const EncodedMultipleAlignment & src ) const;
 
     /** if true, weights are scaled towards the number of
     	sequences*/
@@ -204,6 +204,13 @@ public:
 	 */
 	virtual Position col_size( Position row = NO_POS ) const = 0;
 
+	/** return the number of cells within the iterator.
+	 *
+	 * For adaptive iterators used in an alignment, this is the number
+	 * of cells that have been computed.
+	 */
+	virtual size_t getNumCells() const = 0;
+
 };
 
 }
@@ -0,0 +1,148 @@
+/*
+  alignlib - a library for aligning protein sequences
+
+  $Id$
+
+  Copyright (C) 2026 Andreas Heger
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+*/
+
+#include <vector>
+#include <algorithm>
+#include <numeric>
+#include <utility>
+
+#include "alignlib_fwd.h"
+#include "AlignlibDebug.h"
+#include "AlignlibException.h"
+#include "Alignandum.h"
+#include "KmerIndex.h"
+
+using namespace std;
+
+namespace alignlib
+{
+
+/** tuples are looked up directly, if they are encoded with at most this number of bits */
+#define MAX_DIRECT_BITS 16
+
+//------------------------------------------------------------------------------------
+KmerIndex::KmerIndex( const Alignandum & src, int ktuple ) :
+	mKtuple( ktuple ), mBits( 1 ), mMaxResidue( 0 ), mMask( 0 )
+{
+	debug_func_cerr(5);
+
+	if (mKtuple < 1)
+		THROW( "invalid tuple size " + toString( mKtuple ) );
+
+	const Position length = src.getLength();
+
+	std::vector<Residue> residues( length );
+	for (Position x = 0; x < length; ++x)
+	{
+		residues[x] = src.asResidue( x );
+		mMaxResidue = std::max( mMaxResidue, residues[x] );
+	}
+
+	while ( (1 << mBits) <= mMaxResidue )
+		++mBits;
+
+	const int key_bits = mBits * mKtuple;
+	if (key_bits > (int)(8 * sizeof(Key)))
+		THROW( "tuple size " + toString( mKtuple ) + " is too large for " + toString( mBits ) + " bits per residue" );
+
+	mMask = (key_bits == (int)(8 * sizeof(Key))) ? ~(Key)0 : (((Key)1 << key_bits) - 1);
+
+	// encode tuples
+	const Position ntuples = std::max( 0, length - mKtuple + 1 );
+	std::vector<Key> keys( ntuples );
+	Key key = 0;
+	for (Position x = 0; x < length; ++x)
+	{
+		key = ((key << mBits) | residues[x]) & mMask;
+		if (x >= mKtuple - 1)
+			keys[x - mKtuple + 1] = key;
+	}
+
+	mPositions.resize( ntuples );
+
+	if (key_bits <= MAX_DIRECT_BITS)
+	{
+		// offsets for all possible tuples
+		mOffsets.assign( ((size_t)1 << key_bits) + 1, 0 );
+		for (Position x = 0; x < ntuples; ++x)
+			++mOffsets[keys[x] + 1];
+		std::partial_sum( mOffsets.begin(), mOffsets.end(), mOffsets.begin() );
+
+		std::vector<Position> next( mOffsets.begin(), mOffsets.end() - 1 );
+		for (Position x = 0; x < ntuples; ++x)
+			mPositions[next[keys[x]]++] = x;
+	}
+	else
+	{
+		// offsets for tuples present in the object
+		std::vector< std::pair<Key, Position> > tuples( ntuples );
+		for (Position x = 0; x < ntuples; ++x)
+			tuples[x] = std::make_pair( keys[x], x );
+		std::sort( tuples.begin(), tuples.end() );
+
+		for (Position x = 0; x < ntuples; ++x)
+		{
+			if (mKeys.empty() || mKeys.back() != tuples[x].first)
+			{
+				mKeys.push_back( tuples[x].first );
+				mOffsets.push_back( x );
+			}
+			mPositions[x] = tuples[x].second;
+		}
+		mOffsets.push_back( ntuples );
+	}
+
+	debug_cerr( 5, "indexed " << ntuples << " tuples of size " << mKtuple << " with " << mBits << " bits per residue" );
+}
+
+//------------------------------------------------------------------------------------
+KmerIndex::~KmerIndex()
+{
+}
+
+//------------------------------------------------------------------------------------
+void KmerIndex::find( Key key, const Position * & begin, const Position * & end ) const
+{
+	begin = end = NULL;
+	if (mPositions.empty())
+		return;
+
+	size_t index;
+	if (mKeys.empty())
+	{
+		if (key + 1 >= mOffsets.size())
+			return;
+		index = key;
+	}
+	else
+	{
+		std::vector<Key>::const_iterator it( std::lower_bound( mKeys.begin(), mKeys.end(), key ) );
+		if (it == mKeys.end() || *it != key)
+			return;
+		index = it - mKeys.begin();
+	}
+
+	begin = &mPositions[0] + mOffsets[index];
+	end = &mPositions[0] + mOffsets[index + 1];
+}
+
+}
@@ -0,0 +1,119 @@
+/*
+  alignlib - a library for aligning protein sequences
+
+  $Id$
+
+  Copyright (C) 2026 Andreas Heger
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+*/
+
+#if HAVE_CONFIG_H
+#include <config.h>
+#endif
+
+#ifndef KMER_INDEX_H
+#define KMER_INDEX_H 1
+
+#include <vector>
+#include <boost/shared_ptr.hpp>
+#include "alignlib_fwd.h"
+
+namespace alignlib
+{
+
+/** @short index of the positions of all k-tuples in an @ref Alignandum object.
+
+    Tuples are encoded from the residue codes of the object into
+    integers with a few bits per residue. The number of bits is
+    the smallest that can hold the largest residue code in the object,
+    for example 5 for protein sequences and 2 or 3 for nucleotide
+    sequences.
+
+    Positions are stored in compressed sparse row layout: an array
+    of offsets for each tuple and a flat array of positions sorted
+    by position within each tuple. If the number of possible tuples
+    is small, offsets are kept for all tuples and a tuple is found
+    by direct lookup. Otherwise, only tuples present in the object
+    are kept and looked up by binary search.
+
+    Positions are 0-based and refer to the positions used
+    by @ref Alignandum::asResidue.
+
+    @author Andreas Heger
+    @version $Id$
+*/
+class KmerIndex
+{
+ public:
+
+	/** type of an encoded tuple */
+	typedef unsigned long long Key;
+
+	/** build the index of tuples of length ktuple in src */
+	KmerIndex( const Alignandum & src, int ktuple );
+
+	/** destructor */
+	~KmerIndex();
+
+	/** return the tuple size */
+	int getKtuple() const { return mKtuple; }
+
+	/** return the number of bits per residue */
+	int getBits() const { return mBits; }
+
+	/** return the largest residue code in the index */
+	Residue getMaxResidue() const { return mMaxResidue; }
+
+	/** return the mask for a full tuple */
+	Key getMask() const { return mMask; }
+
+	/** get the positions of a tuple.
+	 *
+	 * @param key encoded tuple.
+	 * @param begin set to the first position.
+	 * @param end set to one past the last position.
+	 */
+	void find( Key key, const Position * & begin, const Position * & end ) const;
+
+ private:
+
+	/** the tuple size */
+	int mKtuple;
+
+	/** bits per residue */
+	int mBits;
+
+	/** largest residue in the indexed object */
+	Residue mMaxResidue;
+
+	/** mask for a full tuple */
+	Key mMask;
+
+	/** tuples present in the object, empty if tuples are looked up directly */
+	std::vector<Key> mKeys;
+
+	/** offsets into mPositions for each tuple */
+	std::vector<Position> mOffsets;
+
+	/** positions of tuples */
+	std::vector<Position> mPositions;
+};
+
+typedef boost::shared_ptr<KmerIndex> HKmerIndex;
+
+}
+
+#endif /* KMER_INDEX_H */
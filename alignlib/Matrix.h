@@ -61,14 +61,27 @@ public:
 		mCols = c;
 		mSize = mRows * mCols;
 		mMatrix = new T [mSize];
+		mOwnsData = true;
 		for (unsigned int i = 0; i < mSize; i++)
 			mMatrix[i] = default_value;
 	}
 
+	/** wrap existing data without copying.
+	 *
+	 * The matrix does not take ownership of data,
+	 * which needs to stay valid for the lifetime of
+	 * the matrix.
+	 */
+	Matrix (T * data, unsigned int r, unsigned int c) :
+		AlignlibBase(),
+		mMatrix(data), mRows(r), mCols(c), mSize(r * c), mOwnsData(false)
+	{
+	}
+
 	/** copy constructor.
 	 */
 	Matrix (const Matrix <T>& src) : ImplAlignlibBase(src),
-		mRows(src.mRows), mCols(src.mCols), mSize(src.mSize)
+		mRows(src.mRows), mCols(src.mCols), mSize(src.mSize), mOwnsData(true)
 		{
 		mMatrix  = new T [mSize];
 		memcpy( mMatrix, src.mMatrix, sizeof(T) * mSize );
@@ -76,7 +89,7 @@ public:
 
 	/** destructor
 	 */
-	~Matrix() { delete [] mMatrix; }
+	~Matrix() { if (mOwnsData) delete [] mMatrix; }
 
 	/** return a copy of this object */
 	HMatrix getClone() const { return HMatrix(new Matrix<T>(*this) ); }
@@ -128,6 +141,7 @@ public:
 		mSize=mRows*mCols;
 
 		mMatrix  = new T [mSize];
+		mOwnsData = true;
 		memcpy( mMatrix, src.mMatrix, sizeof( T) * mSize );
 
 		return (*this);
@@ -245,7 +259,8 @@ public:
 			memcpy( &mMatrix[r * mCols],
 					&old_matrix[map_new2old[r] * mCols],
 					sizeof(T) * mCols );
-		delete [] old_matrix;
+		if (mOwnsData) delete [] old_matrix;
+		mOwnsData = true;
 	}
 
 	/** permute rows in matrix.
@@ -276,7 +291,8 @@ public:
 			for (unsigned int r = 0; r < mRows; ++r)
 				setValue( r,c, old_matrix[ r * old_cols + m] );
 		}
-		delete [] old_matrix;
+		if (mOwnsData) delete [] old_matrix;
+		mOwnsData = true;
 	}
 
 private:
@@ -289,6 +305,8 @@ private:
 	unsigned int mCols;
 	/** size of matrix */
 	unsigned int mSize;
+	/** true, if mMatrix is deleted with the matrix */
+	bool mOwnsData;
 
 };
 
@@ -0,0 +1,86 @@
+/*
+  alignlib - a library for aligning protein sequences
+
+  $Id$
+
+  Copyright (C) 2026 Andreas Heger
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+*/
+
+#if HAVE_CONFIG_H
+#include <config.h>
+#endif
+
+#ifndef PROFILE_LIBRARY_H
+#define PROFILE_LIBRARY_H 1
+
+#include <iosfwd>
+#include "alignlib_fwd.h"
+#include "Macros.h"
+#include "AlignlibBase.h"
+
+namespace alignlib
+{
+
+/**
+   @short Protocol class for read-only collections of prepared profiles.
+
+   A ProfileLibrary gives access to profiles stored in a binary
+   library file written with @ref writeProfileLibrary. The counts,
+   frequencies and scores of each profile are used directly from the
+   file, so that profiles do not need to be parsed or prepared.
+
+   Profiles returned by @ref getProfile are read-only. Functions that
+   modify a profile, for example mask() or add(), throw an
+   @ref AlignlibException.
+
+   @author Andreas Heger
+   @version $Id$
+*/
+class ProfileLibrary : public virtual AlignlibBase
+{
+  /* class member functions-------------------------------------------------------------- */
+ public:
+    /* constructors and desctructors------------------------------------------------------- */
+
+    /** empty constructor */
+    ProfileLibrary();
+
+    /** destructor */
+    virtual ~ProfileLibrary ();
+
+    /** copy constructor */
+    ProfileLibrary( const ProfileLibrary & src);
+
+    DEFINE_ABSTRACT_CLONE( HProfileLibrary )
+
+    /** return the number of profiles in the library */
+    virtual size_t getNumProfiles() const = 0;
+
+    /** return the length of a profile without creating it */
+    virtual Position getProfileLength( size_t index ) const = 0;
+
+    /** return a profile.
+     *
+     * @param index	index of profile.
+     * @return a prepared, read-only profile.
+     */
+    virtual HAlignandum getProfile( size_t index ) const = 0;
+};
+
+}
+
+#endif /* PROFILE_LIBRARY_H */
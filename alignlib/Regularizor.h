@@ -74,6 +74,13 @@ class Regularizor : public virtual AlignlibBase
     		const WeightedCountMatrix & counts,
     		const HEncoder & translator ) const = 0;
 
+    /** return true, if the frequencies in a column depend only on
+     * the counts in the same column.
+     *
+     * Blocks of columns can then be regularized separately and in parallel.
+     */
+    virtual bool isColumnIndependent() const = 0;
+
 };
 
 }
@@ -75,6 +75,18 @@ namespace alignlib
     		  const HAlignandum & row,
     		  const HAlignandum & col) const = 0;
 
+      /** initialize this scorer for a new @ref Alignandum object col,
+       *  keeping the row.
+       *
+       * This is used to align one row against many cols without
+       * setting up the row again.
+       *
+       * @param col @ref Alignandum object to be aligned.
+       * @return false, if this scorer can not be used for col. Use
+       * getNew() in this case.
+       */
+      virtual bool setCol( const HAlignandum & col ) = 0;
+
       /** return score of matching row to col
        */
       virtual Score getScore(
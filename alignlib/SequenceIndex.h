@@ -0,0 +1,139 @@
+/*
+  alignlib - a library for aligning protein sequences
+
+  $Id$
+
+  Copyright (C) 2026 Andreas Heger
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+*/
+
+#if HAVE_CONFIG_H
+#include <config.h>
+#endif
+
+#ifndef SEQUENCE_INDEX_H
+#define SEQUENCE_INDEX_H 1
+
+#include <iosfwd>
+#include <string>
+#include <vector>
+#include "alignlib_fwd.h"
+#include "Macros.h"
+#include "AlignlibBase.h"
+
+namespace alignlib
+{
+
+/** a target returned by @ref SequenceIndex::search.
+ */
+struct SeedCandidate
+{
+	SeedCandidate() :
+		mIndex( 0 ), mNumSeeds( 0 ),
+		mBestDiagonal( 0 ), mDiagonalFrom( 0 ), mDiagonalTo( 0 ) {}
+
+	/** index of the target in the indexed collection */
+	size_t mIndex;
+
+	/** number of seeds shared between query and target */
+	unsigned int mNumSeeds;
+
+	/** diagonal (col - row) with most seeds */
+	Diagonal mBestDiagonal;
+
+	/** smallest diagonal with a seed */
+	Diagonal mDiagonalFrom;
+
+	/** largest diagonal with a seed */
+	Diagonal mDiagonalTo;
+
+	/** residue pairs in seeds between query (row) and target (col).
+	 *
+	 * The pairs are sorted by row and column.
+	 */
+	HAlignment mSeeds;
+};
+
+typedef std::vector<SeedCandidate> SeedCandidates;
+
+/**
+   @short Protocol class for indices of tuples in a collection of sequences.
+
+   A SequenceIndex stores the positions of all tuples (seeds) in a
+   collection of @ref Alignandum objects. Searching the index with a
+   query returns the targets sharing seeds with the query, together with
+   the diagonals and residue pairs of the seeds.
+
+   Seeds are described by a pattern such as "11011". Residues at positions
+   marked with 1 need to be identical, others are ignored.
+
+   The candidates can be aligned by seed-and-extend. For example, the seeds
+   can be used as dots with @ref makeAlignatorPrebuilt and
+   @ref makeAlignatorDots, or the diagonals can restrict dynamic
+   programming with @ref makeIterator2DBanded.
+
+   Indices can be saved to and loaded from a stream, so that a database
+   needs to be indexed only once.
+
+   @author Andreas Heger
+   @version $Id$
+*/
+
+class SequenceIndex : public virtual AlignlibBase
+{
+  /* class member functions-------------------------------------------------------------- */
+ public:
+    /* constructors and desctructors------------------------------------------------------- */
+    /** empty constructor */
+    SequenceIndex();
+
+    /** destructor */
+    virtual ~SequenceIndex ();
+
+    /** copy constructor */
+    SequenceIndex( const SequenceIndex & src);
+
+    DEFINE_ABSTRACT_CLONE( HSequenceIndex )
+
+    /** return the number of indexed sequences */
+    virtual size_t getNumSequences() const = 0;
+
+    /** return the seed pattern */
+    virtual std::string getSeed() const = 0;
+
+    /** search the index with a query.
+     *
+     * @param query	@ref Alignandum object to search with.
+     * @param min_seeds	minimum number of seeds a target needs to share with the query.
+     * @param max_candidates maximum number of candidates to return. If 0,
+     * 		all candidates are returned.
+     *
+     * @return candidates sorted by decreasing number of seeds.
+     * Candidates with the same number of seeds are sorted by index.
+     */
+    virtual SeedCandidates search(
+    		const HAlignandum & query,
+    		unsigned int min_seeds = 1,
+    		size_t max_candidates = 0 ) const = 0;
+
+	/** save index to stream.
+	 */
+	virtual void save( std::ostream & output ) const = 0;
+};
+
+}
+
+#endif /* SEQUENCE_INDEX_H */
@@ -75,6 +75,15 @@ class Weightor : public virtual AlignlibBase
     		const HMultipleAlignment & src,
     		const HEncoder & translator ) const = 0;
 
+    /** fill a counts matrix from an encoded multiple alignment
+     *
+     * @param counts 	@ref WeightedCountMatrix to fill.
+     * @param src		@ref EncodedMultipleAlignment object to compute weights from.
+     */
+    virtual void fillCounts(
+    		WeightedCountMatrix & counts,
+    		const HEncodedMultipleAlignment & src ) const = 0;
+
 };
 
 }
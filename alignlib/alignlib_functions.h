@@ -49,6 +49,8 @@
 #include "HelpersTreetor.h"
 #include "HelpersDistanceMatrix.h"
 #include "HelpersTree.h"
+#include "HelpersSequenceIndex.h"
+#include "HelpersProfileLibrary.h"
 
 #include "AlignmentFormat.h"
 #include "MultipleAlignmentFormat.h"
@@ -51,6 +51,9 @@ namespace alignlib
 	class MultipleAlignment;
 	typedef boost::shared_ptr<MultipleAlignment>HMultipleAlignment;
 
+	class EncodedMultipleAlignment;
+	typedef boost::shared_ptr<EncodedMultipleAlignment>HEncodedMultipleAlignment;
+
 	class MultAlignment;
 	typedef boost::shared_ptr<MultAlignment>HMultAlignment;
 
@@ -99,6 +102,12 @@ namespace alignlib
 	class Iterator2D;
 	typedef boost::shared_ptr<Iterator2D>HIterator2D;
 
+	class SequenceIndex;
+	typedef boost::shared_ptr<SequenceIndex>HSequenceIndex;
+
+	class ProfileLibrary;
+	typedef boost::shared_ptr<ProfileLibrary>HProfileLibrary;
+
 	/** various matrix definitions */
 	template<class T> class Matrix;
 
@@ -120,6 +129,9 @@ namespace alignlib
     typedef Matrix<Score> SubstitutionMatrix;
     typedef boost::shared_ptr<SubstitutionMatrix>HSubstitutionMatrix;
 
+    typedef Matrix<Residue> ResidueMatrix;
+    typedef boost::shared_ptr<ResidueMatrix>HResidueMatrix;
+
     /** A vector of Residues */
     typedef std::vector< Residue > ResidueVector;
     typedef boost::shared_ptr<ResidueVector>HResidueVector;
@@ -33,6 +33,7 @@
 #include "AlignmentIterator.h"
 #include "DistanceMatrix.h"
 #include "Distor.h"
+#include "EncodedMultipleAlignment.h"
 #include "Encoder.h"
 #include "Fragmentor.h"
 #include "Iterator2D.h"
@@ -43,9 +44,11 @@
 #include "MultipleAlignator.h"
 #include "Regularizor.h"
 #include "Profile.h"
+#include "ProfileLibrary.h"
 #include "Scorer.h"
 #include "Segment.h"
 #include "Sequence.h"
+#include "SequenceIndex.h"
 #include "Treetor.h"
 #include "Tree.h"
 #include "Weightor.h"
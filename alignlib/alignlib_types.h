@@ -105,7 +105,8 @@ enum MagicNumberType
 	MNNoType,
 	MNImplAlignandum,
 	MNImplSequence,
-	MNImplProfile
+	MNImplProfile,
+	MNImplSequenceIndex
 };
 
 // Known alphabets
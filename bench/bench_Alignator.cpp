@@ -47,6 +47,9 @@
 #include "HelpersRegularizor.h"
 #include "HelpersLogOddor.h"
 #include "HelpersWeightor.h"
+#include "HelpersScorer.h"
+#include "HelpersToolkit.h"
+#include "Toolkit.h"
 
 using namespace std;
 using namespace alignlib;
@@ -89,6 +92,43 @@ void InitProfProf(
 	col = makeProfile( "AAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAA", 3 );
 }
 
+/** two long sequences sharing a segment of 100 residues */
+void InitLongSeqSeq(
+		 HAlignator & a,
+		 HAlignandum & row,
+		 HAlignandum & col,
+		 HAlignment & result)
+{
+	result = makeAlignmentVector();
+	const std::string alphabet( "ACDEFGHIKLMNPQRSTVWY" );
+	std::string s1, s2;
+	srand( 1 );
+	for (int x = 0; x < 1000; ++x) s1 += alphabet[rand() % alphabet.size()];
+	for (int x = 0; x < 1000; ++x) s2 += alphabet[rand() % alphabet.size()];
+	s2.replace( 500, 100, s1.substr( 300, 100 ) );
+	row = makeSequence( s1 );
+	col = makeSequence( s2 );
+}
+
+/** two low-complexity sequences. The identity alignator
+ * puts a dot into a quarter of all cells, giving a dotplot
+ * of about 22500 dots.
+ */
+void InitDotplot(
+		 HAlignator & a,
+		 HAlignandum & row,
+		 HAlignandum & col,
+		 HAlignment & result)
+{
+	result = makeAlignmentVector();
+	const std::string alphabet( "ACDE" );
+	std::string s1, s2;
+	srand( 1 );
+	for (int x = 0; x < 300; ++x) s1 += alphabet[rand() % alphabet.size()];
+	for (int x = 0; x < 300; ++x) s2 += alphabet[rand() % alphabet.size()];
+	row = makeSequence( s1 );
+	col = makeSequence( s2 );
+}
 
 //-------------------------------------> Initialisation functions <-----------------------------------
 
@@ -197,10 +237,71 @@ void BenchmarkAll(
     // benchmark prof vs profile
     cout << Benchmark( alignator, iterations, &BenchmarkAlignment, NULL, &ClearAlignment, &InitProfProf, &ClearAll ) << "\t";
 
+    // benchmark long seq vs long seq
+    cout << Benchmark( alignator, iterations, &BenchmarkAlignment, NULL, &ClearAlignment, &InitLongSeqSeq, &ClearAll ) << "\t";
+
     cout << endl;
 
 }
 
+/** callback for alignMany keeping the best score */
+class BestScore : public AlignatorCallback
+{
+public:
+	BestScore() : mBest( 0 ) {}
+	virtual bool operator()( size_t index, const HAlignandum & target, const HAlignment & result )
+	{
+		if (result->getScore() > mBest) mBest = result->getScore();
+		return true;
+	}
+	Score mBest;
+};
+
+/** align a query against many targets, first with repeated calls
+ * to align, then with alignMany and finally with a threaded search.
+ */
+void BenchmarkBatch(
+		long iterations,
+		HAlignator & alignator )
+{
+	const char * alphabet = "ACDEFGHIKLMNPQRSTVWY";
+	srand( 1 );
+
+	std::string query_sequence;
+	for (int x = 0; x < 300; ++x) query_sequence += alphabet[ rand() % 20 ];
+	HAlignandum query = makeSequence( query_sequence );
+
+	AlignandumVector targets;
+	for (long t = 0; t < iterations; ++t)
+	{
+		std::string s;
+		int length = 100 + rand() % 300;
+		for (int x = 0; x < length; ++x) s += alphabet[ rand() % 20 ];
+		targets.push_back( makeSequence( s ) );
+	}
+
+	struct timeval start_time, finish_time;
+	HAlignment result = makeAlignmentVector();
+
+	gettimeofday(&start_time,NULL);
+	for (size_t t = 0; t < targets.size(); ++t)
+		alignator->align( result, query, targets[t] );
+	gettimeofday(&finish_time,NULL);
+	cout << tval(&start_time,&finish_time) << "\t";
+
+	BestScore callback;
+	gettimeofday(&start_time,NULL);
+	alignator->alignMany( result, query, targets, callback );
+	gettimeofday(&finish_time,NULL);
+	cout << tval(&start_time,&finish_time) << "\t";
+
+	// search with one thread per processor
+	gettimeofday(&start_time,NULL);
+	searchDatabase( alignator, query, targets, 10, 0 );
+	gettimeofday(&finish_time,NULL);
+	cout << tval(&start_time,&finish_time) << endl;
+}
+
 int main ( int argc, char ** argv)
 {
 
@@ -211,10 +312,83 @@ int main ( int argc, char ** argv)
 	}
 	int num_iterations = atoi( argv[1] );
 
-	cout << "alignator\tseqseq\tseqprof\tprofprof" << std::endl;
+	cout << "alignator\tseqseq\tseqprof\tprofprof\tlongseqseq" << std::endl;
 	{
 		HAlignator alignator = makeAlignatorDPFull( ALIGNMENT_LOCAL, -10.0, -2.0 );
 		cout << "AlignatorDPFull\t"; BenchmarkAll( num_iterations, alignator );
 	}
+	{
+		HAlignator alignator = makeAlignatorDPFull( ALIGNMENT_LOCAL, -10.0, -2.0 );
+		alignator->cloneToolkit();
+		alignator->getToolkit()->setScorer( makeScorerProfileProfileCached() );
+		cout << "AlignatorDPFull(cached)\t"; BenchmarkAll( num_iterations, alignator );
+	}
+	{
+		HAlignator alignator = makeAlignatorDPFull( ALIGNMENT_LOCAL, -10.0, -2.0 );
+		alignator->cloneToolkit();
+		alignator->getToolkit()->setIterator2D( makeIterator2DXDrop( 30 ) );
+		cout << "AlignatorDPFull(xdrop)\t"; BenchmarkAll( num_iterations, alignator );
+	}
+	{
+		HAlignator alignator = makeAlignatorDPScoreOnly( ALIGNMENT_LOCAL, -10.0, -2.0 );
+		cout << "AlignatorDPScoreOnly\t"; BenchmarkAll( num_iterations, alignator );
+	}
+	{
+		HAlignator alignator = makeAlignatorSWStriped( -10.0, -2.0 );
+		cout << "AlignatorSWStriped\t"; BenchmarkAll( num_iterations, alignator );
+	}
+
+	cout << "alignator\talign\talignMany\tsearchDatabase" << std::endl;
+	{
+		HAlignator alignator = makeAlignatorDPFull( ALIGNMENT_LOCAL, -10.0, -2.0 );
+		cout << "AlignatorDPFull\t"; BenchmarkBatch( num_iterations, alignator );
+	}
+	{
+		HAlignator alignator = makeAlignatorDPScoreOnly( ALIGNMENT_LOCAL, -10.0, -2.0 );
+		cout << "AlignatorDPScoreOnly\t"; BenchmarkBatch( num_iterations, alignator );
+	}
+	{
+		HAlignator alignator = makeAlignatorTuples( 3 );
+		cout << "AlignatorTuples\t"; BenchmarkBatch( num_iterations, alignator );
+	}
+	{
+		HAlignator alignator = makeAlignatorIdentity();
+		cout << "AlignatorIdentity\t"; BenchmarkBatch( num_iterations, alignator );
+	}
+	{
+		HAlignator alignator = makeAlignatorSimilarity();
+		cout << "AlignatorSimilarity\t"; BenchmarkBatch( num_iterations, alignator );
+	}
+	{
+		HAlignator alignator = makeAlignatorDots( makeAlignatorTuples( 3 ), -10.0, -2.0 );
+		cout << "AlignatorDots\t"; BenchmarkBatch( num_iterations, alignator );
+	}
+	{
+		HAlignator alignator = makeAlignatorDots( makeAlignatorIdentity(), -10.0, -2.0 );
+		cout << "AlignatorDots(identity)\t"; BenchmarkBatch( num_iterations, alignator );
+	}
+	{
+		HAlignator alignator = makeAlignatorDotsSparse( makeAlignatorIdentity(), -10.0, -2.0 );
+		cout << "AlignatorDotsSparse(identity)\t"; BenchmarkBatch( num_iterations, alignator );
+	}
+	{
+		HAlignator alignator = makeAlignatorHSP( makeAlignatorTuples( 3 ),
+				makeAlignatorDPFull( ALIGNMENT_LOCAL, -10.0, -2.0 ) );
+		cout << "AlignatorHSP\t"; BenchmarkBatch( num_iterations, alignator );
+	}
+
+	cout << "alignator\tdotplot" << std::endl;
+	{
+		HAlignator alignator = makeAlignatorDots( makeAlignatorIdentity(), -10.0, -2.0 );
+		cout << "AlignatorDots(identity)\t"
+			 << Benchmark( alignator, num_iterations / 100 + 1, &BenchmarkAlignment, NULL, &ClearAlignment, &InitDotplot, &ClearAll )
+			 << endl;
+	}
+	{
+		HAlignator alignator = makeAlignatorDotsSparse( makeAlignatorIdentity(), -10.0, -2.0 );
+		cout << "AlignatorDotsSparse(identity)\t"
+			 << Benchmark( alignator, num_iterations / 100 + 1, &BenchmarkAlignment, NULL, &ClearAlignment, &InitDotplot, &ClearAll )
+			 << endl;
+	}
 	exit (EXIT_SUCCESS);
 }
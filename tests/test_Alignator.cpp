@@ -36,6 +36,12 @@
 #include <fstream>
 #include <sstream>
 #include <vector>
+#include <algorithm>
+#include <functional>
+#include <cstdlib>
+#include <set>
+#include <new>
+#include <stdexcept>
 
 #include <time.h>
 
@@ -354,6 +360,945 @@ BOOST_AUTO_TEST_CASE( local_alignment)
 
 }
 
+BOOST_AUTO_TEST_CASE( score_only_alignment)
+{
+	HSubstitutionMatrix matrix = makeSubstitutionMatrix(
+			getDefaultEncoder()->getAlphabetSize(),
+			10, -1);
+
+	setDefaultSubstitutionMatrix( matrix );
+
+	std::vector<HAlignandum> seqs;
+	seqs.push_back( makeSequence( "AAAAACCCCCAAAAA" ) );
+	seqs.push_back( makeSequence( "CCCCC" ) );
+	seqs.push_back( makeSequence( "CCCKCCC" ) );
+	seqs.push_back( makeSequence( "AAAAACCACCAAAAA" ) );
+	seqs.push_back( makeSequence( "KKKACACACKKK") );
+	seqs.push_back( makeSequence( "AC") );
+	seqs.push_back( makeProfile( "AAAAAAACCCCAAAAAAA", 1) );
+
+	Score gop = -12;
+	Score gep = -2;
+
+	std::vector<HAlignator> full, score_only;
+	full.push_back( makeAlignatorDPFull( ALIGNMENT_LOCAL, gop, gep ) );
+	score_only.push_back( makeAlignatorDPScoreOnly( ALIGNMENT_LOCAL, gop, gep ) );
+	full.push_back( makeAlignatorDPFull( ALIGNMENT_GLOBAL, gop, gep, true, true, true, true ) );
+	score_only.push_back( makeAlignatorDPScoreOnly( ALIGNMENT_GLOBAL, gop, gep, true, true, true, true ) );
+	full.push_back( makeAlignatorDPFull( ALIGNMENT_WRAP, gop, gep ) );
+	score_only.push_back( makeAlignatorDPScoreOnly( ALIGNMENT_WRAP, gop, gep ) );
+
+	HAlignment ali1 = makeAlignmentVector();
+	HAlignment ali2 = makeAlignmentVector();
+
+	for (unsigned int a = 0; a < full.size(); ++a)
+		for (unsigned int x = 0; x < seqs.size(); ++x)
+			for (unsigned int y = 0; y < seqs.size(); ++y)
+			{
+				full[a]->align( ali1, seqs[x], seqs[y] );
+				score_only[a]->align( ali2, seqs[x], seqs[y] );
+				BOOST_CHECK_EQUAL( ali1->getScore(), ali2->getScore() );
+				BOOST_CHECK( ali2->getLength() <= 1 );
+				// local alignments end in the same cell. In global alignments
+				// the traceback skips terminal gaps.
+				if (a == 0 && !ali1->isEmpty())
+				{
+					BOOST_CHECK_EQUAL( ali1->getRowTo(), ali2->getRowTo() );
+					BOOST_CHECK_EQUAL( ali1->getColTo(), ali2->getColTo() );
+				}
+			}
+
+	// no alignment with positive score
+	score_only[0]->align( ali2, makeSequence( "WWWW" ), makeSequence( "PPPP" ) );
+	BOOST_CHECK( ali2->isEmpty() );
+	BOOST_CHECK_EQUAL( ali2->getScore(), 0 );
+}
+
+BOOST_AUTO_TEST_CASE( low_memory_alignment)
+{
+	setDefaultSubstitutionMatrix( makeSubstitutionMatrixBlosum62() );
+
+	std::vector<HAlignandum> seqs;
+	seqs.push_back( makeSequence( "AAAAACCCCCAAAAA" ) );
+	seqs.push_back( makeSequence( "CCCKCCC" ) );
+	seqs.push_back( makeSequence( "KKKACACACKKK") );
+	seqs.push_back( makeProfile( "AAAAAAACCCCAAAAAAA", 1) );
+
+	const std::string alphabet( "ACDEFGHIKLMNPQRSTVWY" );
+	srand( 2 );
+	for (int x = 0; x < 4; ++x)
+	{
+		std::string s;
+		int l = 50 + rand() % 150;
+		for (int y = 0; y < l; ++y) s += alphabet[rand() % alphabet.size()];
+		seqs.push_back( makeSequence( s ) );
+		// a mutated copy
+		for (int y = 0; y < l / 10; ++y) s[rand() % l] = alphabet[rand() % alphabet.size()];
+		s.erase( rand() % (l / 2), 5 );
+		seqs.push_back( makeSequence( s ) );
+	}
+
+	Score gop = -10;
+	Score gep = -1;
+
+	std::vector<HAlignator> full, low_memory;
+	full.push_back( makeAlignatorDPFull( ALIGNMENT_LOCAL, gop, gep ) );
+	low_memory.push_back( makeAlignatorDPFullLowMemory( ALIGNMENT_LOCAL, gop, gep ) );
+	full.push_back( makeAlignatorDPFull( ALIGNMENT_GLOBAL, gop, gep, true, true, true, true ) );
+	low_memory.push_back( makeAlignatorDPFullLowMemory( ALIGNMENT_GLOBAL, gop, gep, true, true, true, true ) );
+	full.push_back( makeAlignatorDPFull( ALIGNMENT_WRAP, gop, gep ) );
+	low_memory.push_back( makeAlignatorDPFullLowMemory( ALIGNMENT_WRAP, gop, gep ) );
+	// banded alignment
+	full.push_back( makeAlignatorDPFull( ALIGNMENT_LOCAL, gop, gep ) );
+	low_memory.push_back( makeAlignatorDPFullLowMemory( ALIGNMENT_LOCAL, gop, gep ) );
+	full.back()->cloneToolkit();
+	full.back()->getToolkit()->setIterator2D( makeIterator2DBanded( -10, 10 ) );
+	low_memory.back()->cloneToolkit();
+	low_memory.back()->getToolkit()->setIterator2D( makeIterator2DBanded( -10, 10 ) );
+
+	HAlignment ali1 = makeAlignmentVector();
+	HAlignment ali2 = makeAlignmentVector();
+
+	for (unsigned int a = 0; a < full.size(); ++a)
+		for (unsigned int x = 0; x < seqs.size(); ++x)
+			for (unsigned int y = 0; y < seqs.size(); ++y)
+			{
+				full[a]->align( ali1, seqs[x], seqs[y] );
+				low_memory[a]->align( ali2, seqs[x], seqs[y] );
+				BOOST_CHECK_EQUAL( ali1->getScore(), ali2->getScore() );
+				BOOST_CHECK( checkAlignmentIdentity( ali1, ali2 ) );
+			}
+}
+
+BOOST_AUTO_TEST_CASE( xdrop_alignment )
+{
+	setDefaultSubstitutionMatrix( makeSubstitutionMatrixBlosum62() );
+
+	const std::string alphabet( "ACDEFGHIKLMNPQRSTVWY" );
+	srand( 3 );
+	std::string s1, s2;
+	for (int y = 0; y < 300; ++y) s1 += alphabet[rand() % alphabet.size()];
+	s2 = s1;
+	for (int y = 0; y < 30; ++y) s2[rand() % s2.size()] = alphabet[rand() % alphabet.size()];
+	s2.erase( 100, 5 );
+	HAlignandum seq1 = makeSequence( s1 );
+	HAlignandum seq2 = makeSequence( s2 );
+
+	HAlignator full = makeAlignatorDPFull( ALIGNMENT_LOCAL, -10, -1 );
+	HAlignment ali1 = makeAlignmentVector();
+	full->align( ali1, seq1, seq2 );
+
+	// a large threshold computes the full matrix
+	{
+		HIterator2D iterator = makeIterator2DXDrop( 100000 );
+		HAlignator alignator = makeAlignatorDPFull( ALIGNMENT_LOCAL, -10, -1 );
+		alignator->cloneToolkit();
+		alignator->getToolkit()->setIterator2D( iterator );
+		HAlignment ali2 = makeAlignmentVector();
+		alignator->align( ali2, seq1, seq2 );
+		BOOST_CHECK_EQUAL( ali1->getScore(), ali2->getScore() );
+		BOOST_CHECK( checkAlignmentIdentity( ali1, ali2 ) );
+		BOOST_CHECK_EQUAL( getNumCells( alignator ), s1.size() * s2.size() );
+	}
+
+	// a small threshold follows the alignment
+	{
+		HIterator2D iterator = makeIterator2DXDrop( 30 );
+		HAlignator alignator = makeAlignatorDPFull( ALIGNMENT_LOCAL, -10, -1 );
+		alignator->cloneToolkit();
+		alignator->getToolkit()->setIterator2D( iterator );
+		HAlignment ali2 = makeAlignmentVector();
+		alignator->align( ali2, seq1, seq2 );
+		BOOST_CHECK_EQUAL( ali1->getScore(), ali2->getScore() );
+		BOOST_CHECK( checkAlignmentIdentity( ali1, ali2 ) );
+
+		// only cells near the alignment are computed
+		BOOST_CHECK( getNumCells( alignator ) > 0 );
+		BOOST_CHECK( getNumCells( alignator ) < s1.size() * s2.size() / 4 );
+		BOOST_CHECK_EQUAL( getNumCells( full ), s1.size() * s2.size() );
+
+		// the prototype does not count the cells of alignments
+		BOOST_CHECK_EQUAL( iterator->getNumCells(), (size_t)0 );
+
+		HAlignator low_memory = makeAlignatorDPFullLowMemory( ALIGNMENT_LOCAL, -10, -1 );
+		low_memory->cloneToolkit();
+		low_memory->getToolkit()->setIterator2D( iterator );
+		HAlignment ali3 = makeAlignmentVector();
+		low_memory->align( ali3, seq1, seq2 );
+		BOOST_CHECK_EQUAL( ali2->getScore(), ali3->getScore() );
+		BOOST_CHECK( checkAlignmentIdentity( ali2, ali3 ) );
+		BOOST_CHECK_EQUAL( getNumCells( low_memory ), getNumCells( alignator ) );
+	}
+}
+
+BOOST_AUTO_TEST_CASE( cached_profile_scores )
+{
+	setDefaultSubstitutionMatrix( makeSubstitutionMatrixBlosum62() );
+
+	HAlignandum prof1 = makeProfile( "AAAAAAACCCCAAAAAAAKKKLLLMMM", 1);
+	HAlignandum prof2 = makeProfile( "AAAACCCCKAAAAAAAKKKLLMLMMAAACCCCKAAAAAAAKKKLLMLMMA", 2);
+	HAlignandum seq1 = makeSequence( "AAAAAAACCCCAAAAAAA" );
+
+	HAlignator full = makeAlignatorDPFull( ALIGNMENT_LOCAL, -10, -1 );
+	HAlignator cached = makeAlignatorDPFull( ALIGNMENT_LOCAL, -10, -1 );
+	cached->cloneToolkit();
+	cached->getToolkit()->setScorer( makeScorerProfileProfileCached() );
+
+	HAlignment ali1 = makeAlignmentVector();
+	HAlignment ali2 = makeAlignmentVector();
+
+	full->align( ali1, prof1, prof2 );
+	cached->align( ali2, prof1, prof2 );
+	BOOST_CHECK_EQUAL( ali1->getScore(), ali2->getScore() );
+	BOOST_CHECK( checkAlignmentIdentity( ali1, ali2 ) );
+
+	// segments
+	prof1->useSegment( 3, 20 );
+	prof2->useSegment( 5, 15 );
+	full->align( ali1, prof1, prof2 );
+	cached->align( ali2, prof1, prof2 );
+	BOOST_CHECK_EQUAL( ali1->getScore(), ali2->getScore() );
+	BOOST_CHECK( checkAlignmentIdentity( ali1, ali2 ) );
+	prof1->useSegment();
+	prof2->useSegment();
+
+	// sequence/profile alignments use the default scorer
+	full->align( ali1, seq1, prof2 );
+	cached->align( ali2, seq1, prof2 );
+	BOOST_CHECK_EQUAL( ali1->getScore(), ali2->getScore() );
+	BOOST_CHECK( checkAlignmentIdentity( ali1, ali2 ) );
+
+	// long profiles use the default scorer
+	HAlignandum prof3 = makeProfile( std::string( 9000, 'A' ), 1 );
+	prof3->prepare();
+	HScorer scorer;
+	BOOST_CHECK_NO_THROW( scorer = makeScorerProfileProfileCached()->getNew( prof3, prof3 ) );
+	BOOST_CHECK_EQUAL( scorer->getScore( 8999, 8999 ), makeScorer( prof3, prof3 )->getScore( 8999, 8999 ) );
+}
+
+/** dots of identical tuples of size ktuple in row and col */
+std::vector< std::pair<Position,Position> > getTupleDots(
+		const std::string & row,
+		const std::string & col,
+		int ktuple )
+{
+	std::set< std::pair<Position,Position> > dots;
+	for (int r = 0; r + ktuple <= (int)row.size(); ++r)
+		for (int c = 0; c + ktuple <= (int)col.size(); ++c)
+			if (row.substr( r, ktuple ) == col.substr( c, ktuple ))
+				for (int i = 0; i < ktuple; ++i)
+					dots.insert( std::make_pair( r + i, c + i ) );
+	return std::vector< std::pair<Position,Position> >( dots.begin(), dots.end() );
+}
+
+/** dots in an alignment in the order of iteration */
+std::vector< std::pair<Position,Position> > getDots( const HAlignment & ali )
+{
+	std::vector< std::pair<Position,Position> > dots;
+	for (AlignmentIterator it = ali->begin(); it != ali->end(); ++it)
+		dots.push_back( std::make_pair( it->mRow, it->mCol ) );
+	return dots;
+}
+
+BOOST_AUTO_TEST_CASE( tuples_alignment )
+{
+	std::vector<std::string> seqs;
+	seqs.push_back( "KKKLLLMMMKKKLLLMMMAAAAAAACCCCAAAAAAAKKKLLLMMMAAAAAAACCCCAAAAAAA" );
+	seqs.push_back( "AAAACCCCKAAAAAAAKKKLLMLMM" );
+	seqs.push_back( "CCCCAAA" );
+	seqs.push_back( "AC" );
+
+	const char * alphabet = "ACDEFGHIKLMNPQRSTVWY";
+	srand( 1 );
+	for (int x = 0; x < 4; ++x)
+	{
+		std::string s;
+		for (int i = 0; i < 60 + 10 * x; ++i)
+			s += alphabet[rand() % (x < 2 ? 20 : 4)];
+		seqs.push_back( s );
+	}
+
+	// tuple sizes with direct lookup and binary search
+	int ktuples[] = { 1, 3, 4, 7 };
+	for (int k = 0; k < 4; ++k)
+	{
+		HAlignator tuples = makeAlignatorTuples( ktuples[k] );
+		for (size_t x = 0; x < seqs.size(); ++x)
+			for (size_t y = 0; y < seqs.size(); ++y)
+			{
+				HAlignment ali = makeAlignmentMatrixRow();
+				tuples->align( ali, makeSequence( seqs[x] ), makeSequence( seqs[y] ) );
+				BOOST_CHECK( getDots( ali ) == getTupleDots( seqs[x], seqs[y], ktuples[k] ) );
+			}
+	}
+
+	// the index cached on the row is updated when the row changes
+	HAlignator tuples = makeAlignatorTuples( 3 );
+	HAlignandum row = makeSequence( seqs[0] );
+	HAlignandum col = makeSequence( seqs[1] );
+	HAlignment ali = makeAlignmentMatrixRow();
+	tuples->align( ali, row, col );
+	BOOST_CHECK( getDots( ali ) == getTupleDots( seqs[0], seqs[1], 3 ) );
+
+	row->mask( 20, 21 );
+	std::string masked( seqs[0] );
+	masked[20] = 'X';
+	ali->clear();
+	tuples->align( ali, row, col );
+	BOOST_CHECK( getDots( ali ) == getTupleDots( masked, seqs[1], 3 ) );
+}
+
+/** collect alignments from alignMany */
+class CollectAlignments : public AlignatorCallback
+{
+public:
+	CollectAlignments( size_t max_results = 0 ) : mMaxResults( max_results ) {}
+
+	virtual bool operator()( size_t index, const HAlignandum & target, const HAlignment & result )
+	{
+		mIndices.push_back( index );
+		mResults.push_back( result->getClone() );
+		return mMaxResults == 0 || mResults.size() < mMaxResults;
+	}
+
+	size_t mMaxResults;
+	std::vector<size_t> mIndices;
+	std::vector<HAlignment> mResults;
+};
+
+BOOST_AUTO_TEST_CASE( batch_alignment )
+{
+	HAlignandum query = makeSequence( "AAAAAAACCCCAAAAAAAKKKLLLMMM" );
+
+	AlignandumVector targets;
+	targets.push_back( makeSequence( "AAAACCCCKAAAAAAAKKKLLMLMM" ) );
+	targets.push_back( makeSequence( "CCCCAAA" ) );
+	targets.push_back( makeSequence( "KKKLLLMMMKKKLLLMMMAAAAAAACCCCAAAAAAAKKKLLLMMM" ) );
+	targets.push_back( makeSequence( "WWWW" ) );
+	targets.push_back( makeProfile( "AAAACCCCKAAAAAAAKKKLLMLMMAAACCCCKAAAAAAAKKKLLMLMMA", 2) );
+
+	std::vector<HAlignator> alignators;
+	alignators.push_back( makeAlignatorDPFull( ALIGNMENT_LOCAL, -10, -1 ) );
+	alignators.push_back( makeAlignatorDPFull( ALIGNMENT_GLOBAL, -10, -1 ) );
+	alignators.push_back( makeAlignatorDPFullLowMemory( ALIGNMENT_LOCAL, -10, -1 ) );
+	alignators.push_back( makeAlignatorTuples( 3 ) );
+	alignators.push_back( makeAlignatorDots( makeAlignatorTuples( 3 ), -10, -1 ) );
+	alignators.push_back( makeAlignatorHSP( makeAlignatorTuples( 3 ),
+			makeAlignatorDPFull( ALIGNMENT_LOCAL, -10, -1 ), 3, 40, 20, 10, 16 ) );
+
+	for (size_t a = 0; a < alignators.size(); ++a)
+	{
+		CollectAlignments collect;
+		HAlignment ali = makeAlignmentVector();
+		alignators[a]->alignMany( ali, query, targets, collect );
+
+		BOOST_CHECK_EQUAL( collect.mResults.size(), targets.size() );
+		for (size_t x = 0; x < collect.mResults.size(); ++x)
+		{
+			HAlignment expected = makeAlignmentVector();
+			alignators[a]->align( expected, query, targets[collect.mIndices[x]] );
+			BOOST_CHECK_EQUAL( collect.mIndices[x], x );
+			BOOST_CHECK_EQUAL( expected->getScore(), collect.mResults[x]->getScore() );
+			BOOST_CHECK( checkAlignmentIdentity( expected, collect.mResults[x] ) );
+		}
+	}
+
+	// stop early
+	{
+		CollectAlignments collect( 2 );
+		HAlignment ali = makeAlignmentVector();
+		alignators[0]->alignMany( ali, query, targets, collect );
+		BOOST_CHECK_EQUAL( collect.mResults.size(), (size_t)2 );
+	}
+
+	// profile query with a scorer that is re-used for each target
+	{
+		HAlignandum profile_query = makeProfile( "AAAAAAACCCCAAAAAAAKKKLLLMMM", 1 );
+		AlignandumVector profile_targets;
+		profile_targets.push_back( makeProfile( "AAAACCCCKAAAAAAAKKKLLMLMMAAACCCCKAAAAAAAKKKLLMLMMA", 2) );
+		profile_targets.push_back( makeSequence( "CCCCAAA" ) );
+		profile_targets.push_back( makeProfile( "KKKLLLMMMKKKLLLMMMAAAAAAACCCCAAAAAAAKKKLLLMMM", 1) );
+		profile_targets.push_back( makeProfile( "CCCCAAAKKL", 1) );
+
+		HAlignator cached = makeAlignatorDPFull( ALIGNMENT_LOCAL, -10, -1 );
+		cached->cloneToolkit();
+		cached->getToolkit()->setScorer( makeScorerProfileProfileCached() );
+		HAlignator full = makeAlignatorDPFull( ALIGNMENT_LOCAL, -10, -1 );
+
+		CollectAlignments collect;
+		HAlignment ali = makeAlignmentVector();
+		cached->alignMany( ali, profile_query, profile_targets, collect );
+		BOOST_CHECK_EQUAL( collect.mResults.size(), profile_targets.size() );
+		for (size_t x = 0; x < collect.mResults.size(); ++x)
+		{
+			HAlignment expected = makeAlignmentVector();
+			full->align( expected, profile_query, profile_targets[x] );
+			BOOST_CHECK_EQUAL( expected->getScore(), collect.mResults[x]->getScore() );
+			BOOST_CHECK( checkAlignmentIdentity( expected, collect.mResults[x] ) );
+		}
+	}
+}
+
+BOOST_AUTO_TEST_CASE( grouped_score_only_alignment )
+{
+	HAlignandum query = makeSequence( "AAAAAAACCCCAAAAAAAKKKLLLMMMWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWW" );
+
+	const char * alphabet = "ACDEFGHIKLMNPQRSTVWY";
+	srand( 1 );
+	AlignandumVector targets;
+	for (int t = 0; t < 100; ++t)
+	{
+		std::string s;
+		int length = 1 + rand() % 80;
+		for (int x = 0; x < length; ++x) s += alphabet[ rand() % 20 ];
+		if (t % 10 == 0) s += "AAACCCCAAAAAAAKKKLL";
+		targets.push_back( makeSequence( s ) );
+	}
+	// no alignment with positive score
+	targets.push_back( makeSequence( "PPPP" ) );
+	// saturates 16-bit scores
+	targets.push_back( makeSequence( std::string( 4000, 'W' ) ) );
+	// not a sequence
+	targets.push_back( makeProfile( "AAAACCCCKAAAAAAAKKKLLMLMMAAACCCCKAAAAAAAKKKLLMLMMA", 2) );
+
+	HAlignator alignator = makeAlignatorDPScoreOnly( ALIGNMENT_LOCAL, -10, -1 );
+
+	CollectAlignments collect;
+	HAlignment ali = makeAlignmentVector();
+	alignator->alignMany( ali, query, targets, collect );
+
+	BOOST_CHECK_EQUAL( collect.mResults.size(), targets.size() );
+	for (size_t x = 0; x < collect.mResults.size(); ++x)
+	{
+		HAlignment expected = makeAlignmentVector();
+		alignator->align( expected, query, targets[x] );
+		BOOST_CHECK_EQUAL( collect.mIndices[x], x );
+		BOOST_CHECK_EQUAL( expected->getScore(), collect.mResults[x]->getScore() );
+		BOOST_CHECK( checkAlignmentIdentity( expected, collect.mResults[x] ) );
+	}
+}
+
+BOOST_AUTO_TEST_CASE( workspace_reuse )
+{
+	std::vector<HAlignandum> seqs;
+	seqs.push_back( makeSequence( "KKKLLLMMMKKKLLLMMMAAAAAAACCCCAAAAAAAKKKLLLMMMAAAAAAACCCCAAAAAAA" ) );
+	seqs.push_back( makeSequence( "AAAACCCCKAAAAAAAKKKLLMLMM" ) );
+	seqs.push_back( makeSequence( "CCCCAAA" ) );
+	seqs.push_back( makeSequence( "AAAAAAACCCCAAAAAAAKKKLLLMMMAAAACCCCKAAAAAAAKKKLLMLMMKKKLLLMMMKKKLLLMMMAAAAAAACCCCAAAAAAA" ) );
+
+	std::vector<HAlignator> alignators;
+	alignators.push_back( makeAlignatorDPFull( ALIGNMENT_LOCAL, -10, -1 ) );
+	alignators.push_back( makeAlignatorDPFullLowMemory( ALIGNMENT_GLOBAL, -10, -1 ) );
+	alignators.push_back( makeAlignatorDPScoreOnly( ALIGNMENT_LOCAL, -10, -1 ) );
+	alignators.push_back( makeAlignatorDots( makeAlignatorTuples( 3 ), -10, -1 ) );
+	alignators.push_back( makeAlignatorSWStriped( -10, -1 ) );
+
+	// alignments with work space kept from previous alignments of different size
+	// agree with alignments by a new alignator.
+	for (size_t a = 0; a < alignators.size(); ++a)
+	{
+		for (size_t x = 0; x < seqs.size(); ++x)
+			for (size_t y = 0; y < seqs.size(); ++y)
+			{
+				HAlignment ali1 = makeAlignmentVector();
+				HAlignment ali2 = makeAlignmentVector();
+				alignators[a]->align( ali1, seqs[x], seqs[y] );
+				alignators[a]->getClone()->align( ali2, seqs[x], seqs[y] );
+				BOOST_CHECK_EQUAL( ali1->getScore(), ali2->getScore() );
+				BOOST_CHECK( checkAlignmentIdentity( ali1, ali2 ) );
+			}
+
+		alignators[a]->trimWorkspace();
+
+		HAlignment ali1 = makeAlignmentVector();
+		HAlignment ali2 = makeAlignmentVector();
+		alignators[a]->align( ali1, seqs[0], seqs[3] );
+		alignators[a]->getClone()->align( ali2, seqs[0], seqs[3] );
+		BOOST_CHECK_EQUAL( ali1->getScore(), ali2->getScore() );
+		BOOST_CHECK( checkAlignmentIdentity( ali1, ali2 ) );
+	}
+}
+
+BOOST_AUTO_TEST_CASE( sparse_dots_alignment )
+{
+	std::vector<HAlignandum> seqs;
+	seqs.push_back( makeSequence( "KKKLLLMMMKKKLLLMMMAAAAAAACCCCAAAAAAAKKKLLLMMMAAAAAAACCCCAAAAAAA" ) );
+	seqs.push_back( makeSequence( "AAAACCCCKAAAAAAAKKKLLMLMM" ) );
+	seqs.push_back( makeSequence( "CCCCAAA" ) );
+	seqs.push_back( makeSequence( "AAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAA" ) );
+
+	const char * alphabet = "ACDEFGHIKLMNPQRSTVWY";
+	srand( 1 );
+	for (int x = 0; x < 4; ++x)
+	{
+		std::string s;
+		for (int i = 0; i < 60 + 10 * x; ++i)
+			s += alphabet[rand() % (x < 2 ? 20 : 4)];
+		seqs.push_back( makeSequence( s.c_str() ) );
+	}
+
+	std::vector<HAlignator> dottors;
+	dottors.push_back( makeAlignatorIdentity() );
+	dottors.push_back( makeAlignatorSimilarity() );
+	dottors.push_back( makeAlignatorTuples( 3 ) );
+
+	// the sparse dynamic programming gives the same alignments
+	// as the search over all dots.
+	for (size_t d = 0; d < dottors.size(); ++d)
+	{
+		HAlignator dots = makeAlignatorDots( dottors[d], -4, -1 );
+		HAlignator sparse = makeAlignatorDotsSparse( dottors[d], -4, -1 );
+		for (size_t x = 0; x < seqs.size(); ++x)
+			for (size_t y = 0; y < seqs.size(); ++y)
+			{
+				HAlignment ali1 = makeAlignmentVector();
+				HAlignment ali2 = makeAlignmentVector();
+				dots->align( ali1, seqs[x], seqs[y] );
+				sparse->align( ali2, seqs[x], seqs[y] );
+				BOOST_CHECK_EQUAL( ali1->getScore(), ali2->getScore() );
+				BOOST_CHECK( checkAlignmentIdentity( ali1, ali2 ) );
+			}
+	}
+}
+
+/** dots of Identity (identity = true) or Similarity alignators, checking all pairs
+ * in the iterator with the scorer.
+ */
+std::vector< std::pair<Position,Position> > getSimilarDots(
+		const HAlignator & alignator,
+		const HAlignandum & row,
+		const HAlignandum & col,
+		bool identity )
+{
+	std::vector< std::pair<Position,Position> > dots;
+	HScorer scorer( alignator->getToolkit()->getScorer()->getNew( row, col ) );
+	HIterator2D it2d( alignator->getToolkit()->getIterator2D()->getNew( row, col ) );
+	const Residue mask_code = alignator->getToolkit()->getEncoder()->getMaskCode();
+	for (Iterator2D::const_iterator rit = it2d->row_begin(); rit != it2d->row_end(); ++rit)
+		for (Iterator2D::const_iterator cit = it2d->col_begin(*rit); cit != it2d->col_end(*rit); ++cit)
+		{
+			if (identity)
+			{
+				if (row->asResidue(*rit) != mask_code && row->asResidue(*rit) == col->asResidue(*cit))
+					dots.push_back( std::make_pair( *rit, *cit ) );
+			}
+			else if (scorer->getScore( *rit, *cit ) > 0)
+				dots.push_back( std::make_pair( *rit, *cit ) );
+		}
+	std::sort( dots.begin(), dots.end() );
+	return dots;
+}
+
+BOOST_AUTO_TEST_CASE( similar_dots_alignment )
+{
+	// long sequences to compare residues in vectors
+	const char * alphabet = "ACDEFGHIKLMNPQRSTVWY";
+	srand( 1 );
+	std::vector<HAlignandum> seqs;
+	for (int x = 0; x < 4; ++x)
+	{
+		std::string s;
+		for (int i = 0; i < 37 + 101 * x; ++i)
+			s += alphabet[rand() % (x < 2 ? 20 : 4)];
+		seqs.push_back( makeSequence( s.c_str() ) );
+	}
+	seqs.push_back( makeSequence( "A" ) );
+	// an empty sequence and residues without similar residues
+	seqs.push_back( makeSequence( "" ) );
+	seqs.push_back( makeSequence( "AXXW" ) );
+	seqs[2]->mask( 10, 30 );
+	seqs[3]->mask( 0, 1 );
+	seqs[3]->useSegment( 17, 250 );
+
+	for (int banded = 0; banded < 2; ++banded)
+		for (int identity = 0; identity < 2; ++identity)
+		{
+			HAlignator alignator = identity ? makeAlignatorIdentity() : makeAlignatorSimilarity();
+			if (banded)
+			{
+				alignator->cloneToolkit();
+				alignator->getToolkit()->setIterator2D( makeIterator2DBanded( -20, 35 ) );
+			}
+			for (size_t x = 0; x < seqs.size(); ++x)
+				for (size_t y = 0; y < seqs.size(); ++y)
+				{
+					HAlignment ali = makeAlignmentMatrixRow();
+					alignator->align( ali, seqs[x], seqs[y] );
+					std::vector< std::pair<Position,Position> > expected(
+							getSimilarDots( alignator, seqs[x], seqs[y], identity ));
+					std::vector< std::pair<Position,Position> > dots( getDots( ali ) );
+					std::sort( dots.begin(), dots.end() );
+					BOOST_CHECK( dots == expected );
+					BOOST_CHECK_EQUAL( ali->getScore(), (Score)expected.size() );
+				}
+		}
+}
+
+/** score of the best chain of fragments, checking all pairs of fragments.
+ *
+ * gop and gep are the penalties per gap as used by ImplAlignatorFragments,
+ * gaps of one residue are free.
+ */
+Score getBestChainScore( const FragmentVector & fragments, Score gop, Score gep )
+{
+	std::vector<size_t> order( fragments.size() );
+	for (size_t x = 0; x < fragments.size(); ++x) order[x] = x;
+	for (size_t x = 0; x < order.size(); ++x)
+		for (size_t y = x + 1; y < order.size(); ++y)
+			if (fragments[order[y]]->getRowFrom() < fragments[order[x]]->getRowFrom())
+				std::swap( order[x], order[y] );
+
+	std::vector<Score> scores( fragments.size(), 0 );
+	Score best_score = 0;
+	for (size_t x = 0; x < order.size(); ++x)
+	{
+		const HAlignment & current = fragments[order[x]];
+		Score best = 0;
+		bool found = false;
+		for (size_t y = 0; y < fragments.size(); ++y)
+		{
+			const HAlignment & previous = fragments[y];
+			if (scores[y] <= 0 ||
+					previous->getRowTo() >= current->getRowFrom() ||
+					previous->getColTo() >= current->getColFrom())
+				continue;
+			Score score = scores[y];
+			Position d = current->getRowFrom() - previous->getRowTo();
+			if (d > 1) score += gop + d * gep;
+			d = current->getColFrom() - previous->getColTo();
+			if (d > 1) score += gop + d * gep;
+			if (score >= best)
+			{
+				best = score;
+				found = true;
+			}
+		}
+		Score score = current->getScore() + (found ? best : 0);
+		if (score < 0)
+			continue;
+		scores[order[x]] = score;
+		best_score = std::max( best_score, score );
+	}
+	return best_score;
+}
+
+BOOST_AUTO_TEST_CASE( fragments_alignment )
+{
+	const char * alphabet = "ACDEFGHIKLMNPQRSTVWY";
+	srand( 1 );
+
+	std::vector<HAlignandum> seqs;
+	seqs.push_back( makeSequence( "KKKLLLMMMKKKLLLMMMAAAAAAACCCCAAAAAAAKKKLLLMMMAAAAAAACCCCAAAAAAA" ) );
+	seqs.push_back( makeSequence( "AAAACCCCKAAAAAAAKKKLLMLMM" ) );
+	for (int x = 0; x < 4; ++x)
+	{
+		// repeats give many fragments
+		std::string unit;
+		for (int i = 0; i < 5 + 3 * x; ++i)
+			unit += alphabet[rand() % (x < 2 ? 20 : 4)];
+		std::string s;
+		for (int i = 0; i < 100; ++i)
+			s += (rand() % 10 == 0) ? alphabet[rand() % 20] : unit[i % unit.size()];
+		seqs.push_back( makeSequence( s ) );
+	}
+
+	HFragmentor fragmentor = makeFragmentorDiagonals( makeAlignatorIdentity(), -4, -1 );
+
+	Score gops[] = { -4, -10 };
+	Score geps[] = { -1, -2 };
+	for (int g = 0; g < 2; ++g)
+	{
+		HAlignator alignator = makeAlignatorFragments( gops[g], geps[g], fragmentor );
+		for (size_t x = 0; x < seqs.size(); ++x)
+			for (size_t y = 0; y < seqs.size(); ++y)
+			{
+				HAlignment dummy = makeAlignmentSet();
+				HFragmentVector fragments = fragmentor->fragment( dummy, seqs[x], seqs[y] );
+
+				HAlignment ali = makeAlignmentVector();
+				alignator->align( ali, seqs[x], seqs[y] );
+
+				// makeAlignatorFragments uses gop - gep for both penalties
+				Score expected = getBestChainScore( *fragments,
+						gops[g] - geps[g], gops[g] - geps[g] );
+				BOOST_CHECK_EQUAL( ali->getScore(), round( expected ) );
+			}
+	}
+}
+
+BOOST_AUTO_TEST_CASE( hsp_alignment )
+{
+	const char * alphabet = "ACDEFGHIKLMNPQRSTVWY";
+	srand( 1 );
+	std::string query;
+	for (int x = 0; x < 200; ++x)
+		query += alphabet[rand() % 20];
+
+	// a target sharing a mutated segment with an insertion
+	std::string target;
+	for (int x = 0; x < 150; ++x)
+		target += alphabet[rand() % 20];
+	std::string segment( query.substr( 60, 80 ) );
+	segment[20] = 'W';
+	segment[50] = 'W';
+	segment.insert( 40, "GG" );
+	target.replace( 30, 80, segment );
+
+	std::string unrelated;
+	for (int x = 0; x < 150; ++x)
+		unrelated += alphabet[rand() % 20];
+
+	HAlignandum q = makeSequence( query );
+	HAlignandum t = makeSequence( target );
+	HAlignandum u = makeSequence( unrelated );
+
+	HAlignator gapped = makeAlignatorDPFull( ALIGNMENT_LOCAL, -10, -1 );
+	HAlignator hsp = makeAlignatorHSP( makeAlignatorTuples( 3 ), gapped, 3, 40, 20, 30, 16 );
+
+	// the shared segment is found with the same score as full dynamic programming
+	HAlignment ali1 = makeAlignmentVector();
+	HAlignment ali2 = makeAlignmentVector();
+	hsp->align( ali1, q, t );
+	gapped->align( ali2, q, t );
+	BOOST_CHECK_EQUAL( ali1->getScore(), ali2->getScore() );
+	BOOST_CHECK( ali1->getRowFrom() <= 62 );
+	BOOST_CHECK( ali1->getRowTo() >= 138 );
+
+	HSPCounts counts = getHSPCounts( hsp );
+	BOOST_CHECK( counts.mNumSeeds > 0 );
+	BOOST_CHECK( counts.mNumTwoHits <= counts.mNumSeeds );
+	BOOST_CHECK( counts.mNumHSPs > 0 );
+	BOOST_CHECK( counts.mNumHSPs <= counts.mNumTwoHits );
+	BOOST_CHECK( counts.mNumExtensions > 0 );
+	BOOST_CHECK( counts.mNumExtensions <= counts.mNumHSPs );
+
+	// unrelated sequences are not extended
+	resetHSPCounts( hsp );
+	hsp->align( ali1, q, u );
+	BOOST_CHECK( ali1->isEmpty() );
+	counts = getHSPCounts( hsp );
+	BOOST_CHECK_EQUAL( counts.mNumHSPs, (size_t)0 );
+	BOOST_CHECK_EQUAL( counts.mNumExtensions, (size_t)0 );
+
+	// counts accumulate and are copied with the alignator
+	hsp->align( ali1, q, t );
+	HAlignator copy = hsp->getClone();
+	BOOST_CHECK_EQUAL( getHSPCounts( copy ).mNumExtensions, getHSPCounts( hsp ).mNumExtensions );
+	BOOST_CHECK( getHSPCounts( hsp ).mNumSeeds > counts.mNumSeeds );
+
+	// identical sequences
+	hsp->align( ali1, q, q );
+	gapped->align( ali2, q, q );
+	BOOST_CHECK_EQUAL( ali1->getScore(), ali2->getScore() );
+
+	BOOST_CHECK_THROW( getHSPCounts( gapped ), AlignlibException );
+}
+
+/** a scorer failing with an exception that is not an AlignlibException */
+class FailingScorer : public Scorer
+{
+public:
+	FailingScorer( bool out_of_memory ) : mOutOfMemory( out_of_memory ) {}
+	virtual HScorer getClone() const { return HScorer( new FailingScorer( *this ) ); }
+	virtual HScorer getNew() const { return getClone(); }
+	virtual HScorer getNew( const HAlignandum & row, const HAlignandum & col ) const
+	{
+		if (mOutOfMemory) throw std::bad_alloc();
+		throw std::runtime_error( "failing scorer" );
+	}
+	virtual bool setCol( const HAlignandum & col ) { return false; }
+	virtual Score getScore( const Position & row, const Position & col ) const { return 0; }
+	virtual void setToolkit( const HToolkit & toolkit ) {}
+	virtual void cloneToolkit() {}
+	virtual HToolkit getToolkit() const { return getDefaultToolkit(); }
+	bool mOutOfMemory;
+};
+
+BOOST_AUTO_TEST_CASE( database_search )
+{
+	HAlignandum query = makeSequence( "AAAAAAACCCCAAAAAAAKKKLLLMMM" );
+
+	const char * alphabet = "ACDEFGHIKLMNPQRSTVWY";
+	srand( 1 );
+	AlignandumVector targets;
+	for (int t = 0; t < 200; ++t)
+	{
+		std::string s;
+		int length = 5 + rand() % 60;
+		for (int x = 0; x < length; ++x) s += alphabet[ rand() % 20 ];
+		if (t % 10 == 0) s += "AAACCCCAAAAAAAKKKLL";
+		targets.push_back( makeSequence( s ) );
+	}
+
+	HAlignator alignator = makeAlignatorDPFull( ALIGNMENT_LOCAL, -10, -1 );
+
+	// all hits in serial
+	std::vector<Score> scores;
+	for (size_t t = 0; t < targets.size(); ++t)
+	{
+		HAlignment ali = makeAlignmentVector();
+		alignator->align( ali, query, targets[t] );
+		if (!ali->isEmpty()) scores.push_back( ali->getScore() );
+	}
+	std::sort( scores.begin(), scores.end(), std::greater<Score>() );
+
+	SearchHits all = searchDatabase( alignator, query, targets, 0, 1 );
+	BOOST_CHECK_EQUAL( all.size(), scores.size() );
+	for (size_t x = 0; x < all.size(); ++x)
+		BOOST_CHECK_EQUAL( all[x].mAlignment->getScore(), scores[x] );
+
+	for (unsigned int num_threads = 1; num_threads <= 4; ++num_threads)
+	{
+		SearchHits hits = searchDatabase( alignator, query, targets, 25, num_threads );
+		BOOST_CHECK_EQUAL( hits.size(), (size_t)25 );
+		for (size_t x = 0; x < hits.size(); ++x)
+		{
+			BOOST_CHECK_EQUAL( hits[x].mIndex, all[x].mIndex );
+			BOOST_CHECK( checkAlignmentIdentity( hits[x].mAlignment, all[x].mAlignment ) );
+		}
+	}
+
+	// counts of the threads are added to the alignator
+	{
+		HAlignator hsp = makeAlignatorHSP( makeAlignatorTuples( 3 ),
+				makeAlignatorDPFull( ALIGNMENT_LOCAL, -10, -1 ), 3, 40, 20, 10, 16 );
+		searchDatabase( hsp, query, targets, 25, 1 );
+		HSPCounts serial = getHSPCounts( hsp );
+		BOOST_CHECK( serial.mNumSeeds > 0 );
+		BOOST_CHECK( serial.mNumExtensions > 0 );
+		searchDatabase( hsp, query, targets, 25, 3 );
+		HSPCounts threaded = getHSPCounts( hsp );
+		BOOST_CHECK_EQUAL( threaded.mNumSeeds, 2 * serial.mNumSeeds );
+		BOOST_CHECK_EQUAL( threaded.mNumTwoHits, 2 * serial.mNumTwoHits );
+		BOOST_CHECK_EQUAL( threaded.mNumHSPs, 2 * serial.mNumHSPs );
+		BOOST_CHECK_EQUAL( threaded.mNumExtensions, 2 * serial.mNumExtensions );
+	}
+
+	// exceptions in threads are passed to the caller
+	for (unsigned int num_threads = 1; num_threads <= 2; ++num_threads)
+	{
+		HAlignator failing = makeAlignatorDPFull( ALIGNMENT_LOCAL, -10, -1 );
+		failing->cloneToolkit();
+		failing->getToolkit()->setScorer( HScorer( new FailingScorer( false ) ) );
+		BOOST_CHECK_THROW( searchDatabase( failing, query, targets, 25, num_threads ), AlignlibException );
+		failing->getToolkit()->setScorer( HScorer( new FailingScorer( true ) ) );
+		BOOST_CHECK_THROW( searchDatabase( failing, query, targets, 25, num_threads ), std::bad_alloc );
+	}
+}
+
+BOOST_AUTO_TEST_CASE( striped_alignment)
+{
+	HSubstitutionMatrix matrix = makeSubstitutionMatrix(
+			getDefaultEncoder()->getAlphabetSize(),
+			10, -1);
+
+	setDefaultSubstitutionMatrix( matrix );
+
+	HAlignandum seq1 = makeSequence( "AAAAACCCCCAAAAA" );
+	HAlignandum seq2 = makeSequence( "CCCCC" );
+	HAlignandum seq3 = makeSequence( "CCCKCCC" );
+	HAlignandum seq4 = makeSequence( "AAAAACCACCAAAAA" );
+	HAlignandum seq8 = makeProfile( "AAAAAAACCCCAAAAAAA", 1);
+
+	Score gop = -12;
+	Score gep = -2;
+
+	{
+		HAlignator a = makeAlignatorSWStriped( gop, gep );
+		testPairwiseAlignment(41, a, seq1, seq1, 0, 15, "+15",    0, 15,     "+15", 150 );
+		testPairwiseAlignment(42, a, seq1, seq2, 5, 10, "+5",     0,  5,      "+5", 50 );
+		testPairwiseAlignment(43, a, seq2, seq1, 0,  5, "+5",     5, 10,      "+5", 50 );
+		testPairwiseAlignment(44, a, seq2, seq3, 0,  5, "+5",     0,  5,      "+5", 39 );
+		testPairwiseAlignment(45, a, seq1, seq4, 0,  15, "+15",     0,  15,  "+15", 139 );
+
+		// profiles are aligned with full dynamic programming
+		HAlignator b = makeAlignatorDPFull( ALIGNMENT_LOCAL, gop, gep );
+		HAlignment ali1 = makeAlignmentVector();
+		HAlignment ali2 = makeAlignmentVector();
+		a->align( ali1, seq8, seq8 );
+		b->align( ali2, seq8, seq8 );
+		BOOST_CHECK_EQUAL( ali1->getScore(), ali2->getScore() );
+		BOOST_CHECK( checkAlignmentIdentity( ali1, ali2 ) );
+	}
+
+	// compare against full dynamic programming on random sequences
+	{
+		setDefaultSubstitutionMatrix( makeSubstitutionMatrixBlosum62() );
+		HAlignator striped = makeAlignatorSWStriped( -10, -1 );
+		HAlignator full = makeAlignatorDPFull( ALIGNMENT_LOCAL, -10, -1 );
+		HAlignment ali1 = makeAlignmentVector();
+		HAlignment ali2 = makeAlignmentVector();
+
+		const std::string alphabet( "ACDEFGHIKLMNPQRSTVWY" );
+		srand( 1 );
+		for (int x = 0; x < 200; ++x)
+		{
+			std::string s1, s2;
+			int l1 = 1 + rand() % 200;
+			int l2 = 1 + rand() % 200;
+			for (int y = 0; y < l1; ++y) s1 += alphabet[rand() % alphabet.size()];
+			for (int y = 0; y < l2; ++y) s2 += alphabet[rand() % alphabet.size()];
+			// make sure there is a common segment
+			if (x % 2 == 0) s2 = s2.substr( 0, l2 / 2 ) + s1.substr( l1 / 3, l1 / 2) + s2.substr( l2 / 2 );
+			HAlignandum row = makeSequence( s1 );
+			HAlignandum col = makeSequence( s2 );
+			striped->align( ali1, row, col );
+			full->align( ali2, row, col );
+			BOOST_CHECK_EQUAL( ali1->getScore(), ali2->getScore() );
+			BOOST_CHECK( checkAlignmentIdentity( ali1, ali2 ) );
+		}
+
+		// the alignment starts with a prefix of score zero
+		{
+			HAlignator striped = makeAlignatorSWStriped( -7, -2 );
+			HAlignator full = makeAlignatorDPFull( ALIGNMENT_LOCAL, -7, -2 );
+			HAlignandum row = makeSequence( "CCAGGCTAGGACACTTTAAGTTGCGCGGGGCTACCGTCGCTGTAAGTTTTCGTTACCGTTCCGCGTTCACTATGATA" );
+			HAlignandum col = makeSequence( "TGTGAGCTGGAAGTCTCGCCCTCGGCGACCAAAATAGTTGCGCGGGGCTACCGTCGCTGTAAGTTTTCGTTACCGATATAACTGACACGGATAGCGGGATTATGACGTCC" );
+			striped->align( ali1, row, col );
+			full->align( ali2, row, col );
+			BOOST_CHECK_EQUAL( ali1->getScore(), ali2->getScore() );
+			BOOST_CHECK( checkAlignmentIdentity( ali1, ali2 ) );
+		}
+
+		// low-complexity sequences with many alignments of the same score
+		{
+			setDefaultSubstitutionMatrix( makeSubstitutionMatrix(
+					getDefaultEncoder()->getAlphabetSize(), 2, -2 ) );
+			HAlignator striped = makeAlignatorSWStriped( -2, -2 );
+			HAlignator full = makeAlignatorDPFull( ALIGNMENT_LOCAL, -2, -2 );
+			for (int x = 0; x < 200; ++x)
+			{
+				std::string s1, s2;
+				int l1 = 1 + rand() % 100;
+				int l2 = 1 + rand() % 100;
+				for (int y = 0; y < l1; ++y) s1 += "AC"[rand() % 2];
+				for (int y = 0; y < l2; ++y) s2 += "AC"[rand() % 2];
+				HAlignandum row = makeSequence( s1 );
+				HAlignandum col = makeSequence( s2 );
+				striped->align( ali1, row, col );
+				full->align( ali2, row, col );
+				BOOST_CHECK_EQUAL( ali1->getScore(), ali2->getScore() );
+				BOOST_CHECK( checkAlignmentIdentity( ali1, ali2 ) );
+			}
+		}
+		setDefaultSubstitutionMatrix( matrix );
+	}
+
+	// scores exceeding the range of 16-bit integers
+	{
+		HAlignator a = makeAlignatorSWStriped( gop, gep );
+		HAlignment ali = makeAlignmentVector();
+		HAlignandum row = makeSequence( std::string( 4000, 'A' ) );
+		HAlignandum col = makeSequence( std::string( 10, 'K' ) + std::string( 3500, 'A' ) );
+		a->align( ali, row, col );
+		BOOST_CHECK_EQUAL( ali->getScore(), 35000 );
+		BOOST_CHECK_EQUAL( ali->getColFrom(), 10 );
+		BOOST_CHECK_EQUAL( ali->getColTo(), 3510 );
+		BOOST_CHECK_EQUAL( ali->getRowFrom(), 0 );
+		BOOST_CHECK_EQUAL( ali->getRowTo(), 3500 );
+	}
+}
+
 
 BOOST_AUTO_TEST_CASE( global_alignment)
 {
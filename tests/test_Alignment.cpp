@@ -538,8 +538,98 @@ BOOST_AUTO_TEST_CASE( test_AlignmentBlocksBug1 )
 
 }
 
+/** add pairs in chunks with addPairs and check against adding
+ * them one by one with addPair.
+ */
+void checkAddPairs( const HAlignment & a, const HAlignment & b )
+{
+	ResiduePair sorted1[4] = { ResiduePair(2,3,1), ResiduePair(3,4,1), ResiduePair(5,5,1), ResiduePair(6,8,1) };
+	ResiduePair sorted2[2] = { ResiduePair(8,9,1), ResiduePair(9,12,1) };
+	ResiduePair unsorted[3] = { ResiduePair(12,15,1), ResiduePair(10,13,1), ResiduePair(11,14,1) };
+
+	a->reserve( 9 );
+	a->addPairs( sorted1, 4, true );
+	BOOST_CHECK_EQUAL( a->getRowFrom(), 2 );
+	BOOST_CHECK_EQUAL( a->getColTo(), 9 );
+	BOOST_CHECK_EQUAL( a->getNumAligned(), 4 );
+	a->addPairs( sorted2, 2, true );
+	a->addPairs( unsorted, 3, false );
+	a->addPairs( unsorted, 0, false );
+
+	for (int x = 0; x < 4; ++x) b->addPair( sorted1[x] );
+	for (int x = 0; x < 2; ++x) b->addPair( sorted2[x] );
+	for (int x = 0; x < 3; ++x) b->addPair( unsorted[x] );
+
+	BOOST_CHECK_EQUAL( a->getRowFrom(), b->getRowFrom() );
+	BOOST_CHECK_EQUAL( a->getRowTo(), b->getRowTo() );
+	BOOST_CHECK_EQUAL( a->getColFrom(), b->getColFrom() );
+	BOOST_CHECK_EQUAL( a->getColTo(), b->getColTo() );
+	BOOST_CHECK_EQUAL( a->getLength(), b->getLength() );
+	BOOST_CHECK_EQUAL( a->getNumAligned(), b->getNumAligned() );
+	BOOST_CHECK_EQUAL( a->getNumAligned(), 9 );
+	for (Position x = 0; x < 14; ++x)
+		BOOST_CHECK_EQUAL( a->mapRowToCol( x ), b->mapRowToCol( x ) );
+
+	AlignmentIterator it1(a->begin()), it2(b->begin());
+	for (; it1 != a->end() && it2 != b->end(); ++it1, ++it2)
+		BOOST_CHECK_EQUAL( *it1, *it2 );
+	BOOST_CHECK( it1 == a->end() && it2 == b->end() );
+}
+
+/** remove regions in place from a dotplot and check against
+ * copying the dotplot without the region.
+ */
+BOOST_AUTO_TEST_CASE( test_MatrixRowRemoveRegion )
+{
+	HAlignment a(makeAlignmentMatrixRow());
+	for (Position row = 0; row < 40; ++row)
+		for (Position col = 0; col < 30; ++col)
+			if ((row * 7 + col * 3) % 5 == 0)
+				a->addPair( ResiduePair( row, col, row + col ) );
+
+	Position regions[4][4] = { {0, 3, 25, 30}, {10, 15, 5, 8}, {38, 50, 0, 1}, {16, 20, 9, 24} };
+
+	for (int x = 0; x < 4; ++x)
+	{
+		HAlignment b(makeAlignmentMatrixRow());
+		copyAlignmentWithoutRegion( b, a,
+				regions[x][0], regions[x][1], regions[x][2], regions[x][3] );
+
+		a->removeRowRegion( regions[x][0], regions[x][1] );
+		a->removeColRegion( regions[x][2], regions[x][3] );
+
+		BOOST_CHECK_EQUAL( a->getLength(), b->getLength() );
+		BOOST_CHECK_EQUAL( a->getRowFrom(), b->getRowFrom() );
+		BOOST_CHECK_EQUAL( a->getRowTo(), b->getRowTo() );
+		BOOST_CHECK_EQUAL( a->getColFrom(), b->getColFrom() );
+		BOOST_CHECK_EQUAL( a->getColTo(), b->getColTo() );
+		BOOST_CHECK_EQUAL( a->front(), b->front() );
+		BOOST_CHECK_EQUAL( a->back(), b->back() );
+		for (Position row = 0; row < 45; ++row)
+			BOOST_CHECK_EQUAL( a->mapRowToCol( row ), b->mapRowToCol( row ) );
+
+		HAlignment c(a->getClone());
+		AlignmentIterator it1(c->begin()), it2(b->begin());
+		for (; it1 != c->end() && it2 != b->end(); ++it1, ++it2)
+			BOOST_CHECK_EQUAL( *it1, *it2 );
+		BOOST_CHECK( it1 == c->end() && it2 == b->end() );
+	}
+
+	// adding pairs after removal
+	a->addPair( ResiduePair( 12, 6, 1 ) );
+	a->addPair( ResiduePair( 1, 2, 1 ) );
+	BOOST_CHECK_EQUAL( a->mapRowToCol( 12 ), 6 );
+	BOOST_CHECK_EQUAL( a->mapRowToCol( 1 ), 2 );
+	BOOST_CHECK_EQUAL( a->getRowFrom(), 1 );
+
+	a->removeRowRegion( 0, 50 );
+	BOOST_CHECK_EQUAL( a->isEmpty(), true );
+	BOOST_CHECK( a->begin() == a->end() );
+}
+
 #define create_test( name, factory ) \
-	BOOST_AUTO_TEST_CASE( name ) { HAlignment a(factory()); runTests(a); }
+	BOOST_AUTO_TEST_CASE( name ) { HAlignment a(factory()); runTests(a); \
+	HAlignment b(factory()), c(factory()); checkAddPairs( b, c ); }
 
 create_test( Vector, makeAlignmentVector );
 create_test( Set, makeAlignmentSet );
@@ -549,4 +639,5 @@ create_test( SetCol, makeAlignmentSetCol );
 create_test( MatrixRow, makeAlignmentMatrixRow );
 create_test( MatrixDiagonal, makeAlignmentMatrixDiagonal );
 create_test( MatrixUnsorted, makeAlignmentMatrixUnsorted );
+create_test( MatrixArrays, makeAlignmentMatrixArrays );
 create_test( Blocks, makeAlignmentBlocks );
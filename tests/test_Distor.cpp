@@ -31,6 +31,7 @@
 #include "HelpersDistanceMatrix.h"
 #include "Distor.h"
 #include "HelpersDistor.h"
+#include "EncodedMultipleAlignment.h"
 
 using namespace std;
 using namespace alignlib;
@@ -56,6 +57,50 @@ int main ()
   d2->calculateMatrix( matrix, mali );
   // cout << *matrix << endl;
 
+  // distances from the encoded multiple alignment are the same as between rows
+  HEncodedMultipleAlignment encoded( makeEncodedMultipleAlignment( mali, getDefaultToolkit()->getEncoder() ) );
+  HDistor distors[] = { d1, d2 };
+  for (int d = 0; d < 2; ++d)
+  {
+	  HDistanceMatrix m1(makeDistanceMatrixSymmetric(4, 0));
+	  HDistanceMatrix m2(makeDistanceMatrixSymmetric(4, 0));
+	  distors[d]->calculateMatrix( m1, mali );
+	  distors[d]->calculateMatrix( m2, encoded );
+
+	  for (int i = 0; i < 3; ++i)
+		  for (int j = i + 1; j < 4; ++j)
+		  {
+			  DistanceMatrixValue expected = distors[d]->calculateDistance( (*mali)[i], (*mali)[j] );
+			  if ((*m1)(i, j) != expected || (*m2)(i, j) != expected)
+			  {
+				  cerr << "distance mismatch for " << i << " " << j << ": "
+				  << (*m1)(i, j) << " " << (*m2)(i, j) << " " << expected << endl;
+				  return (EXIT_FAILURE);
+			  }
+		  }
+  }
+
+  // compare rows longer than a word of the gap bitmap with gaps at the ends
+  {
+	  HMultipleAlignment long_mali(makeMultipleAlignment());
+	  std::string a( 150, 'A' ), b( 150, 'A' );
+	  for (int x = 0; x < 150; ++x)
+	  {
+		  if (x < 10 || x > 140 || x % 7 == 0) a[x] = '-';
+		  if (x % 5 == 0) b[x] = 'C';
+		  if (x > 130 || x % 11 == 0) b[x] = '-';
+	  }
+	  long_mali->add(makeAlignatum(a));
+	  long_mali->add(makeAlignatum(b));
+	  HDistanceMatrix m(makeDistanceMatrixSymmetric(2, 0));
+	  d1->calculateMatrix( m, makeEncodedMultipleAlignment( long_mali, getDefaultToolkit()->getEncoder() ) );
+	  if ((*m)(0, 1) != d1->calculateDistance( a, b ))
+	  {
+		  cerr << "distance mismatch for long rows" << endl;
+		  return (EXIT_FAILURE);
+	  }
+  }
+
   return (EXIT_SUCCESS);
 
 }
@@ -54,6 +54,67 @@
 using namespace std;
 using namespace alignlib;
 
+/** compare the fragments of the iterative fragmentor against
+    re-aligning the dotplot without the previous fragments.
+*/
+bool checkIterative( Score gop, Score gep )
+{
+  HAlignment dots(makeAlignmentMatrixRow());
+
+  // diagonal runs and noise from a simple linear congruential generator
+  unsigned long seed = 1;
+  const Position n = 200;
+  for (int x = 0; x < 400; ++x)
+    {
+      seed = (seed * 1103515245 + 12345) % 2147483648UL;
+      Position row = seed % n;
+      seed = (seed * 1103515245 + 12345) % 2147483648UL;
+      Position col = seed % n;
+      Position length = (x % 4 == 0) ? 5 + seed % 10 : 1;
+      for (Position y = 0; y < length && row + y < n && col + y < n; ++y)
+        dots->addPair( ResiduePair( row + y, col + y, 1 + (x + y) % 3 ) );
+    }
+
+  std::string sequence( n, 'A' );
+  HAlignandum row(makeSequence( sequence.c_str() ));
+  HAlignandum col(makeSequence( sequence.c_str() ));
+
+  HFragmentor f(makeFragmentorIterative( dots, 5, gop, gep ));
+  HAlignment sample(makeAlignmentVector());
+  HFragmentVector fragments(f->fragment( sample, row, col ));
+
+  HAlignment remaining(dots);
+  for (unsigned int i = 0; ; ++i)
+    {
+      HAlignator dottor(makeAlignatorPrebuilt( remaining ));
+      HAlignator alignator(makeAlignatorDots( dottor, gop, gep ));
+      HAlignment result(makeAlignmentVector());
+      alignator->align( result, row, col );
+
+      if (result->getScore() < 5)
+        return i == fragments->size();
+
+      if (i >= fragments->size())
+        return false;
+
+      const HAlignment & fragment = (*fragments)[i];
+      if (fragment->getScore() != result->getScore() ||
+          fragment->getLength() != result->getLength())
+        return false;
+
+      AlignmentIterator it1(fragment->begin()), it2(result->begin());
+      for (; it1 != fragment->end(); ++it1, ++it2)
+        if ((*it1).mRow != (*it2).mRow || (*it1).mCol != (*it2).mCol)
+          return false;
+
+      HAlignment copy(makeAlignmentMatrixUnsorted());
+      copyAlignmentWithoutRegion( copy, remaining,
+                                  result->getRowFrom(), result->getRowTo(),
+                                  result->getColFrom(), result->getColTo() );
+      remaining = copy;
+    }
+}
+
 int main ()
 {
 
@@ -84,4 +145,11 @@ int main ()
   }
   */
 
+  if (!checkIterative( -3, -1 ) || !checkIterative( -1, -0.1 ))
+    {
+      cerr << "fragments differ from iterative re-alignment" << endl;
+      return 1;
+    }
+
+  return 0;
 }
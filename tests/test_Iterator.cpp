@@ -149,6 +149,19 @@ int main () {
 		Print( iterator );
 	}
 
+	{
+		// std::cout << "--------------------- testing Iterator2DXDrop ----------------------------------" << std::endl;
+		HIterator2D iterator = makeIterator2DXDrop( seq1, seq2, 10 );
+		assert( iterator->row_size() == seq1->getLength() );
+		assert( iterator->col_size() == seq2->getLength() );
+		assert( iterator->getNumCells() == (size_t)(seq1->getLength() * seq2->getLength()) );
+		Print( iterator );
+
+		HIterator2D iterator2 = iterator->getNew( seq1, seq2 );
+		assert( iterator2->col_size( 0 ) == seq2->getLength() );
+		assert( iterator->getNumCells() == iterator2->getNumCells() );
+	}
+
 	{
 		// std::cout << "--------------------- testing Iterator2DBanded with diagonals 2, 4 -----" << std::endl;
 		HIterator2D iterator = makeIterator2DBanded( seq1, seq2, 2, 4);
@@ -36,6 +36,7 @@
 #include "alignlib.h"
 #include "MultAlignment.h"
 #include "HelpersMultAlignment.h"
+#include "ImplProfile.h"
 
 #define BOOST_TEST_MODULE
 #include <boost/test/included/unit_test.hpp>
@@ -102,6 +103,134 @@ BOOST_AUTO_TEST_CASE( test_makeProfile2 )
 	*/
 }
 
+// write profiles to a library and read them back
+BOOST_AUTO_TEST_CASE( test_ProfileLibrary )
+{
+	AlignandumVector profiles;
+	profiles.push_back( makeProfile("AAAACCCCWWWWWAAAADDDDWWWWW", 2) );
+	profiles.push_back( makeProfile("ACDEFGHIKLACDEFGHIKKACDEFGHIKL", 3) );
+	profiles.push_back( makeProfile("", 1) );
+	profiles[1]->prepare();
+	profiles[0]->mask( 3, 5 );
+
+	const std::string filename( "test_ProfileLibrary.lib" );
+	writeProfileLibrary( filename, profiles );
+
+	// unprepared profiles are released again
+	BOOST_CHECK( !profiles[0]->isPrepared() );
+	BOOST_CHECK( profiles[1]->isPrepared() );
+
+	HProfileLibrary library( openProfileLibrary( filename ) );
+	BOOST_CHECK_EQUAL( library->getNumProfiles(), profiles.size() );
+
+	for (size_t x = 0; x < profiles.size(); ++x)
+	{
+		profiles[x]->prepare();
+		HAlignandum mapped( library->getProfile( x ) );
+		BOOST_CHECK_EQUAL( library->getProfileLength( x ), profiles[x]->getLength() );
+		BOOST_CHECK_EQUAL( mapped->getLength(), profiles[x]->getLength() );
+		BOOST_CHECK( mapped->isPrepared() );
+		BOOST_CHECK_EQUAL( mapped->asString(), profiles[x]->asString() );
+		for (Position c = 0; c < profiles[x]->getLength(); ++c)
+			BOOST_CHECK_EQUAL( mapped->isMasked( c ), profiles[x]->isMasked( c ) );
+
+		HProfile a( toProfile( profiles[x] ) ), b( toProfile( mapped ) );
+		BOOST_CHECK( *a->getWeightedCountMatrix() == *b->getWeightedCountMatrix() );
+		BOOST_CHECK( *a->getFrequencyMatrix() == *b->getFrequencyMatrix() );
+		BOOST_CHECK( *a->getScoreMatrix() == *b->getScoreMatrix() );
+
+		HProfile c( toProfile( mapped->getClone() ) );
+		BOOST_CHECK( *a->getScoreMatrix() == *c->getScoreMatrix() );
+	}
+
+	// profiles stay valid after the library is closed and are read-only
+	HAlignandum mapped( library->getProfile( 0 ) );
+	library.reset();
+	BOOST_CHECK_EQUAL( mapped->asString(), profiles[0]->asString() );
+	BOOST_CHECK_THROW( mapped->mask( 1 ), AlignlibException );
+	BOOST_CHECK_THROW( toProfile( mapped )->resize( 10 ), AlignlibException );
+
+	// the mapped matrices can be written to
+	ScoreMatrix * scores = boost::dynamic_pointer_cast<ImplProfile, Alignandum>( mapped )->exportScoreMatrix();
+	scores->setValue( 0, 0, 42 );
+	BOOST_CHECK_EQUAL( toProfile( mapped )->getScoreMatrix()->getValue( 0, 0 ), 42 );
+
+	{
+		HProfileLibrary library( openProfileLibrary( filename ) );
+		BOOST_CHECK_THROW( library->getProfile( 3 ), AlignlibException );
+	}
+
+	// not a library
+	{
+		std::ofstream output( filename.c_str() );
+		output << "no profiles here" << std::endl;
+	}
+	BOOST_CHECK_THROW( openProfileLibrary( filename ), AlignlibException );
+	BOOST_CHECK_THROW( openProfileLibrary( "no_such_file.lib" ), AlignlibException );
+
+	remove( filename.c_str() );
+}
+
+// profiles from a multiple alignment and from the encoded multiple alignment are the same
+BOOST_AUTO_TEST_CASE( test_makeProfileEncoded )
+{
+	HMultipleAlignment mali( makeMultipleAlignment() );
+	mali->add( makeAlignatum( "-AADDAACCAAA-" ) );
+	mali->add( makeAlignatum( "AAKKAA-CCAAAA" ) );
+	mali->add( makeAlignatum( "-A-AAA-CCA-A-" ) );
+
+	HProfile a( toProfile( makeProfile( mali ) ) );
+	HProfile b( toProfile( makeProfile(
+			makeEncodedMultipleAlignment( mali, getDefaultToolkit()->getEncoder() ) ) ) );
+
+	BOOST_CHECK_EQUAL( a->getLength(), b->getLength() );
+	BOOST_CHECK( *a->getWeightedCountMatrix() == *b->getWeightedCountMatrix() );
+}
+
+BOOST_AUTO_TEST_CASE( test_prepareProfiles )
+{
+	const char * sequences[] = { "AAAACCCCWWWWWAAAADDDDWWWWW", "ACDEFGHIKLACDEFGHIKKACDEFGHIKL",
+			"AAAACCCCAAAADDDD", "ACDEFGHIKLMNPQRSTVWYACDEFG", "" };
+
+	HRegularizor regularizors[] = { makeRegularizorDirichlet(), makeRegularizorPsiblast(),
+			makeRegularizorDirichletHash() };
+	HRegularizor old_regularizor( getDefaultToolkit()->getRegularizor() );
+
+	for (unsigned int r = 0; r < 3; ++r)
+	{
+		getDefaultToolkit()->setRegularizor( regularizors[r] );
+
+		for (unsigned int num_threads = 1; num_threads <= 8; num_threads *= 2)
+		{
+			AlignandumVector serial, batch, columns;
+			for (unsigned int x = 0; x < 5; ++x)
+			{
+				serial.push_back( makeProfile( sequences[x], 2 ) );
+				batch.push_back( serial.back()->getClone() );
+				columns.push_back( serial.back()->getClone() );
+				serial.back()->prepare();
+			}
+
+			prepareProfiles( batch, num_threads );
+			for (unsigned int x = 0; x < 5; ++x)
+				prepareProfile( columns[x], num_threads );
+
+			for (unsigned int x = 0; x < 5; ++x)
+			{
+				HProfile a( toProfile( serial[x] ) ), b( toProfile( batch[x] ) ), c( toProfile( columns[x] ) );
+				BOOST_CHECK( b->isPrepared() );
+				BOOST_CHECK( c->isPrepared() );
+				BOOST_CHECK( *a->getFrequencyMatrix() == *b->getFrequencyMatrix() );
+				BOOST_CHECK( *a->getScoreMatrix() == *b->getScoreMatrix() );
+				BOOST_CHECK( *a->getFrequencyMatrix() == *c->getFrequencyMatrix() );
+				BOOST_CHECK( *a->getScoreMatrix() == *c->getScoreMatrix() );
+			}
+		}
+	}
+
+	getDefaultToolkit()->setRegularizor( old_regularizor );
+}
+
 /*
 // test creation of profile from two alignandum objects
 BOOST_AUTO_TEST_CASE( test_makeProfile1b )
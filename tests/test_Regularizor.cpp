@@ -31,6 +31,8 @@
 #include <fstream>
 #include <cassert>
 #include <time.h>
+#include <cstdlib>
+#include <cmath>
 
 #include "alignlib.h"
 #include "alignlib_fwd.h"
@@ -41,6 +43,11 @@
 #include "HelpersAlignandum.h"
 #include "HelpersSubstitutionMatrix.h"
 
+#ifdef HAVE_BOOST_THREAD
+#include <boost/thread/thread.hpp>
+#include <boost/bind.hpp>
+#endif
+
 #define BOOST_TEST_MODULE
 #include <boost/test/included/unit_test.hpp>
 using boost::unit_test::test_suite;
@@ -95,10 +102,87 @@ BOOST_AUTO_TEST_CASE( test_RegularizorDirichlet )
   test_GenericRegularizorWithGaps( r );
 }
 
+// fill counts with columns of various depths, including empty columns
+void fillRandomCounts( WeightedCountMatrix & counts )
+{
+	srand( 1 );
+	for (unsigned int r = 0; r < counts.getNumRows(); ++r)
+	{
+		int depth = (r % 10 == 0) ? 0 : rand() % (1 + 3 * (r % 7) * (r % 7));
+		for (unsigned int c = 0; c < counts.getNumCols(); ++c)
+			counts.setValue( r, c, 0 );
+		for (int x = 0; x < depth; ++x)
+			counts.getRow( r )[rand() % counts.getNumCols()] += 0.25 + (rand() % 100) / 100.0;
+	}
+}
+
+void checkSameFrequencies( const FrequencyMatrix & a, const FrequencyMatrix & b )
+{
+	BOOST_CHECK_EQUAL( a.getNumRows(), b.getNumRows() );
+	BOOST_CHECK_EQUAL( a.getNumCols(), b.getNumCols() );
+	for (unsigned int r = 0; r < a.getNumRows(); ++r)
+		for (unsigned int c = 0; c < a.getNumCols(); ++c)
+			BOOST_CHECK_SMALL( a.getValue( r, c ) - b.getValue( r, c ), 1e-10 );
+}
 
+BOOST_AUTO_TEST_CASE( test_RegularizorDirichletVectorized )
+{
+	HEncoder encoder( getEncoder( Protein20 ) );
+	const int width = encoder->getAlphabetSize();
 
+	WeightedCountMatrix counts( 1003, width, 0 );
+	fillRandomCounts( counts );
 
+	WeightedCount cutoffs[] = { 0, 20 };
+	for (int x = 0; x < 2; ++x)
+	{
+		FrequencyMatrix expected( counts.getNumRows(), width, 0 );
+		makeRegularizorDirichlet( cutoffs[x] )->fillFrequencies( expected, counts, encoder );
 
+		FrequencyMatrix result( counts.getNumRows(), width, 0 );
+		makeRegularizorDirichletVectorized( cutoffs[x] )->fillFrequencies( result, counts, encoder );
 
+		checkSameFrequencies( expected, result );
+	}
+}
 
+#ifdef HAVE_BOOST_THREAD
+void fillFrequenciesThread( const HRegularizor & r,
+		FrequencyMatrix * frequencies,
+		const WeightedCountMatrix * counts,
+		const HEncoder & encoder )
+{
+	for (int x = 0; x < 20; ++x)
+		r->fillFrequencies( *frequencies, *counts, encoder );
+}
 
+// all threads share a single regularizor
+BOOST_AUTO_TEST_CASE( test_RegularizorDirichletVectorizedThreads )
+{
+	HEncoder encoder( getEncoder( Protein20 ) );
+	const int width = encoder->getAlphabetSize();
+
+	WeightedCountMatrix counts( 500, width, 0 );
+	fillRandomCounts( counts );
+
+	HRegularizor r( makeRegularizorDirichletVectorized() );
+	FrequencyMatrix expected( counts.getNumRows(), width, 0 );
+	r->fillFrequencies( expected, counts, encoder );
+
+	const int nthreads = 4;
+	std::vector< FrequencyMatrix * > results;
+	boost::thread_group threads;
+	for (int x = 0; x < nthreads; ++x)
+	{
+		results.push_back( new FrequencyMatrix( counts.getNumRows(), width, 0 ) );
+		threads.create_thread( boost::bind( fillFrequenciesThread, r, results.back(), &counts, encoder ) );
+	}
+	threads.join_all();
+
+	for (int x = 0; x < nthreads; ++x)
+	{
+		BOOST_CHECK( *results[x] == expected );
+		delete results[x];
+	}
+}
+#endif
@@ -0,0 +1,249 @@
+/*
+  alignlib - a library for aligning protein sequences
+
+  $Id$
+
+  Copyright (C) 2026 Andreas Heger
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+ */
+
+/** Test SequenceIndex objects
+ */
+
+#if HAVE_CONFIG_H
+#include <config.h>
+#endif
+
+#include <iostream>
+#include <sstream>
+#include <vector>
+#include <string>
+#include <cstdlib>
+
+#include "alignlib.h"
+
+#define BOOST_TEST_MODULE
+#include <boost/test/included/unit_test.hpp>
+using boost::unit_test::test_suite;
+
+using namespace std;
+using namespace alignlib;
+
+/** build a database with copies of parts of the query */
+void buildDatabase( std::string & query, std::vector<std::string> & database )
+{
+	const char * alphabet = "ACDEFGHIKLMNPQRSTVWY";
+	srand( 1 );
+
+	query.clear();
+	for (int x = 0; x < 200; ++x)
+		query += alphabet[rand() % 20];
+
+	database.clear();
+	for (int x = 0; x < 50; ++x)
+	{
+		std::string s;
+		int length = 50 + rand() % 200;
+		for (int i = 0; i < length; ++i)
+			s += alphabet[rand() % 20];
+		if (x % 10 == 3)
+			s.replace( 20, 40, query.substr( 50 + x, 40 ) );
+		database.push_back( s );
+	}
+}
+
+/** number of identical seeds between query and target */
+unsigned int countSeeds( const std::string & query, const std::string & target, const std::string & seed )
+{
+	unsigned int n = 0;
+	for (int q = 0; q + (int)seed.size() <= (int)query.size(); ++q)
+		for (int t = 0; t + (int)seed.size() <= (int)target.size(); ++t)
+		{
+			bool match = true;
+			for (size_t o = 0; o < seed.size() && match; ++o)
+				if (seed[o] == '1' && query[q + o] != target[t + o])
+					match = false;
+			if (match)
+				++n;
+		}
+	return n;
+}
+
+void checkSearch( const HSequenceIndex & index,
+		const std::string & query,
+		const std::vector<std::string> & database,
+		unsigned int min_seeds )
+{
+	HAlignandum q = makeSequence( query );
+	SeedCandidates candidates = index->search( q, min_seeds );
+
+	std::vector<unsigned int> expected( database.size(), 0 );
+	for (size_t x = 0; x < database.size(); ++x)
+		expected[x] = countSeeds( query, database[x], index->getSeed() );
+
+	size_t num_expected = 0;
+	for (size_t x = 0; x < database.size(); ++x)
+		if (expected[x] >= min_seeds && expected[x] > 0)
+			++num_expected;
+	BOOST_CHECK_EQUAL( candidates.size(), num_expected );
+
+	for (size_t x = 0; x < candidates.size(); ++x)
+	{
+		const SeedCandidate & c = candidates[x];
+		BOOST_CHECK_EQUAL( c.mNumSeeds, expected[c.mIndex] );
+		if (x > 0)
+			BOOST_CHECK( candidates[x-1].mNumSeeds > c.mNumSeeds ||
+					(candidates[x-1].mNumSeeds == c.mNumSeeds && candidates[x-1].mIndex < c.mIndex ) );
+
+		BOOST_CHECK( c.mDiagonalFrom <= c.mBestDiagonal );
+		BOOST_CHECK( c.mBestDiagonal <= c.mDiagonalTo );
+
+		// residues in seeds are identical
+		const std::string & target = database[c.mIndex];
+		for (AlignmentIterator it = c.mSeeds->begin(); it != c.mSeeds->end(); ++it)
+		{
+			BOOST_CHECK_EQUAL( query[it->mRow], target[it->mCol] );
+			BOOST_CHECK( it->mCol - it->mRow >= c.mDiagonalFrom );
+			BOOST_CHECK( it->mCol - it->mRow <= c.mDiagonalTo );
+		}
+	}
+}
+
+BOOST_AUTO_TEST_CASE( seed_search )
+{
+	std::string query;
+	std::vector<std::string> database;
+	buildDatabase( query, database );
+
+	AlignandumVector sequences;
+	for (size_t x = 0; x < database.size(); ++x)
+		sequences.push_back( makeSequence( database[x] ) );
+
+	// direct lookup and binary search
+	checkSearch( makeSequenceIndex( sequences, 3 ), query, database, 1 );
+	checkSearch( makeSequenceIndex( sequences, 3 ), query, database, 5 );
+	checkSearch( makeSequenceIndex( sequences, 5 ), query, database, 1 );
+	checkSearch( makeSequenceIndex( sequences, std::string( "1101" ) ), query, database, 1 );
+	checkSearch( makeSequenceIndex( sequences, std::string( "110010011" ) ), query, database, 2 );
+
+	BOOST_CHECK_THROW( makeSequenceIndex( sequences, std::string( "0110" ) ), AlignlibException );
+	BOOST_CHECK_THROW( makeSequenceIndex( sequences, std::string( "1x1" ) ), AlignlibException );
+	BOOST_CHECK_THROW( makeSequenceIndex( sequences, 0 ), AlignlibException );
+
+	// maximum number of candidates
+	HSequenceIndex index = makeSequenceIndex( sequences, 4 );
+	SeedCandidates all = index->search( makeSequence( query ) );
+	SeedCandidates some = index->search( makeSequence( query ), 1, 3 );
+	BOOST_CHECK_EQUAL( some.size(), (size_t)3 );
+	for (size_t x = 0; x < some.size(); ++x)
+		BOOST_CHECK_EQUAL( some[x].mIndex, all[x].mIndex );
+}
+
+BOOST_AUTO_TEST_CASE( masked_residues )
+{
+	AlignandumVector sequences;
+	sequences.push_back( makeSequence( "AAAACCCCKAAAAAAAKKKLLMLMM" ) );
+	HSequenceIndex index = makeSequenceIndex( sequences, 3 );
+
+	HAlignandum query = makeSequence( "KKKLLM" );
+	BOOST_CHECK_EQUAL( index->search( query ).size(), (size_t)1 );
+
+	query->mask( 0, 6 );
+	BOOST_CHECK_EQUAL( index->search( query ).size(), (size_t)0 );
+}
+
+BOOST_AUTO_TEST_CASE( save_and_load )
+{
+	std::string query;
+	std::vector<std::string> database;
+	buildDatabase( query, database );
+
+	AlignandumVector sequences;
+	for (size_t x = 0; x < database.size(); ++x)
+		sequences.push_back( makeSequence( database[x] ) );
+
+	const char * seeds[] = { "111", "11111", "11011" };
+	for (int s = 0; s < 3; ++s)
+	{
+		HSequenceIndex index = makeSequenceIndex( sequences, std::string( seeds[s] ) );
+
+		std::stringstream stream;
+		index->save( stream );
+		HSequenceIndex loaded = loadSequenceIndex( stream );
+
+		BOOST_CHECK_EQUAL( loaded->getNumSequences(), index->getNumSequences() );
+		BOOST_CHECK_EQUAL( loaded->getSeed(), index->getSeed() );
+
+		SeedCandidates c1 = index->search( makeSequence( query ) );
+		SeedCandidates c2 = loaded->search( makeSequence( query ) );
+		BOOST_CHECK_EQUAL( c1.size(), c2.size() );
+		for (size_t x = 0; x < std::min( c1.size(), c2.size() ); ++x)
+		{
+			BOOST_CHECK_EQUAL( c1[x].mIndex, c2[x].mIndex );
+			BOOST_CHECK_EQUAL( c1[x].mNumSeeds, c2[x].mNumSeeds );
+			BOOST_CHECK( checkAlignmentIdentity( c1[x].mSeeds, c2[x].mSeeds ) );
+		}
+	}
+
+	std::stringstream stream( "garbage" );
+	BOOST_CHECK_THROW( loadSequenceIndex( stream ), AlignlibException );
+}
+
+BOOST_AUTO_TEST_CASE( seed_and_extend )
+{
+	std::string query;
+	std::vector<std::string> database;
+	buildDatabase( query, database );
+
+	AlignandumVector sequences;
+	for (size_t x = 0; x < database.size(); ++x)
+		sequences.push_back( makeSequence( database[x] ) );
+
+	HSequenceIndex index = makeSequenceIndex( sequences, 4 );
+	HAlignandum q = makeSequence( query );
+	SeedCandidates candidates = index->search( q, 4 );
+
+	// the targets sharing a segment with the query are found
+	BOOST_CHECK_EQUAL( candidates.size(), (size_t)5 );
+	for (size_t x = 0; x < candidates.size(); ++x)
+	{
+		size_t target = candidates[x].mIndex;
+		BOOST_CHECK_EQUAL( target % 10, (size_t)3 );
+		BOOST_CHECK_EQUAL( candidates[x].mBestDiagonal, (Diagonal)20 - (50 + (Diagonal)target) );
+
+		// extend the seeds by dot alignment
+		HAlignator dots = makeAlignatorDots( makeAlignatorPrebuilt( candidates[x].mSeeds ), -10, -1 );
+		HAlignment ali = makeAlignmentVector();
+		dots->align( ali, q, sequences[target] );
+		BOOST_CHECK_EQUAL( ali->getRowFrom(), 50 + (Position)target );
+		BOOST_CHECK_EQUAL( ali->getColFrom(), 20 );
+
+		// banded alignment along the diagonals
+		HAlignator banded = makeAlignatorDPFull( ALIGNMENT_LOCAL, -10, -1 );
+		banded->cloneToolkit();
+		banded->getToolkit()->setIterator2D(
+				makeIterator2DBanded( candidates[x].mDiagonalFrom, candidates[x].mDiagonalTo ) );
+		HAlignment ali2 = makeAlignmentVector();
+		banded->align( ali2, q, sequences[target] );
+		BOOST_CHECK( ali2->getRowFrom() <= 50 + (Position)target );
+		BOOST_CHECK( ali2->getRowTo() >= 90 + (Position)target );
+
+		// full dynamic programming can only do better by leaving the band
+		HAlignment ali3 = makeAlignmentVector();
+		makeAlignatorDPFull( ALIGNMENT_LOCAL, -10, -1 )->align( ali3, q, sequences[target] );
+		BOOST_CHECK( ali2->getScore() <= ali3->getScore() );
+	}
+}
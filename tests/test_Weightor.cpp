@@ -43,6 +43,10 @@
 #include "AlignlibDebug.h"
 #include "Weightor.h"
 #include "HelpersEncoder.h"
+#include "HelpersWeightor.h"
+#include "Encoder.h"
+#include "Matrix.h"
+#include "EncodedMultipleAlignment.h"
 
 #define BOOST_TEST_MODULE
 #include <boost/test/included/unit_test.hpp>
@@ -73,6 +77,141 @@ BOOST_AUTO_TEST_CASE( test_WeightorHenikoff )
 	test_GenericWeightor( l );
 }
 
+// build a multiple alignment with gaps
+HMultipleAlignment makeTestMultipleAlignment( int nsequences, Position length )
+{
+	HMultipleAlignment mali( makeMultipleAlignment() );
+	unsigned int seed = 1;
+	for (int s = 0; s < nsequences; ++s)
+	{
+		std::string row( length, '-' );
+		for (Position c = 0; c < length; ++c)
+		{
+			seed = seed * 1103515245 + 12345;
+			unsigned int x = (seed >> 16) % 25;
+			if (x < 20) row[c] = ref_protein20[ (x + c) % (5 + c % 16) ];
+		}
+		mali->add( makeAlignatum( row ) );
+	}
+	return mali;
+}
+
+// compare counts against a residue by residue count with the given weights
+void checkCounts(
+		const WeightedCountMatrix & counts,
+		const HMultipleAlignment & mali,
+		const SequenceWeights & weights,
+		const HEncoder & encoder )
+{
+	Residue width = encoder->getAlphabetSize();
+	WeightedCountMatrix expected( mali->getLength(), width, 0 );
+	for (int s = 0; s < mali->getNumSequences(); ++s)
+		for (Position c = 0; c < mali->getLength(); ++c)
+		{
+			Residue code = encoder->encode( (*mali)[s][c] );
+			if (code < width)
+				expected[c][code] += weights[s];
+		}
+
+	for (Position c = 0; c < mali->getLength(); ++c)
+		for (Residue r = 0; r < width; ++r)
+			BOOST_CHECK_CLOSE( counts[c][r] + 1, expected[c][r] + 1, 1e-10 );
+}
+
+BOOST_AUTO_TEST_CASE( test_WeightorCounts )
+{
+	HEncoder encoder( getDefaultToolkit()->getEncoder() );
+	Residue width = encoder->getAlphabetSize();
+	HMultipleAlignment mali( makeTestMultipleAlignment( 37, 50 ) );
+	const int nsequences = mali->getNumSequences();
+	const Position length = mali->getLength();
+
+	WeightedCountMatrix counts1( length, width, 0 );
+	makeWeightor()->fillCounts( counts1, mali, encoder );
+	checkCounts( counts1, mali, SequenceWeights( nsequences, 1 ), encoder );
+
+	// Henikoff weights computed residue by residue
+	SequenceWeights weights( nsequences, 0 );
+	for (Position c = 0; c < length; ++c)
+	{
+		std::vector<int> n( width, 0 );
+		int ntypes = 0;
+		for (int s = 0; s < nsequences; ++s)
+		{
+			Residue code = encoder->encode( (*mali)[s][c] );
+			if (code < width && n[code]++ == 0) ++ntypes;
+		}
+		for (int s = 0; s < nsequences; ++s)
+		{
+			Residue code = encoder->encode( (*mali)[s][c] );
+			if (code < width)
+				weights[s] += 1.0 / (n[code] * ntypes);
+		}
+	}
+	double total = 0;
+	for (int s = 0; s < nsequences; ++s) total += weights[s];
+	for (int s = 0; s < nsequences; ++s) weights[s] /= total;
+
+	WeightedCountMatrix counts2( length, width, 0 );
+	makeWeightorHenikoff()->fillCounts( counts2, mali, encoder );
+	checkCounts( counts2, mali, weights, encoder );
+
+	// results do not depend on the number of threads
+	for (unsigned int num_threads = 2; num_threads <= 8; num_threads *= 2)
+	{
+		WeightedCountMatrix counts( length, width, 0 );
+		makeWeightor( num_threads )->fillCounts( counts, mali, encoder );
+		BOOST_CHECK( counts == counts1 );
+
+		WeightedCountMatrix counts_henikoff( length, width, 0 );
+		makeWeightorHenikoff( false, num_threads )->fillCounts( counts_henikoff, mali, encoder );
+		BOOST_CHECK( counts_henikoff == counts2 );
+	}
+
+	// counts from an encoded multiple alignment
+	HEncodedMultipleAlignment encoded( makeEncodedMultipleAlignment( mali, encoder, 3 ) );
+	WeightedCountMatrix counts3( length, width, 0 );
+	makeWeightorHenikoff()->fillCounts( counts3, encoded );
+	BOOST_CHECK( counts3 == counts2 );
+}
+
+BOOST_AUTO_TEST_CASE( test_EncodedMultipleAlignment )
+{
+	HEncoder encoder( getDefaultToolkit()->getEncoder() );
+	HMultipleAlignment mali( makeTestMultipleAlignment( 37, 150 ) );
+	HEncodedMultipleAlignment encoded( makeEncodedMultipleAlignment( mali, encoder ) );
+
+	BOOST_CHECK_EQUAL( encoded->getLength(), mali->getLength() );
+	BOOST_CHECK_EQUAL( encoded->getNumSequences(), mali->getNumSequences() );
+	BOOST_CHECK_EQUAL( encoded->getWidth(), encoder->getAlphabetSize() );
+
+	for (int s = 0; s < mali->getNumSequences(); ++s)
+	{
+		const std::string & row = (*mali)[s];
+		Position from = NO_POS, to = 0;
+		for (Position c = 0; c < mali->getLength(); ++c)
+		{
+			Residue code = encoder->encode( row[c] );
+			bool is_gap = code >= encoder->getAlphabetSize();
+			if (is_gap) code = encoder->getAlphabetSize();
+			BOOST_CHECK_EQUAL( encoded->getRow( s )[c], code );
+			BOOST_CHECK_EQUAL( encoded->getColumn( c )[s], code );
+			BOOST_CHECK_EQUAL( encoded->isGap( s, c ), is_gap );
+			if (!is_gap)
+			{
+				if (from == NO_POS) from = c;
+				to = c + 1;
+			}
+		}
+		BOOST_CHECK_EQUAL( encoded->getFrom( s ), from == NO_POS ? 0 : from );
+		BOOST_CHECK_EQUAL( encoded->getTo( s ), to );
+	}
+
+	// the same encoding with several threads
+	HEncodedMultipleAlignment encoded2( makeEncodedMultipleAlignment( mali, encoder, 4 ) );
+	BOOST_CHECK( encoded->getColumns() == encoded2->getColumns() );
+}
+
 
 
 